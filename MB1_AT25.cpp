@@ -0,0 +1,573 @@
+/**
+ * @file MB1_AT25.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for AT25-series SPI flash (AT25DF/AT25SF) on MBoard-1.
+ */
+
+/* Includes */
+#include "MB1_AT25.h"
+using namespace AT25_ns;
+
+/**< AT25s which have begun, for at25_miscTIMISR */
+static AT25 *_at25Objs [objs_max] = {NULL};
+
+/**<----------------------------- class AT25 ------------------------------------*/
+
+/**
+ * @brief AT25.
+ * @param SPI *spi_p : SPI of the flash.
+ * @param SPI_ns::SM_device_t device : at25Flash_1 or at25Flash_2.
+ */
+AT25::AT25 (SPI *spi_p, SPI_ns::SM_device_t device){
+    this->spi_p = spi_p;
+    this->device = device;
+    jedecID = 0;
+
+    op = op_none;
+    opStatus = successful;
+    done_p = NULL;
+    doneArg = NULL;
+    addr = 0;
+    rxBuf = NULL;
+    txBuf = NULL;
+    remaining = 0;
+    chunk = 0;
+
+    waitReady = false;
+    pollInFlight = false;
+
+    cmdNext = 0;
+    wrenCmd = cmd_writeEnable;
+    statusCmd[0] = cmd_readStatus;
+    statusCmd[1] = 0;
+
+    transStatus.status = SPI_ns::successful;
+}
+
+/**
+ * @brief begin, register for polling, read JEDEC ID, remove write protection of all sectors.
+ * @return AT25_ns::status_t : failed if no flash answers.
+ * @attention : blocking, SPI queue must be free to use.
+ */
+status_t AT25::begin (void){
+    uint8_t tx [4] = {cmd_readID, 0, 0, 0};
+    uint8_t rx [4];
+    uint8_t unprotect [2] = {cmd_writeStatus, 0x00};
+    uint8_t count;
+
+    for (count = 0; count < objs_max; count++){
+        if (_at25Objs[count] == this)
+            break;
+        if (_at25Objs[count] == NULL){
+            _at25Objs[count] = this;
+            break;
+        }
+    }
+    if (count == objs_max)
+        return failed;
+
+    if (command (tx, rx, 4) != successful)
+        return failed;
+    jedecID = ((uint32_t) rx[1] << 16) | ((uint32_t) rx[2] << 8) | rx[3];
+    if ((jedecID == 0) || (jedecID == 0xFFFFFF))
+        return failed;
+
+    /**< global unprotect : write 0 to status register */
+    if ((command (&wrenCmd, NULL, 1) != successful) || (command (unprotect, NULL, 2) != successful))
+        return failed;
+
+    do {
+        if (command (statusCmd, rx, 2) != successful)
+            return failed;
+    } while ((rx[1] & status_busy) != 0);
+
+    return successful;
+}
+
+/**
+ * @brief id_get
+ * @return uint32_t : JEDEC ID (manufacturer, device id 1, device id 2) read by begin.
+ */
+uint32_t AT25::id_get (void){
+    return jedecID;
+}
+
+/**
+ * @brief read_start, fast read of len bytes, across pages, without waiting.
+ * @param uint32_t addr
+ * @param uint8_t *buf
+ * @param uint32_t len
+ * @param AT25_ns::done_t done_p : ISR context, can be NULL.
+ * @param void *doneArg
+ * @return AT25_ns::status_t : busy if an operation is running or SPI queue is full.
+ */
+status_t AT25::read_start (uint32_t addr, uint8_t *buf, uint32_t len, done_t done_p, void *doneArg){
+    uint32_t primask;
+    status_t retval;
+
+    if ((buf == NULL) || (len == 0))
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    retval = op_begin (op_read, addr, len, done_p, doneArg);
+    if (retval == successful){
+        rxBuf = buf;
+        read_next ();
+    }
+
+    __set_PRIMASK(primask);
+
+    return retval;
+}
+
+/**
+ * @brief program_start, program len bytes (erased before), page by page, without waiting.
+ * @param uint32_t addr
+ * @param const uint8_t *buf : must stay valid until done.
+ * @param uint32_t len
+ * @param AT25_ns::done_t done_p : ISR context, can be NULL.
+ * @param void *doneArg
+ * @return AT25_ns::status_t : busy if an operation is running or SPI queue is full.
+ */
+status_t AT25::program_start (uint32_t addr, const uint8_t *buf, uint32_t len, done_t done_p, void *doneArg){
+    uint32_t primask;
+    status_t retval;
+
+    if ((buf == NULL) || (len == 0))
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    retval = op_begin (op_program, addr, len, done_p, doneArg);
+    if (retval == successful){
+        txBuf = buf;
+        cmdNext = 0;
+        cmd_prepare (cmdBufs[cmdNext], cmd_pageProgram, addr);
+        program_next ();
+    }
+
+    __set_PRIMASK(primask);
+
+    return retval;
+}
+
+/**
+ * @brief erase_start, erase a range, with the largest blocks which fit, without waiting.
+ * @param uint32_t addr : 4KB aligned.
+ * @param uint32_t len : multiple of 4KB.
+ * @param AT25_ns::done_t done_p : ISR context, can be NULL.
+ * @param void *doneArg
+ * @return AT25_ns::status_t : busy if an operation is running or SPI queue is full.
+ */
+status_t AT25::erase_start (uint32_t addr, uint32_t len, done_t done_p, void *doneArg){
+    uint32_t primask;
+    status_t retval;
+
+    if ((len == 0) || ((addr % block4K_size) != 0) || ((len % block4K_size) != 0))
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    retval = op_begin (op_erase, addr, len, done_p, doneArg);
+    if (retval == successful)
+        erase_next ();
+
+    __set_PRIMASK(primask);
+
+    return retval;
+}
+
+/**
+ * @brief isBusy
+ * @return bool : true if an operation is running.
+ */
+bool AT25::isBusy (void){
+    return (op != op_none);
+}
+
+/**
+ * @brief read, blocking read_start.
+ * @return AT25_ns::status_t
+ */
+status_t AT25::read (uint32_t addr, uint8_t *buf, uint32_t len){
+    status_t retval;
+
+    retval = read_start (addr, buf, len, NULL, NULL);
+    if (retval != successful)
+        return retval;
+
+    return wait ();
+}
+
+/**
+ * @brief program, blocking program_start.
+ * @return AT25_ns::status_t
+ */
+status_t AT25::program (uint32_t addr, const uint8_t *buf, uint32_t len){
+    status_t retval;
+
+    retval = program_start (addr, buf, len, NULL, NULL);
+    if (retval != successful)
+        return retval;
+
+    return wait ();
+}
+
+/**
+ * @brief erase, blocking erase_start.
+ * @return AT25_ns::status_t
+ */
+status_t AT25::erase (uint32_t addr, uint32_t len){
+    status_t retval;
+
+    retval = erase_start (addr, len, NULL, NULL);
+    if (retval != successful)
+        return retval;
+
+    return wait ();
+}
+
+/**
+ * @brief poll, read status register if the flash is programming or erasing.
+ * @return None
+ */
+void AT25::poll (void){
+    if (!waitReady || pollInFlight)
+        return;
+
+    pollInFlight = true;
+    trans_set (&transStatus, SPI_ns::cs_auto, statusCmd, statusRx, 2, statusDone);
+    if (spi_p->queue_submit (&transStatus) != SPI_ns::successful)
+        pollInFlight = false; // queue full, next tick
+}
+
+/**
+ * @brief op_begin, take the driver for a new operation.
+ * @return AT25_ns::status_t
+ * @attention : called with IRQs disabled.
+ */
+status_t AT25::op_begin (op_t newOp, uint32_t addr, uint32_t len, done_t done_p, void *doneArg){
+    if (op != op_none)
+        return busy;
+    if (!queue_hasSlots ())
+        return busy;
+
+    op = newOp;
+    opStatus = successful;
+    this->done_p = done_p;
+    this->doneArg = doneArg;
+    this->addr = addr;
+    remaining = len;
+    waitReady = false;
+
+    return successful;
+}
+
+/**
+ * @brief op_finish, end of operation, call done_p.
+ * @param AT25_ns::status_t status
+ * @return None
+ */
+void AT25::op_finish (status_t status){
+    waitReady = false;
+    opStatus = status;
+    op = op_none;
+
+    if (done_p != NULL)
+        done_p (doneArg, status);
+}
+
+/**
+ * @brief wait, wait for the end of current operation.
+ * @return AT25_ns::status_t : result of the operation.
+ */
+status_t AT25::wait (void){
+    while (op != op_none);
+
+    return opStatus;
+}
+
+/**
+ * @brief cmd_prepare, command byte and 24-bit address (MSB first).
+ * @return None
+ */
+void AT25::cmd_prepare (uint8_t *cmd, uint8_t code, uint32_t addr){
+    cmd[0] = code;
+    cmd[1] = (uint8_t) (addr >> 16);
+    cmd[2] = (uint8_t) (addr >> 8);
+    cmd[3] = (uint8_t) addr;
+}
+
+/**
+ * @brief trans_set, fill a transaction of this device.
+ * @return None
+ */
+void AT25::trans_set (SPI_ns::transaction_s *trans_p, SPI_ns::cs_t cs, const uint8_t *tx, uint8_t *rx, uint16_t len,
+                      SPI_ns::transferDone_t done_p){
+    trans_p->device = device;
+    trans_p->txBuf = tx;
+    trans_p->rxBuf = rx;
+    trans_p->len = len;
+    trans_p->cs = cs;
+    trans_p->done_p = done_p;
+    trans_p->doneArg = this;
+}
+
+/**
+ * @brief queue_hasSlots, room for the transactions of one command in SPI queue.
+ * @return bool
+ */
+bool AT25::queue_hasSlots (void){
+    return ((SPI_ns::queue_size - spi_p->queue_pending ()) >= queueSlots);
+}
+
+/**
+ * @brief command, blocking command (one CS window), for begin.
+ * @return AT25_ns::status_t
+ */
+status_t AT25::command (const uint8_t *tx, uint8_t *rx, uint16_t len){
+    trans_set (&transStatus, SPI_ns::cs_auto, tx, rx, len, NULL);
+    if (spi_p->queue_submit (&transStatus) != SPI_ns::successful)
+        return busy;
+
+    while (transStatus.status == SPI_ns::busy);
+
+    return (transStatus.status == SPI_ns::successful) ? successful : failed;
+}
+
+/**
+ * @brief read_next, queue next chunk of a read with its own fast read command : transactions of other
+ * devices can run between chunks (the next chunk is queued by readDone), so CS isn't kept.
+ * @return None
+ */
+void AT25::read_next (void){
+    uint32_t primask;
+
+    chunk = (remaining > dmaLen_max) ? dmaLen_max : remaining;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!queue_hasSlots ()){
+        waitReady = true; // retry on next poll
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    /* fast read : command, 3 address bytes, 1 dummy byte */
+    cmd_prepare (cmdBufs[0], cmd_fastRead, addr);
+    cmdBufs[0][4] = 0;
+    trans_set (&transCmd, SPI_ns::cs_keep, cmdBufs[0], NULL, 5, cmdDone);
+    trans_set (&transData, SPI_ns::cs_auto, NULL, rxBuf, (uint16_t) chunk, readDone);
+    spi_p->queue_submit (&transCmd);
+    spi_p->queue_submit (&transData);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief program_next, queue write enable and program of one page (up to page end).
+ * @return None
+ */
+void AT25::program_next (void){
+    uint32_t primask;
+
+    chunk = page_size - (addr % page_size);
+    if (chunk > remaining)
+        chunk = remaining;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!queue_hasSlots ()){
+        waitReady = true; // retry on next poll
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    trans_set (&transWren, SPI_ns::cs_auto, &wrenCmd, NULL, 1, cmdDone);
+    trans_set (&transCmd, SPI_ns::cs_keep, cmdBufs[cmdNext], NULL, 4, cmdDone);
+    trans_set (&transData, SPI_ns::cs_auto, txBuf, NULL, (uint16_t) chunk, programSent);
+    spi_p->queue_submit (&transWren);
+    spi_p->queue_submit (&transCmd);
+    spi_p->queue_submit (&transData);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief erase_next, queue write enable and erase of the largest aligned block which fits.
+ * @return None
+ */
+void AT25::erase_next (void){
+    uint32_t primask;
+    uint8_t code;
+
+    if (((addr % block64K_size) == 0) && (remaining >= block64K_size)){
+        code = cmd_erase64K;
+        chunk = block64K_size;
+    }
+    else if (((addr % block32K_size) == 0) && (remaining >= block32K_size)){
+        code = cmd_erase32K;
+        chunk = block32K_size;
+    }
+    else {
+        code = cmd_erase4K;
+        chunk = block4K_size;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!queue_hasSlots ()){
+        waitReady = true; // retry on next poll
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    cmd_prepare (cmdBufs[0], code, addr);
+    trans_set (&transWren, SPI_ns::cs_auto, &wrenCmd, NULL, 1, cmdDone);
+    trans_set (&transCmd, SPI_ns::cs_auto, cmdBufs[0], NULL, 4, eraseSent);
+    spi_p->queue_submit (&transWren);
+    spi_p->queue_submit (&transCmd);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief readDone, end of a read chunk (DMA ISR context).
+ * @return None
+ */
+void AT25::readDone (void *arg, SPI_ns::status_t status){
+    AT25 *at25_p = (AT25 *) arg;
+
+    if ((status != SPI_ns::successful) || (at25_p->opStatus != successful)){
+        at25_p->op_finish (failed);
+        return;
+    }
+
+    at25_p->rxBuf += at25_p->chunk;
+    at25_p->addr += at25_p->chunk;
+    at25_p->remaining -= at25_p->chunk;
+
+    if (at25_p->remaining != 0)
+        at25_p->read_next ();
+    else
+        at25_p->op_finish (successful);
+}
+
+/**
+ * @brief programSent, page has been sent, flash programs it (DMA ISR context).
+ * Command of next page is prepared now, while flash is busy.
+ * @return None
+ */
+void AT25::programSent (void *arg, SPI_ns::status_t status){
+    AT25 *at25_p = (AT25 *) arg;
+
+    if ((status != SPI_ns::successful) || (at25_p->opStatus != successful)){
+        at25_p->op_finish (failed);
+        return;
+    }
+
+    at25_p->txBuf += at25_p->chunk;
+    at25_p->addr += at25_p->chunk;
+    at25_p->remaining -= at25_p->chunk;
+
+    at25_p->cmdNext ^= 0x01;
+    if (at25_p->remaining != 0)
+        at25_p->cmd_prepare (at25_p->cmdBufs[at25_p->cmdNext], cmd_pageProgram, at25_p->addr);
+
+    at25_p->waitReady = true;
+}
+
+/**
+ * @brief eraseSent, erase command has been sent, flash erases (DMA ISR context).
+ * @return None
+ */
+void AT25::eraseSent (void *arg, SPI_ns::status_t status){
+    AT25 *at25_p = (AT25 *) arg;
+
+    if ((status != SPI_ns::successful) || (at25_p->opStatus != successful)){
+        at25_p->op_finish (failed);
+        return;
+    }
+
+    at25_p->addr += at25_p->chunk;
+    at25_p->remaining -= at25_p->chunk;
+
+    at25_p->waitReady = true;
+}
+
+/**
+ * @brief cmdDone, end of a command part (DMA ISR context), only errors matter.
+ * @return None
+ */
+void AT25::cmdDone (void *arg, SPI_ns::status_t status){
+    if (status != SPI_ns::successful)
+        ((AT25 *) arg)->opStatus = failed;
+}
+
+/**
+ * @brief statusDone, status register has been read (DMA ISR context).
+ * @return None
+ */
+void AT25::statusDone (void *arg, SPI_ns::status_t status){
+    AT25 *at25_p = (AT25 *) arg;
+    uint8_t flashStatus = at25_p->statusRx[1];
+
+    at25_p->pollInFlight = false;
+
+    if ((status != SPI_ns::successful) || ((flashStatus & status_busy) != 0))
+        return; // poll again on next tick
+
+    at25_p->waitReady = false;
+
+    if ((flashStatus & status_epe) != 0){
+        at25_p->op_finish (failed);
+        return;
+    }
+
+    switch (at25_p->op){
+    case op_read:
+        at25_p->read_next ();
+        break;
+
+    case op_program:
+        if (at25_p->remaining != 0)
+            at25_p->program_next ();
+        else
+            at25_p->op_finish (successful);
+        break;
+
+    case op_erase:
+        if (at25_p->remaining != 0)
+            at25_p->erase_next ();
+        else
+            at25_p->op_finish (successful);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**<----------------------------- misc timer ------------------------------------*/
+
+/**
+ * @brief at25_miscTIMISR, poll BUSY of all AT25 which have begun.
+ * @return None
+ */
+void at25_miscTIMISR (void){
+    uint8_t count;
+
+    for (count = 0; count < objs_max; count++){
+        if (_at25Objs[count] != NULL)
+            _at25Objs[count]->poll ();
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file MB1_AT25.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for AT25-series SPI flash (AT25DF/AT25SF) on MBoard-1.
+ * All operations run on the transaction queue of SPI (DMA), they don't block the CPU :
+ * - read : a fast-read command streams across pages, one command per DMA chunk of 64KB - 1 (other
+ *   devices on the bus can run between chunks).
+ * - program : page by page, the command of the next page is prepared while the flash programs.
+ * - erase : range is split in 64KB/32KB/4KB blocks (largest aligned first), one after another.
+ * BUSY is polled by at25_miscTIMISR (every miscTIM_period) instead of spinning.
+ * Blocking versions (read, program, erase) wait for the end of the operation, they need
+ * at25_miscTIMISR too, don't call them from ISRs.
+ * How to use this lib:
+ * - SPI has been init-ed and at25Flash_x is mapped to a decode value (SM_deviceToDecoder_set),
+ *   SPI mode 0 or 3, up to 18 MHz on SPI1 (optional : SM_deviceProfile_set).
+ * - at25_miscTIMISR is assigned to miscTIM : set MB1_conf_at25Poll_isUsed in MB1_System.cpp (off by
+ *   default, miscTIM has numOfSubISR_max sub-ISRs), or subISR_assign it in the application.
+ * - Declare an AT25 (&MB1_SPI1, SPI_ns::at25Flash_1), begin, then xxx_start or blocking xxx.
+ * - One operation at a time per AT25 (busy otherwise), done_p is called in ISR context, the
+ *   operation has ended then and done_p can start the next one (xxx_start).
+ * - MB1_AT25Model.h is a host model of the chip, for tests of flash users on Linux,
+ *   host/mb1_at25check.cpp runs this driver on it.
+ */
+
+#ifndef __MB1_AT25_H
+#define __MB1_AT25_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_SPI.h"
+
+namespace AT25_ns {
+
+/**< config (compile-time) */
+const uint16_t page_size = 256;
+const uint32_t block4K_size = 4096;
+const uint32_t block32K_size = 32768;
+const uint32_t block64K_size = 65536;
+const uint16_t dmaLen_max = 0xFFFF;
+const uint8_t objs_max = 2;
+const uint8_t queueSlots = 3;   // transactions queued at once by a command
+
+/**< commands */
+const uint8_t cmd_read = 0x03;
+const uint8_t cmd_fastRead = 0x0B;
+const uint8_t cmd_pageProgram = 0x02;
+const uint8_t cmd_writeEnable = 0x06;
+const uint8_t cmd_writeDisable = 0x04;
+const uint8_t cmd_readStatus = 0x05;
+const uint8_t cmd_writeStatus = 0x01;
+const uint8_t cmd_erase4K = 0x20;
+const uint8_t cmd_erase32K = 0x52;
+const uint8_t cmd_erase64K = 0xD8;
+const uint8_t cmd_chipErase = 0x60;
+const uint8_t cmd_readID = 0x9F;
+
+/**< status register */
+const uint8_t status_busy = 0x01;
+const uint8_t status_wel = 0x02;
+const uint8_t status_epe = 0x20;   // erase/program error
+
+typedef enum {
+    successful,
+    failed,
+    busy
+} status_t;
+
+typedef enum {
+    op_none,
+    op_read,
+    op_program,
+    op_erase
+} op_t;
+
+/**< called in ISR context when an operation is finished */
+typedef void (* done_t) (void *arg, status_t status);
+
+}
+
+class AT25 {
+public:
+    AT25 (SPI *spi_p, SPI_ns::SM_device_t device);
+
+    AT25_ns::status_t begin (void);
+    uint32_t id_get (void);
+
+    AT25_ns::status_t read_start (uint32_t addr, uint8_t *buf, uint32_t len, AT25_ns::done_t done_p, void *doneArg);
+    AT25_ns::status_t program_start (uint32_t addr, const uint8_t *buf, uint32_t len, AT25_ns::done_t done_p, void *doneArg);
+    AT25_ns::status_t erase_start (uint32_t addr, uint32_t len, AT25_ns::done_t done_p, void *doneArg);
+    bool isBusy (void);
+
+    AT25_ns::status_t read (uint32_t addr, uint8_t *buf, uint32_t len);
+    AT25_ns::status_t program (uint32_t addr, const uint8_t *buf, uint32_t len);
+    AT25_ns::status_t erase (uint32_t addr, uint32_t len);
+
+    //must be called from at25_miscTIMISR.
+    void poll (void);
+
+private:
+    SPI *spi_p;
+    SPI_ns::SM_device_t device;
+    uint32_t jedecID;
+
+    /* current operation */
+    volatile AT25_ns::op_t op;
+    volatile AT25_ns::status_t opStatus;
+    AT25_ns::done_t done_p;
+    void *doneArg;
+    uint32_t addr;
+    uint8_t *rxBuf;
+    const uint8_t *txBuf;
+    uint32_t remaining;
+    uint32_t chunk;
+
+    /* status polling */
+    volatile bool waitReady;
+    volatile bool pollInFlight;
+
+    /* command buffers, cmdBufs[cmdNext] is prepared while flash is busy */
+    uint8_t cmdBufs [2][5];
+    uint8_t cmdNext;
+    uint8_t wrenCmd;
+    uint8_t statusCmd [2];
+    uint8_t statusRx [2];
+
+    SPI_ns::transaction_s transWren;
+    SPI_ns::transaction_s transCmd;
+    SPI_ns::transaction_s transData;
+    SPI_ns::transaction_s transStatus;
+
+    AT25_ns::status_t op_begin (AT25_ns::op_t newOp, uint32_t addr, uint32_t len, AT25_ns::done_t done_p, void *doneArg);
+    void op_finish (AT25_ns::status_t status);
+    AT25_ns::status_t wait (void);
+    void cmd_prepare (uint8_t *cmd, uint8_t code, uint32_t addr);
+    void trans_set (SPI_ns::transaction_s *trans_p, SPI_ns::cs_t cs, const uint8_t *tx, uint8_t *rx, uint16_t len,
+                    SPI_ns::transferDone_t done_p);
+    bool queue_hasSlots (void);
+    AT25_ns::status_t command (const uint8_t *tx, uint8_t *rx, uint16_t len);
+
+    void read_next (void);
+    void program_next (void);
+    void erase_next (void);
+
+    static void readDone (void *arg, SPI_ns::status_t status);
+    static void programSent (void *arg, SPI_ns::status_t status);
+    static void eraseSent (void *arg, SPI_ns::status_t status);
+    static void cmdDone (void *arg, SPI_ns::status_t status);
+    static void statusDone (void *arg, SPI_ns::status_t status);
+};
+
+/* polls BUSY of all AT25 which have begun, should be placed in miscTIMISR */
+void at25_miscTIMISR (void);
+
+#endif // __MB1_AT25_H
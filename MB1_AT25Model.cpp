@@ -0,0 +1,281 @@
+/**
+ * @file MB1_AT25Model.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for a host model of AT25-series SPI flash.
+ */
+
+/* Includes */
+#include "MB1_AT25Model.h"
+using namespace AT25Model_ns;
+
+/**< commands and status bits, same as AT25_ns */
+static const uint8_t cmd_read = 0x03;
+static const uint8_t cmd_fastRead = 0x0B;
+static const uint8_t cmd_pageProgram = 0x02;
+static const uint8_t cmd_writeEnable = 0x06;
+static const uint8_t cmd_writeDisable = 0x04;
+static const uint8_t cmd_readStatus = 0x05;
+static const uint8_t cmd_writeStatus = 0x01;
+static const uint8_t cmd_erase4K = 0x20;
+static const uint8_t cmd_erase32K = 0x52;
+static const uint8_t cmd_erase64K = 0xD8;
+static const uint8_t cmd_eraseChip = 0x60;
+static const uint8_t cmd_eraseChip2 = 0xC7;
+static const uint8_t cmd_readID = 0x9F;
+
+static const uint8_t status_busy = 0x01;
+static const uint8_t status_wel = 0x02;
+
+/**<----------------------------- class AT25Model ------------------------------------*/
+
+/**
+ * @brief AT25Model, mem is erased.
+ * @param uint8_t *mem : flash array.
+ * @param uint32_t size : bytes, multiple of 64KB.
+ */
+AT25Model::AT25Model (uint8_t *mem, uint32_t size){
+    this->mem = mem;
+    this->size = size;
+    memset (mem, 0xFF, size);
+
+    csLow = false;
+    cmd = 0;
+    count = 0;
+    addr = 0;
+    status = 0;
+    busyLeft_us = 0;
+    stats_reset ();
+}
+
+/**
+ * @brief cs_set, a command starts on CS low and is executed on CS high.
+ * @param bool isLow
+ * @return None
+ */
+void AT25Model::cs_set (bool isLow){
+    if (isLow == csLow)
+        return;
+
+    csLow = isLow;
+    if (isLow){
+        count = 0;
+        addr = 0;
+    }
+    else if (count != 0)
+        cmd_end ();
+}
+
+/**
+ * @brief transfer, one byte in full duplex.
+ * @param uint8_t mosi
+ * @return uint8_t : miso, 0xFF when nothing is driven.
+ */
+uint8_t AT25Model::transfer (uint8_t mosi){
+    uint8_t miso;
+
+    if (!csLow)
+        return 0xFF;
+
+    if (count == 0){
+        cmd = mosi;
+        stats.commands++;
+        miso = 0xFF;
+    }
+    else
+        miso = cmd_byte (mosi);
+
+    count++;
+
+    return miso;
+}
+
+/**
+ * @brief tick_us, time goes on for program/erase.
+ * @param uint32_t us
+ * @return None
+ */
+void AT25Model::tick_us (uint32_t us){
+    if (busyLeft_us == 0)
+        return;
+
+    if (us >= busyLeft_us){
+        busyLeft_us = 0;
+        status &= ~(status_busy | status_wel);
+    }
+    else
+        busyLeft_us -= us;
+}
+
+/**
+ * @brief isBusy
+ * @return bool : true while programming or erasing.
+ */
+bool AT25Model::isBusy (void){
+    return (busyLeft_us != 0);
+}
+
+/**
+ * @brief stats_get
+ * @param AT25Model_ns::stats_t *stats_p
+ * @return None
+ */
+void AT25Model::stats_get (stats_t *stats_p){
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void AT25Model::stats_reset (void){
+    memset (&stats, 0, sizeof (stats));
+}
+
+/**
+ * @brief cmd_byte, bytes after the command byte.
+ * @return uint8_t : miso
+ */
+uint8_t AT25Model::cmd_byte (uint8_t mosi){
+    uint32_t offset;
+
+    if (cmd == cmd_readStatus)
+        return status;
+
+    if (busyLeft_us != 0)
+        return 0xFF; // chip ignores other commands while busy
+
+    switch (cmd){
+    case cmd_readID:
+        if (count > 3)
+            return 0xFF;
+        return (uint8_t) (jedecID >> (8 * (3 - count)));
+
+    case cmd_read:
+    case cmd_fastRead:
+    case cmd_pageProgram:
+        if (count <= 3){
+            addr = (addr << 8) | mosi;
+            if (count == 3)
+                addr %= size;
+            return 0xFF;
+        }
+        if ((cmd == cmd_fastRead) && (count == 4))
+            return 0xFF; // dummy byte
+
+        if (cmd == cmd_pageProgram){
+            if ((status & status_wel) == 0)
+                return 0xFF;
+            /* address wraps inside the page, program clears bits only */
+            offset = (addr & ~(page_size - 1)) | ((addr + count - 4) & (page_size - 1));
+            mem[offset] &= mosi;
+            stats.bytesProgrammed++;
+            return 0xFF;
+        }
+
+        offset = (addr + count - ((cmd == cmd_fastRead) ? 5 : 4)) % size;
+        stats.bytesRead++;
+        return mem[offset];
+
+    default:
+        if (count <= 3)
+            addr = (addr << 8) | mosi;
+        return 0xFF;
+    }
+}
+
+/**
+ * @brief cmd_end, CS high, execute write commands.
+ * @return None
+ */
+void AT25Model::cmd_end (void){
+    if (busyLeft_us != 0){
+        if (cmd != cmd_readStatus)
+            stats.rejected++;
+        return;
+    }
+
+    switch (cmd){
+    case cmd_writeEnable:
+        status |= status_wel;
+        break;
+
+    case cmd_writeDisable:
+        status &= ~status_wel;
+        break;
+
+    case cmd_writeStatus:
+        if ((status & status_wel) == 0){
+            stats.rejected++;
+            break;
+        }
+        status &= ~status_wel; // protection bits are not modelled
+        break;
+
+    case cmd_pageProgram:
+        if (((status & status_wel) == 0) || (count < 5)){
+            stats.rejected++;
+            break;
+        }
+        stats.pagePrograms++;
+        busy_set (program_us);
+        break;
+
+    case cmd_erase4K:
+        erase (4096, erase4K_us);
+        break;
+
+    case cmd_erase32K:
+        erase (32768, erase32K_us);
+        break;
+
+    case cmd_erase64K:
+        erase (65536, erase64K_us);
+        break;
+
+    case cmd_eraseChip:
+    case cmd_eraseChip2:
+        if ((status & status_wel) == 0){
+            stats.rejected++;
+            break;
+        }
+        memset (mem, 0xFF, size);
+        stats.erases++;
+        stats.bytesErased += size;
+        busy_set (eraseChip_us);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief erase, block which contains addr.
+ * @return None
+ */
+void AT25Model::erase (uint32_t blockSize, uint32_t time_us){
+    uint32_t start;
+
+    if (((status & status_wel) == 0) || (count != 4)){
+        stats.rejected++;
+        return;
+    }
+
+    start = (addr % size) & ~(blockSize - 1);
+    memset (&mem[start], 0xFF, blockSize);
+    stats.erases++;
+    stats.bytesErased += blockSize;
+    busy_set (time_us);
+}
+
+/**
+ * @brief busy_set, start of program/erase.
+ * @return None
+ */
+void AT25Model::busy_set (uint32_t time_us){
+    status |= status_busy;
+    busyLeft_us = time_us;
+    stats.busy_us += time_us;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file MB1_AT25Model.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for a host model of AT25-series SPI flash.
+ * The model works at byte level, like the chip on the bus : CS low, bytes in/out, CS high.
+ * - Program only clears bits (AND), address wraps inside the page like the chip.
+ * - Write enable is needed for program/erase/write status and is cleared after them.
+ * - Program/erase keep BUSY for a time (tick_us), only read status is accepted while busy.
+ * This file only depends on stdint.h and string.h, so host tests build it with the
+ * users of the flash (KV store, cache ...) and a fake SPI on top of transfer, or with MB1_AT25
+ * on the SPI model of host/MB1_Host.h (host/mb1_at25check.cpp).
+ * How to use this lib:
+ * - Declare an AT25Model (mem, size), mem is the flash array (erased to 0xFF by the model).
+ * - cs_set (true), transfer each byte, cs_set (false).
+ * - tick_us to let time go for program/erase, stats_get for counters.
+ */
+
+#ifndef __MB1_AT25MODEL_H
+#define __MB1_AT25MODEL_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "string.h"
+
+namespace AT25Model_ns {
+
+/**< config (compile-time), typical times of AT25DF */
+const uint32_t page_size = 256;
+const uint32_t jedecID = 0x1F4501;      // AT25DF081
+const uint32_t program_us = 1000;       // page
+const uint32_t erase4K_us = 50000;
+const uint32_t erase32K_us = 250000;
+const uint32_t erase64K_us = 400000;
+const uint32_t eraseChip_us = 7000000;
+
+typedef struct {
+    uint32_t commands;
+    uint32_t bytesRead;
+    uint32_t bytesProgrammed;
+    uint32_t pagePrograms;
+    uint32_t erases;
+    uint32_t bytesErased;
+    uint32_t rejected;                  // no write enable, busy, out of range
+    uint32_t busy_us;                   // total time of program/erase
+} stats_t;
+
+}
+
+class AT25Model {
+public:
+    AT25Model (uint8_t *mem, uint32_t size);
+    void cs_set (bool isLow);
+    uint8_t transfer (uint8_t mosi);
+    void tick_us (uint32_t us);
+    bool isBusy (void);
+    void stats_get (AT25Model_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+private:
+    uint8_t *mem;
+    uint32_t size;
+
+    bool csLow;
+    uint8_t cmd;
+    uint32_t count;                     // bytes since CS low
+    uint32_t addr;
+    uint8_t status;
+    uint32_t busyLeft_us;
+    AT25Model_ns::stats_t stats;
+
+    uint8_t cmd_byte (uint8_t mosi);
+    void cmd_end (void);
+    void erase (uint32_t blockSize, uint32_t time_us);
+    void busy_set (uint32_t time_us);
+};
+
+#endif // __MB1_AT25MODEL_H
@@ -0,0 +1,241 @@
+/**
+ * @file MB1_Baud.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for automatic baud-rate negotiation (host and target sides).
+ */
+
+/* Includes */
+#include "MB1_Baud.h"
+#include "string.h"
+using namespace Baud_ns;
+
+/**
+ * @brief baud_error_get, BRR error of STM32F1 USART (16x oversampling, 4-bit fraction).
+ * @param uint32_t pclk : clock of the USART (PCLK2 for USART1, PCLK1 for others).
+ * @param uint32_t baud
+ * @return uint16_t : |real - baud| / baud in 1/10000, 0xFFFF if baud can't be reached.
+ */
+uint16_t baud_error_get (uint32_t pclk, uint32_t baud){
+    uint32_t brr, real, diff;
+
+    if (baud == 0)
+        return 0xFFFF;
+
+    /* BRR = USARTDIV * 16 = pclk / baud, rounded */
+    brr = (pclk + baud / 2) / baud;
+    if ((brr < 16) || (brr > 0xFFFF))
+        return 0xFFFF;
+
+    real = pclk / brr;
+    diff = (real > baud) ? (real - baud) : (baud - real);
+
+    return (uint16_t) (((uint64_t) diff * 10000 + baud / 2) / baud);
+}
+
+/**<----------------------------- class BaudLink --------------------------------*/
+
+/**
+ * @brief BaudLink.
+ * @param const Baud_ns::io_s *io_p : link functions, must stay valid.
+ * @param Cobs_ns::crcWord_t crcWord_p : same CRC on both sides, e.g. cobs_crcWord_sw.
+ */
+BaudLink::BaudLink (const io_s *io_p, Cobs_ns::crcWord_t crcWord_p)
+    : encoder (io_p->send_p, io_p->ctx, crcWord_p),
+      decoder (msgBuf, msgBuf_size, crcWord_p){
+    this->io_p = io_p;
+    msg = NULL;
+}
+
+/**
+ * @brief host_negotiate, step the rate up through rates, stop at the first failure.
+ * @param const uint32_t rates[] : in increasing order.
+ * @param uint8_t numOfRates
+ * @param uint32_t startBaud : current rate of both sides.
+ * @param uint32_t *baud_p : last confirmed rate.
+ * @return Baud_ns::status_t : failed if target hasn't answered at startBaud.
+ */
+status_t BaudLink::host_negotiate (const uint32_t rates[], uint8_t numOfRates, uint32_t startBaud, uint32_t *baud_p){
+    uint32_t current = startBaud;
+    status_t retval = failed;
+    uint8_t count;
+
+    for (count = 0; count < numOfRates; count++){
+        if (rates[count] <= current)
+            continue;
+
+        msg_send (msg_propose, rates[count], NULL, 0);
+        if (msg_recv (msg_accept, rates[count], stepTimeout_ms) != 1 + 4 + 1)
+            break;
+        retval = successful;
+        if (msg[5] == 0)
+            continue;   // BRR error too big on target, try next rate
+
+        io_p->baudSet_p (io_p->ctx, rates[count]);
+        if (!host_step (rates[count])){
+            /* target goes back after stepTimeout_ms without test or confirm */
+            io_p->baudSet_p (io_p->ctx, current);
+            while (io_p->get_p (io_p->ctx, stepTimeout_ms) >= 0) {};
+            break;
+        }
+        current = rates[count];
+    }
+
+    msg_send (msg_done, current, NULL, 0);
+    *baud_p = current;
+
+    return retval;
+}
+
+/**
+ * @brief target_negotiate, answer the host until done or timeout.
+ * @param uint32_t pclk : clock of the USART, for BRR error.
+ * @param uint32_t startBaud : current rate.
+ * @param uint32_t listen_ms : wait for each propose (or done) at most listen_ms.
+ * @param uint32_t *baud_p : rate at the end.
+ * @return Baud_ns::status_t : failed if nothing has come from the host.
+ */
+status_t BaudLink::target_negotiate (uint32_t pclk, uint32_t startBaud, uint32_t listen_ms, uint32_t *baud_p){
+    uint8_t pattern [testLen];
+    uint32_t current = startBaud;
+    uint32_t baud;
+    status_t retval = failed;
+    bool isPending = false;
+    uint8_t ok;
+    uint16_t len;
+
+    while (1){
+        /* a message may have been got already, while checking a new rate */
+        if (!isPending && (msg_recv (0, 0, listen_ms) < 1 + 4))
+            break;
+        isPending = false;
+
+        baud = msg[1] | (msg[2] << 8) | ((uint32_t) msg[3] << 16) | ((uint32_t) msg[4] << 24);
+        retval = successful;
+        if (msg[0] == msg_done)
+            break;
+        if (msg[0] != msg_propose)
+            continue;
+
+        ok = (baud_error_get (pclk, baud) <= error_max) ? 1 : 0;
+        msg_send (msg_accept, baud, &ok, 1);
+        if (!ok)
+            continue;
+
+        io_p->baudSet_p (io_p->ctx, baud);
+
+        len = msg_recv (msg_test, baud, stepTimeout_ms);
+        pattern_fill (pattern, baud);
+        if ((len == 1 + 4 + testLen) && (memcmp (&msg[5], pattern, testLen) == 0)){
+            msg_send (msg_test, baud, pattern, testLen);
+            if (msg_recv (msg_confirm, baud, stepTimeout_ms) == 1 + 4){
+                msg_send (msg_confirm, baud, NULL, 0);
+
+                /* host may have missed the echo : keep the rate only when its next message
+                 * (propose or done) comes at this rate */
+                if (msg_recv (0, 0, stepTimeout_ms) >= 1 + 4){
+                    current = baud;
+                    isPending = true;
+                    continue;
+                }
+            }
+        }
+
+        io_p->baudSet_p (io_p->ctx, current);
+    }
+
+    *baud_p = current;
+
+    return retval;
+}
+
+/**
+ * @brief msg_send, send a message.
+ * @param uint8_t type
+ * @param uint32_t baud
+ * @param const uint8_t *data : can be NULL if len = 0.
+ * @param uint8_t len
+ * @return None
+ */
+void BaudLink::msg_send (uint8_t type, uint32_t baud, const uint8_t *data, uint8_t len){
+    uint8_t header [1 + 4];
+
+    header[0] = type;
+    header[1] = (uint8_t) baud;
+    header[2] = (uint8_t) (baud >> 8);
+    header[3] = (uint8_t) (baud >> 16);
+    header[4] = (uint8_t) (baud >> 24);
+
+    encoder.frame_begin ();
+    encoder.data_put (header, sizeof (header));
+    if (len > 0)
+        encoder.data_put (data, len);
+    encoder.frame_end ();
+}
+
+/**
+ * @brief msg_recv, wait for a message, broken frames and other messages are skipped.
+ * @param uint8_t type : 0 for any type.
+ * @param uint32_t baud : checked if type != 0.
+ * @param uint32_t timeout_ms : for each byte.
+ * @return uint16_t : length of message (in msg), 0 on timeout.
+ */
+uint16_t BaudLink::msg_recv (uint8_t type, uint32_t baud, uint32_t timeout_ms){
+    int16_t data;
+    uint16_t len;
+
+    decoder.reset ();
+
+    while ((data = io_p->get_p (io_p->ctx, timeout_ms)) >= 0){
+        if (decoder.data_put ((uint8_t) data) != Cobs_ns::frameReady)
+            continue;
+
+        len = decoder.frame_get (&msg);
+        if (len < 1 + 4)
+            continue;
+        if (type == 0)
+            return len;
+        if ((msg[0] == type) &&
+            ((msg[1] | (msg[2] << 8) | ((uint32_t) msg[3] << 16) | ((uint32_t) msg[4] << 24)) == baud))
+            return len;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief pattern_fill, test pattern of a rate, every byte value shows up in 4 patterns.
+ * @param uint8_t *buf : testLen bytes.
+ * @param uint32_t baud
+ * @return None
+ */
+void BaudLink::pattern_fill (uint8_t *buf, uint32_t baud){
+    uint8_t count;
+
+    for (count = 0; count < testLen; count++)
+        buf[count] = (uint8_t) (count * 37 + (baud >> 8));
+}
+
+/**
+ * @brief host_step, test and confirm a new rate (host is already at this rate).
+ * @param uint32_t baud
+ * @return bool : true if target has confirmed.
+ */
+bool BaudLink::host_step (uint32_t baud){
+    uint8_t pattern [testLen];
+
+    /* drop garbage of the rate change, give target time to switch */
+    while (io_p->get_p (io_p->ctx, settle_ms) >= 0) {};
+
+    pattern_fill (pattern, baud);
+    msg_send (msg_test, baud, pattern, testLen);
+    if (msg_recv (msg_test, baud, stepTimeout_ms) != 1 + 4 + testLen)
+        return false;
+    if (memcmp (&msg[5], pattern, testLen) != 0)
+        return false;
+
+    msg_send (msg_confirm, baud, NULL, 0);
+
+    return (msg_recv (msg_confirm, baud, stepTimeout_ms) == 1 + 4);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file MB1_Baud.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for automatic baud-rate negotiation (host and target sides).
+ * Messages are COBS frames with CRC-32 (see MB1_Cobs.h), little-endian :
+ *      propose : | 0x01 | baud (4) |                  host -> target, at current rate
+ *      accept  : | 0x02 | baud (4) | ok (1) |         target -> host, ok if BRR error <= error_max
+ *      test    : | 0x03 | baud (4) | pattern (testLen) |  host -> target at new rate, target echoes it
+ *      confirm : | 0x04 | baud (4) |                  host -> target, target echoes it
+ *      done    : | 0x05 | baud (4) |                  host -> target, end of negotiation
+ * Host proposes rates in order and stops at the first one which fails. Any step without a valid
+ * answer within stepTimeout_ms makes both sides go back to the last confirmed rate.
+ * Host keeps a new rate when it gets the confirm echo, target keeps it when the next message
+ * of the host (propose or done) comes at this rate : if the echo is lost, the host goes back and
+ * waits, the target doesn't get this message and goes back too.
+ * This file only depends on stdint.h, so host tools build the same code (io_s on a tty,
+ * see host/mb1_baud.cpp).
+ * How to use this lib:
+ * - Target : baud_negotiate of MB1_BaudTarget.h (serial_t), or target_negotiate with own io_s.
+ * - Host : host_negotiate (rates, numOfRates, startBaud, &baud).
+ */
+
+#ifndef __MB1_BAUD_H
+#define __MB1_BAUD_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "MB1_Cobs.h"
+
+namespace Baud_ns {
+
+/**< config (compile-time) */
+const uint16_t error_max = 150;         // max BRR error, in 1/10000 (1.5 %)
+const uint8_t testLen = 64;             // bytes of test pattern
+const uint32_t stepTimeout_ms = 200;
+const uint32_t settle_ms = 20;          // host waits after a rate change
+const uint16_t msgBuf_size = 1 + 4 + testLen + Cobs_ns::crcLen;
+
+/**< message types */
+const uint8_t msg_propose = 0x01;
+const uint8_t msg_accept = 0x02;
+const uint8_t msg_test = 0x03;
+const uint8_t msg_confirm = 0x04;
+const uint8_t msg_done = 0x05;
+
+typedef enum {
+    successful,
+    failed
+} status_t;
+
+/**< get 1 byte, waiting at most timeout_ms, returns -1 on timeout */
+typedef int16_t (* get_t) (void *ctx, uint32_t timeout_ms);
+
+/**< change rate, after all pending TX has been sent */
+typedef void (* baudSet_t) (void *ctx, uint32_t baud);
+
+typedef struct {
+    void *ctx;
+    Cobs_ns::sink_t send_p;
+    get_t get_p;
+    baudSet_t baudSet_p;
+} io_s;
+
+}
+
+/* BRR error of a baud rate for a USART clock, in 1/10000 (0xFFFF if it can't be reached) */
+uint16_t baud_error_get (uint32_t pclk, uint32_t baud);
+
+class BaudLink {
+public:
+    BaudLink (const Baud_ns::io_s *io_p, Cobs_ns::crcWord_t crcWord_p);
+
+    Baud_ns::status_t host_negotiate (const uint32_t rates[], uint8_t numOfRates, uint32_t startBaud, uint32_t *baud_p);
+    Baud_ns::status_t target_negotiate (uint32_t pclk, uint32_t startBaud, uint32_t listen_ms, uint32_t *baud_p);
+
+private:
+    const Baud_ns::io_s *io_p;
+    CobsEncoder encoder;
+    CobsDecoder decoder;
+    uint8_t msgBuf [Baud_ns::msgBuf_size];
+    const uint8_t *msg;
+
+    void msg_send (uint8_t type, uint32_t baud, const uint8_t *data, uint8_t len);
+    uint16_t msg_recv (uint8_t type, uint32_t baud, uint32_t timeout_ms);
+    void pattern_fill (uint8_t *buf, uint32_t baud);
+    bool host_step (uint32_t baud);
+};
+
+#endif // __MB1_BAUD_H
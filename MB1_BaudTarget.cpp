@@ -0,0 +1,74 @@
+/**
+ * @file MB1_BaudTarget.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for baud-rate negotiation on a serial_t (target side of MB1_Baud.h).
+ */
+
+/* Includes */
+#include "MB1_BaudTarget.h"
+#include "MB1_Misc.h"
+#include "hl_crc.h"
+using namespace Baud_ns;
+
+/* Private functions */
+static int16_t BaudTarget_get (void *ctx, uint32_t timeout_ms);
+static void BaudTarget_baudSet (void *ctx, uint32_t baud);
+
+/**
+ * @brief baud_negotiate, answer baud-rate negotiation of the host.
+ * @param serial_t *serial_p
+ * @param uint32_t startBaud : current rate of serial_p.
+ * @param uint32_t listen_ms : how long to wait for the host (for each step).
+ * @param uint32_t *baud_p : rate at the end.
+ * @return Baud_ns::status_t : failed if host hasn't started a negotiation.
+ */
+status_t baud_negotiate (serial_t *serial_p, uint32_t startBaud, uint32_t listen_ms, uint32_t *baud_p){
+    io_s io;
+
+    io.ctx = serial_p;
+    io.send_p = serial_t::Out_sink;
+    io.get_p = BaudTarget_get;
+    io.baudSet_p = BaudTarget_baudSet;
+
+    BaudLink link (&io, CRC_hwWord);
+
+    return link.target_negotiate (serial_p->ClockFreq (), startBaud, listen_ms, baud_p);
+}
+
+/**
+ * @brief BaudTarget_get, get 1 byte from RX buffer or USART (polling).
+ * @param void *ctx : serial_t.
+ * @param uint32_t timeout_ms
+ * @return int16_t : byte, -1 on timeout.
+ */
+static int16_t BaudTarget_get (void *ctx, uint32_t timeout_ms){
+    serial_t *serial_p = (serial_t *) ctx;
+    uint32_t start = ticks_ms_get ();
+    uint8_t data;
+
+    do {
+        if (serial_p->HasRxBuffer ()){
+            if (serial_p->Read (&data, 1) == 1)
+                return data;
+        }
+        else if (serial_p->RxReady ())
+            return (uint8_t) serial_p->Get_ISR ();
+    } while (ticks_ms_get () - start <= timeout_ms);
+
+    return -1;
+}
+
+/**
+ * @brief BaudTarget_baudSet, restart serial_t at a new rate after pending TX.
+ * @param void *ctx : serial_t.
+ * @param uint32_t baud
+ * @return None
+ */
+static void BaudTarget_baudSet (void *ctx, uint32_t baud){
+    serial_t *serial_p = (serial_t *) ctx;
+
+    serial_p->Flush ();
+    serial_p->Restart (baud);
+}
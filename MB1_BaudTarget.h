@@ -0,0 +1,24 @@
+/**
+ * @file MB1_BaudTarget.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for baud-rate negotiation on a serial_t (target side of MB1_Baud.h).
+ * How to use this lib:
+ * - ticks_ms_miscTIMISR must be assigned (timeouts).
+ * - CRC of frames is computed by the CRC unit (CRC_hwWord turns its clock on).
+ * - serial_t has been restarted at startBaud, polling RX or with an RX buffer.
+ * - baud_negotiate (&MB1_USART2, 9600, 1000, &baud), serial_t is left at the negotiated rate (8N1).
+ */
+
+#ifndef __MB1_BAUDTARGET_H
+#define __MB1_BAUDTARGET_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_Serial_t.h"
+#include "MB1_Baud.h"
+
+Baud_ns::status_t baud_negotiate (serial_t *serial_p, uint32_t startBaud, uint32_t listen_ms, uint32_t *baud_p);
+
+#endif // __MB1_BAUDTARGET_H
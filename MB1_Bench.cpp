@@ -0,0 +1,474 @@
+/**
+ * @file MB1_Bench.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for on-target benchmarks of serial_t (DWT cycle counter).
+ */
+
+/* Includes */
+#include "MB1_Bench.h"
+#include "MB1_Misc.h"
+#include "MB1_Format.h"
+#include "stdio.h"
+using namespace Bench_ns;
+
+/**< one result line */
+typedef struct {
+    const char *path;
+    uint32_t baud;
+    uint16_t size;
+    uint8_t iterations;
+    uint32_t cyclesSum;
+    uint32_t cyclesMax;
+} Bench_result_s;
+
+const uint8_t Bench_results_max = 6 + 8 * numOfSizes;   // results of one baud rate (fmt + paths)
+
+static Bench_result_s Bench_results [Bench_results_max];
+static uint8_t Bench_numOfResults;
+
+static uint8_t Bench_msg [ring_size];
+static uint8_t Bench_ring [ring_size];
+static uint8_t Bench_rxData [ring_size];
+
+/* Private functions */
+static Bench_result_s *Bench_result_new (const char *path, uint32_t baud, uint16_t size);
+static void Bench_result_add (Bench_result_s *result_p, uint32_t cycles);
+static void Bench_results_print (serial_t *serial_p);
+static void Bench_fmt (uint32_t baud);
+static uint8_t Bench_oldU32 (char *buf, uint32_t num);
+static void Bench_out (serial_t *serial_p, uint32_t baud, bool loopback);
+static void Bench_rxDrain (serial_t *serial_p);
+static uint8_t Bench_streams_get (serial_t *serial_p);
+static void Bench_stdout_set (serial_t *serial_p);
+
+/**
+ * @brief bench_run, run all benchmarks and print results.
+ * @param serial_t *serial_p : serial_t under test, also used for results.
+ * @param uint32_t reportBaud : baud rate of results.
+ * @param bool loopback : TX is wired to RX, rx_ring, rx_dma and get_poll are measured.
+ * @return Bench_ns::status_t
+ */
+status_t bench_run (serial_t *serial_p, uint32_t reportBaud, bool loopback){
+    serial_t *stdoutPrev;
+    serial_ns::stdBuf_t stdBufPrev;
+    uint8_t baudId;
+    uint16_t count;
+
+    if (serial_p == NULL)
+        return failed;
+
+    for (count = 0; count < ring_size; count++)
+        Bench_msg[count] = (count % 64 == 63) ? '\n' : (uint8_t) ('!' + count % 64);
+
+    stdoutPrev = USART_stdTarget_get (USART_stdStream_stdout);
+    stdBufPrev = USART_stdBuffering_get (USART_stdStream_stdout);
+
+    cycles_enable ();
+
+    /* bytes still in the USART would be cut by a new baud rate */
+    serial_p->Flush ();
+    serial_p->Restart (reportBaud);
+    serial_p->Print ((char *) "\nbench,path,baud,size,iterations,cycles_avg,cycles_max,bytes_per_sec\n");
+
+    for (baudId = 0; baudId < numOfBaudRates; baudId++){
+        Bench_numOfResults = 0;
+        if (baudId == 0)
+            Bench_fmt (baudRates[baudId]);
+
+        serial_p->Flush ();
+        serial_p->Restart (baudRates[baudId]);
+        Bench_out (serial_p, baudRates[baudId], loopback);
+
+        serial_p->Flush ();
+        serial_p->Restart (reportBaud);
+        Bench_results_print (serial_p);
+    }
+
+    /* retarget of stdout as before the run */
+    serial_p->Flush ();
+    USART_stdBuffering (USART_stdStream_stdout, stdBufPrev);
+    Bench_stdout_set (stdoutPrev);
+
+    return successful;
+}
+
+/**
+ * @brief bench_spiSwitch, cost of switching SPI between 2 devices, init vs profiles.
+ * @param serial_t *serial_p : for results.
+ * @param SPI *spi_p : SPI under test, free (no device attached).
+ * @param SPI_ns::SM_device_t devA, devB : mapped to decode values.
+ * @param const SPI_ns::SPI_params_t *paramsA, *paramsB
+ * @return Bench_ns::status_t : failed if a device can't be attached.
+ */
+status_t bench_spiSwitch (serial_t *serial_p, SPI *spi_p,
+                          SPI_ns::SM_device_t devA, const SPI_ns::SPI_params_t *paramsA,
+                          SPI_ns::SM_device_t devB, const SPI_ns::SPI_params_t *paramsB){
+    Bench_result_s *result_p;
+    SPI_ns::SPI_params_t params;
+    uint32_t start;
+    uint8_t count;
+
+    if ((serial_p == NULL) || (spi_p == NULL))
+        return failed;
+
+    cycles_enable ();
+    Bench_numOfResults = 0;
+
+    /**< before : init on every switch */
+    result_p = Bench_result_new ("spi_init_switch", 0, 0);
+    for (count = 0; count < iterations; count++){
+        params = (count & 0x01) ? *paramsB : *paramsA;
+        start = cycles_get ();
+        spi_p->init (&params);
+        Bench_result_add (result_p, cycles_get () - start);
+    }
+
+    /**< after : profiles written by attach */
+    spi_p->SM_deviceProfile_set (devA, paramsA);
+    spi_p->SM_deviceProfile_set (devB, paramsB);
+
+    result_p = Bench_result_new ("spi_profile_switch", 0, 0);
+    for (count = 0; count < iterations; count++){
+        SPI_ns::SM_device_t device = (count & 0x01) ? devB : devA;
+
+        start = cycles_get ();
+        if (spi_p->SM_device_attach (device) != SPI_ns::successful)
+            return failed;
+        Bench_result_add (result_p, cycles_get () - start);
+        spi_p->SM_device_release (device);
+    }
+
+    result_p = Bench_result_new ("spi_profile_same", 0, 0);
+    for (count = 0; count < iterations; count++){
+        start = cycles_get ();
+        if (spi_p->SM_device_attach (devA) != SPI_ns::successful)
+            return failed;
+        Bench_result_add (result_p, cycles_get () - start);
+        spi_p->SM_device_release (devA);
+    }
+
+    Bench_results_print (serial_p);
+
+    return successful;
+}
+
+/**
+ * @brief Bench_fmt, number formatting, fmt_* vs the old Print (Bench_oldU32) and snprintf.
+ * @param uint32_t baud : for result lines only.
+ * @return None
+ */
+static void Bench_fmt (uint32_t baud){
+    Bench_result_s *fmtU32_p = Bench_result_new ("fmt_u32", baud, 0);
+    Bench_result_s *fmtHex_p = Bench_result_new ("fmt_hex", baud, 0);
+    Bench_result_s *fmtFixed_p = Bench_result_new ("fmt_fixed", baud, 0);
+    Bench_result_s *oldU32_p = Bench_result_new ("old_u32", baud, 0);
+    Bench_result_s *snU32_p = Bench_result_new ("snprintf_u32", baud, 0);
+    Bench_result_s *snHex_p = Bench_result_new ("snprintf_hex", baud, 0);
+    char buf [Fmt_ns::bufLen_max];
+    uint32_t num = 4000000000UL;
+    uint32_t start;
+    uint8_t count;
+
+    for (count = 0; count < iterations; count++, num -= 123456789){
+        start = cycles_get ();
+        fmt_u32 (buf, num, 0, Fmt_ns::pad_space);
+        Bench_result_add (fmtU32_p, cycles_get () - start);
+
+        start = cycles_get ();
+        fmt_hex (buf, num, 8, Fmt_ns::pad_zero);
+        Bench_result_add (fmtHex_p, cycles_get () - start);
+
+        start = cycles_get ();
+        fmt_fixed (buf, (int32_t) num, 16, 3, 0, Fmt_ns::pad_space);
+        Bench_result_add (fmtFixed_p, cycles_get () - start);
+
+        start = cycles_get ();
+        Bench_oldU32 (buf, num);
+        Bench_result_add (oldU32_p, cycles_get () - start);
+
+        start = cycles_get ();
+        snprintf (buf, sizeof (buf), "%lu", (unsigned long) num);
+        Bench_result_add (snU32_p, cycles_get () - start);
+
+        start = cycles_get ();
+        snprintf (buf, sizeof (buf), "%08lX", (unsigned long) num);
+        Bench_result_add (snHex_p, cycles_get () - start);
+    }
+}
+
+/**
+ * @brief Bench_oldU32, digit loop of serial_t::Print (uint32_t) before MB1_Format (% and / by 10),
+ * kept here as a reference for fmt_u32, digits are written to buf instead of PutByte.
+ * @param char *buf : at least 11 bytes.
+ * @param uint32_t num
+ * @return uint8_t : number of chars.
+ */
+static uint8_t Bench_oldU32 (char *buf, uint32_t num){
+    uint32_t quotient, remainder;
+    int      count; //must int type, uint is incorrect
+    uint8_t  outStr[12];
+    uint8_t  len = 0;
+
+    remainder = num;
+    count     = 0;
+    do{
+        quotient    = remainder % 10;
+        remainder   = remainder / 10;
+        outStr[count++]  = 0x30 | ((uint8_t) quotient);
+    }while (remainder !=0);
+
+    while (count > 0){
+        buf[len++] = (char) outStr[--count];
+    }
+
+    return len;
+}
+
+/**
+ * @brief Bench_out, output paths (and rx_ring) at the current baud rate.
+ * @param serial_t *serial_p
+ * @param uint32_t baud
+ * @param bool loopback
+ * @return None
+ */
+static void Bench_out (serial_t *serial_p, uint32_t baud, bool loopback){
+    Bench_result_s *result_p;
+    uint32_t start, cycles;
+    uint16_t size, got;
+    uint8_t sizeId, count;
+    char saved;
+
+    for (sizeId = 0; sizeId < numOfSizes; sizeId++){
+        size = sizes[sizeId];
+
+        /* polling */
+        result_p = Bench_result_new ("print_poll", baud, size);
+        saved = Bench_msg[size];
+        Bench_msg[size] = '\0';
+        for (count = 0; count < iterations; count++){
+            start = cycles_get ();
+            serial_p->Print ((char *) Bench_msg);
+            Bench_result_add (result_p, cycles_get () - start);
+        }
+        Bench_msg[size] = saved;
+
+        /* TX ring */
+        serial_p->TxBuffer_set (Bench_ring, ring_size, serial_ns::txOverflow_block);
+        result_p = Bench_result_new ("out_ring", baud, size);
+        for (count = 0; count < iterations; count++){
+            start = cycles_get ();
+            serial_p->Out (Bench_msg, size);
+            serial_p->Flush ();
+            Bench_result_add (result_p, cycles_get () - start);
+        }
+        result_p = Bench_result_new ("out_ring_call", baud, size);
+        for (count = 0; count < iterations; count++){
+            start = cycles_get ();
+            serial_p->Out (Bench_msg, size);
+            Bench_result_add (result_p, cycles_get () - start);
+            serial_p->Flush ();
+        }
+        serial_p->TxBuffer_set (NULL, 0, serial_ns::txOverflow_block);
+
+        /* DMA TX */
+        if (serial_p->DmaTx_enable (NULL) == serial_ns::successful){
+            result_p = Bench_result_new ("out_dma", baud, size);
+            for (count = 0; count < iterations; count++){
+                start = cycles_get ();
+                serial_p->OutDMA (Bench_msg, size);
+                while (serial_p->DmaTxPending () != 0) {};
+                Bench_result_add (result_p, cycles_get () - start);
+            }
+            serial_p->DmaTx_disable ();
+        }
+
+        /* _write, worst case of a line-buffered stdout */
+        Bench_stdout_set (serial_p);
+        USART_stdBuffering (USART_stdStream_stdout, serial_ns::stdBuf_line);
+        result_p = Bench_result_new ("write_std", baud, size);
+        for (count = 0; count < iterations; count++){
+            start = cycles_get ();
+            _write (STDOUT_FILENO, (char *) Bench_msg, size);
+            Bench_result_add (result_p, cycles_get () - start);
+        }
+        USART_stdFlush ();
+
+        /* RX ring, loopback only */
+        Bench_rxDrain (serial_p);
+        if (loopback && (serial_p->RxBuffer_set (Bench_ring, ring_size) == serial_ns::successful)){
+            result_p = Bench_result_new ("rx_ring", baud, size);
+            for (count = 0; count < iterations; count++){
+                start = cycles_get ();
+                serial_p->Out (Bench_msg, size);
+                do {
+                    cycles = cycles_get () - start;
+                } while ((serial_p->Available () < size) && (cycles < rxTimeout_cycles));
+                got = serial_p->Read (Bench_rxData, size);
+                if (got == size)
+                    Bench_result_add (result_p, cycles_get () - start);
+            }
+            serial_p->RxBuffer_set (NULL, 0);
+        }
+
+        /* circular DMA RX, loopback only */
+        Bench_rxDrain (serial_p);
+        if (loopback && (serial_p->DmaRx_enable (Bench_ring, ring_size, NULL) == serial_ns::successful)){
+            result_p = Bench_result_new ("rx_dma", baud, size);
+            for (count = 0; count < iterations; count++){
+                start = cycles_get ();
+                serial_p->Out (Bench_msg, size);
+                do {
+                    cycles = cycles_get () - start;
+                } while ((serial_p->Available () < size) && (cycles < rxTimeout_cycles));
+                got = serial_p->Read (Bench_rxData, size);
+                if (got == size)
+                    Bench_result_add (result_p, cycles_get () - start);
+            }
+            serial_p->DmaRx_disable ();
+        }
+
+        /* polling RX (Get), loopback only : a byte is sent, then got */
+        Bench_rxDrain (serial_p);
+        if (loopback){
+            result_p = Bench_result_new ("get_poll", baud, size);
+            for (count = 0; count < iterations; count++){
+                start = cycles_get ();
+                for (got = 0; got < size; got++){
+                    serial_p->Out (Bench_msg[got]);
+                    do {
+                        cycles = cycles_get () - start;
+                    } while ((!serial_p->RxReady ()) && (cycles < rxTimeout_cycles));
+                    if (!serial_p->RxReady ())
+                        break;
+                    Bench_rxData[got] = (uint8_t) serial_p->Get ();
+                }
+                if (got == size)
+                    Bench_result_add (result_p, cycles_get () - start);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Bench_rxDrain, bytes left in the data register by TX paths (loopback) are thrown away.
+ * @param serial_t *serial_p
+ * @return None
+ */
+static void Bench_rxDrain (serial_t *serial_p){
+    while (serial_p->RxReady ())
+        (void) serial_p->Get ();
+}
+
+/**
+ * @brief Bench_streams_get, streams retargeted to a serial_t.
+ * @param serial_t *serial_p
+ * @return uint8_t : USART_stdStream_xxx bits.
+ */
+static uint8_t Bench_streams_get (serial_t *serial_p){
+    uint8_t streams = 0;
+
+    if (USART_stdTarget_get (USART_stdStream_stdout) == serial_p)
+        streams |= USART_stdStream_stdout;
+    if (USART_stdTarget_get (USART_stdStream_stdin) == serial_p)
+        streams |= USART_stdStream_stdin;
+    if (USART_stdTarget_get (USART_stdStream_stderr) == serial_p)
+        streams |= USART_stdStream_stderr;
+
+    return streams;
+}
+
+/**
+ * @brief Bench_stdout_set, retarget stdout only, stdin and stderr are kept.
+ * @param serial_t *serial_p : NULL, stdout isn't retargeted.
+ * @return None
+ */
+static void Bench_stdout_set (serial_t *serial_p){
+    serial_t *current = USART_stdTarget_get (USART_stdStream_stdout);
+
+    if (serial_p == current)
+        return;
+
+    if (serial_p != NULL)
+        serial_p->Retarget (Bench_streams_get (serial_p) | USART_stdStream_stdout);
+    else
+        current->Retarget (Bench_streams_get (current) & ~USART_stdStream_stdout);
+}
+
+/**
+ * @brief Bench_result_new, take a new result line.
+ * @param const char *path
+ * @param uint32_t baud
+ * @param uint16_t size
+ * @return Bench_result_s * : last line is reused when all lines are taken.
+ */
+static Bench_result_s *Bench_result_new (const char *path, uint32_t baud, uint16_t size){
+    Bench_result_s *result_p;
+
+    if (Bench_numOfResults < Bench_results_max)
+        Bench_numOfResults++;
+    result_p = &Bench_results[Bench_numOfResults - 1];
+
+    result_p->path = path;
+    result_p->baud = baud;
+    result_p->size = size;
+    result_p->iterations = 0;
+    result_p->cyclesSum = 0;
+    result_p->cyclesMax = 0;
+
+    return result_p;
+}
+
+/**
+ * @brief Bench_result_add, add one measurement.
+ * @param Bench_result_s *result_p
+ * @param uint32_t cycles
+ * @return None
+ */
+static void Bench_result_add (Bench_result_s *result_p, uint32_t cycles){
+    result_p->iterations++;
+    result_p->cyclesSum += cycles;
+    if (cycles > result_p->cyclesMax)
+        result_p->cyclesMax = cycles;
+}
+
+/**
+ * @brief Bench_results_print, print result lines as CSV.
+ * @param serial_t *serial_p
+ * @return None
+ */
+static void Bench_results_print (serial_t *serial_p){
+    Bench_result_s *result_p;
+    uint32_t cyclesAvg, bytesPerSec;
+    uint8_t count;
+
+    /* the host drops what came before : bytes at another baud rate */
+    serial_p->Print ('\n');
+
+    for (count = 0; count < Bench_numOfResults; count++){
+        result_p = &Bench_results[count];
+        if (result_p->iterations == 0)
+            continue;
+
+        cyclesAvg = result_p->cyclesSum / result_p->iterations;
+        bytesPerSec = (cyclesAvg == 0) ? 0 :
+                (uint32_t) ((uint64_t) result_p->size * SystemCoreClock / cyclesAvg);
+
+        serial_p->Print ((char *) "bench,");
+        serial_p->Print ((char *) result_p->path);
+        serial_p->Print (',');
+        serial_p->Print (result_p->baud);
+        serial_p->Print (',');
+        serial_p->Print ((uint32_t) result_p->size);
+        serial_p->Print (',');
+        serial_p->Print ((uint32_t) result_p->iterations);
+        serial_p->Print (',');
+        serial_p->Print (cyclesAvg);
+        serial_p->Print (',');
+        serial_p->Print (result_p->cyclesMax);
+        serial_p->Print (',');
+        serial_p->Print (bytesPerSec);
+        serial_p->Print ('\n');
+    }
+}
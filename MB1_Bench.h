@@ -0,0 +1,64 @@
+/**
+ * @file MB1_Bench.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for on-target benchmarks of serial_t (DWT cycle counter).
+ * Each output path is measured at every baud rate of Bench_ns::baudRates and every size of
+ * Bench_ns::sizes, input paths (RX ring, DMA RX, Get) need TX wired to RX (loopback).
+ * Number formatting (fmt_* of MB1_Format.h vs the old digit loop of Print and snprintf) is measured
+ * once, at size 0 of baud 0.
+ * Results are printed as CSV lines at reportBaud on the same serial_t, host tools keep lines
+ * starting with "bench," (bytes sent at other baud rates are garbage for the host) :
+ *      bench,path,baud,size,iterations,cycles_avg,cycles_max,bytes_per_sec
+ * cycles_avg, cycles_max : per call of the path, bytes_per_sec : size * SystemCoreClock / cycles_avg.
+ * Paths : print_poll (Print, polling), out_ring (Out to TX ring, then Flush),
+ * out_ring_call (Out to TX ring, CPU time only), out_dma (OutDMA until sent),
+ * write_std (_write, stdout line-buffered), rx_ring (loopback, Out then Read from the RXNE ring),
+ * rx_dma (loopback, Out then Read from circular DMA RX), get_poll (loopback, Out then Get, per byte),
+ * fmt_u32, fmt_hex, fmt_fixed, old_u32 (Print (uint32_t) before MB1_Format), snprintf_u32, snprintf_hex.
+ * SPI device switch (bench_spiSwitch, baud and size are 0) : spi_init_switch (init with params of
+ * the other device, as before profiles), spi_profile_switch (attach of the other device, profile
+ * written), spi_profile_same (attach of the same device, profile skipped).
+ * How to use this lib:
+ * - bench_run (&MB1_USART2, 115200, false); TX ring, DMA TX/RX and retarget of serial_t are
+ *   changed during the run, serial_t is left in polling mode at reportBaud, stdout has its retarget
+ *   and buffering of before the run. serial_t is flushed before each baud rate change.
+ * - Linux variant on the USART model of MB1_Host.h : host/mb1_bench.cpp (cycles are simulated,
+ *   CPU-only paths read close to 0).
+ * - bench_spiSwitch (&MB1_USART2, &MB1_SPI1, devA, &paramsA, devB, &paramsB); both devices
+ *   must be mapped to decode values, results are printed at the current baud rate.
+ */
+
+#ifndef __MB1_BENCH_H
+#define __MB1_BENCH_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_Serial_t.h"
+#include "MB1_SPI.h"
+
+namespace Bench_ns {
+
+/**< config (compile-time) */
+const uint8_t numOfBaudRates = 4;
+const uint32_t baudRates [numOfBaudRates] = {115200, 460800, 921600, 2000000};
+const uint8_t numOfSizes = 4;
+const uint16_t sizes [numOfSizes] = {1, 16, 64, 256};
+const uint8_t iterations = 8;
+const uint16_t ring_size = 512;             // > max size, so out_ring_call never blocks
+const uint32_t rxTimeout_cycles = 72000000; // ~1 s at 72 MHz
+
+typedef enum {
+    successful,
+    failed
+} status_t;
+
+}
+
+Bench_ns::status_t bench_run (serial_t *serial_p, uint32_t reportBaud, bool loopback);
+Bench_ns::status_t bench_spiSwitch (serial_t *serial_p, SPI *spi_p,
+                                    SPI_ns::SM_device_t devA, const SPI_ns::SPI_params_t *paramsA,
+                                    SPI_ns::SM_device_t devB, const SPI_ns::SPI_params_t *paramsB);
+
+#endif // __MB1_BENCH_H
@@ -0,0 +1,466 @@
+/**
+ * @file MB1_CC2530.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for CC2530 radio (network processor over SPI) on MBoard-1.
+ */
+
+/* Includes */
+#include "MB1_CC2530.h"
+#include "string.h"
+using namespace CC2530_ns;
+
+/**< sys_conf */
+const uint8_t CC2530_EXTI_preemptionPriority = 0x01; // same as DMA IRQs, they don't preempt each other
+const uint8_t CC2530_EXTI_subPriority = 0x01;
+/**< end sys_conf */
+
+/**< poll : header of an empty frame, then 3 dummy bytes to clock the answer */
+static const uint8_t CC2530_pollTx [poll_size] = {0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF};
+
+/**< CC2530s which have begun, for cc2530_miscTIMISR and CC2530_EXTI_dispatch */
+static CC2530 *_cc2530Objs [objs_max] = {NULL};
+
+/**<----------------------------- class CC2530 ------------------------------------*/
+
+/**
+ * @brief CC2530.
+ * @param SPI *spi_p : SPI of the radio.
+ * @param SPI_ns::SM_device_t device : cc2530_1.
+ */
+CC2530::CC2530 (SPI *spi_p, SPI_ns::SM_device_t device){
+    this->spi_p = spi_p;
+    this->device = device;
+    rx_p = NULL;
+    rxArg = NULL;
+    EXTILine = 0;
+
+    state = st_idle;
+    rxPending = false;
+    readyTimer = 0;
+    idleTimer = 0;
+
+    txLen = 0;
+    txFrames = 0;
+    batchLen = 0;
+    batchFrames = 0;
+
+    stats_reset ();
+}
+
+/**
+ * @brief begin, register for misc timer and EXTI ISRs, set EXTI on MISO (masked until a window waits).
+ * @param CC2530_ns::rx_t rx_p : received frames, can be NULL.
+ * @param void *rxArg : passed to rx_p.
+ * @return CC2530_ns::status_t : failed if too many CC2530s.
+ */
+status_t CC2530::begin (rx_t rx_p, void *rxArg){
+    EXTI_InitTypeDef EXTI_InitStruct;
+    NVIC_InitTypeDef nvicStruct;
+    uint8_t portSource, pinSource;
+    uint8_t count;
+
+    for (count = 0; count < objs_max; count++){
+        if (_cc2530Objs[count] == this)
+            break;
+        if (_cc2530Objs[count] == NULL){
+            _cc2530Objs[count] = this;
+            break;
+        }
+    }
+    if (count == objs_max)
+        return failed;
+
+    this->rx_p = rx_p;
+    this->rxArg = rxArg;
+
+    /**< EXTI on falling edge of MISO */
+    spi_p->misc_MISO_EXTISource_get (&portSource, &pinSource);
+    EXTILine = (uint32_t) 0x01 << pinSource;
+
+    RCC_APB2PeriphClockCmd (RCC_APB2Periph_AFIO, ENABLE);
+    GPIO_EXTILineConfig (portSource, pinSource);
+
+    EXTI_InitStruct.EXTI_Line = EXTILine;
+    EXTI_InitStruct.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStruct.EXTI_Trigger = EXTI_Trigger_Falling;
+    EXTI_InitStruct.EXTI_LineCmd = ENABLE;
+    EXTI_Init (&EXTI_InitStruct);
+    EXTI_enable (false);
+
+    if (pinSource < 5)
+        nvicStruct.NVIC_IRQChannel = EXTI0_IRQn + pinSource;
+    else if (pinSource < 10)
+        nvicStruct.NVIC_IRQChannel = EXTI9_5_IRQn;
+    else
+        nvicStruct.NVIC_IRQChannel = EXTI15_10_IRQn;
+    nvicStruct.NVIC_IRQChannelCmd = ENABLE;
+    nvicStruct.NVIC_IRQChannelPreemptionPriority = CC2530_EXTI_preemptionPriority;
+    nvicStruct.NVIC_IRQChannelSubPriority = CC2530_EXTI_subPriority;
+    NVIC_Init (&nvicStruct);
+
+    return successful;
+}
+
+/**
+ * @brief frame_send, queue a frame, it's sent in the next CS window with other queued frames.
+ * @param uint8_t cmd0
+ * @param uint8_t cmd1
+ * @param const uint8_t *data : copied, can be NULL if len = 0.
+ * @param uint8_t len : <= dataLen_max.
+ * @return CC2530_ns::status_t : busy if there is no room in TX buffer.
+ * @attention : can be called from tasks or ISRs (also from rx_p).
+ */
+status_t CC2530::frame_send (uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len){
+    uint32_t primask;
+    uint8_t *frame_p;
+
+    if ((len > dataLen_max) || ((data == NULL) && (len != 0)) || ((len == 0) && (cmd0 == 0) && (cmd1 == 0)))
+        return failed; // an empty 0/0 frame is a poll
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (txLen + header_size + len > txBuf_size){
+        __set_PRIMASK(primask);
+        return busy;
+    }
+
+    /* frames after txBuf[batchLen] are not touched by a running DMA */
+    frame_p = &txBuf[txLen];
+    frame_p[0] = len;
+    frame_p[1] = cmd0;
+    frame_p[2] = cmd1;
+    if (len != 0)
+        memcpy (&frame_p[header_size], data, len);
+    txLen += header_size + len;
+    txFrames++;
+
+    service ();
+
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+ * @brief tx_free
+ * @return uint16_t : free bytes in TX buffer (a frame takes header_size + len).
+ */
+uint16_t CC2530::tx_free (void){
+    return txBuf_size - txLen;
+}
+
+/**
+ * @brief rx_check, open a window to poll the radio (e.g. radio interrupt wired to another pin).
+ * @return None
+ */
+void CC2530::rx_check (void){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    rxPending = true;
+    service ();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief isIdle
+ * @return bool : true if no window is open and no frame is waiting.
+ */
+bool CC2530::isIdle (void){
+    return ((state == st_idle) && (txLen == 0));
+}
+
+/**
+ * @brief stats_get
+ * @param CC2530_ns::stats_t *stats_p
+ * @return None
+ */
+void CC2530::stats_get (stats_t *stats_p){
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void CC2530::stats_reset (void){
+    memset (&stats, 0, sizeof (stats));
+}
+
+/**
+ * @brief tick, ready timeout, idle poll, retry when SPI was busy (miscTIM ISR context).
+ * @return None
+ */
+void CC2530::tick (void){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* timers are in ms, a tick is miscTIM_period ms */
+    if (state == st_waitReady){
+        if (readyTimer <= miscTIM_period){
+            stats.readyTimeouts++;
+            window_abort ();
+        }
+        else
+            readyTimer -= miscTIM_period;
+    }
+
+    if (idlePoll_ms != 0){
+        idleTimer += miscTIM_period;
+        if (idleTimer >= idlePoll_ms){
+            idleTimer = 0;
+            rxPending = true;
+        }
+    }
+
+    service ();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ready_ISR, SO has gone low (EXTI ISR context).
+ * @return None
+ */
+void CC2530::ready_ISR (void){
+    uint32_t primask;
+
+    if ((EXTILine == 0) || ((EXTI->PR & EXTILine) == 0) || ((EXTI->IMR & EXTILine) == 0))
+        return;
+    EXTI->PR = EXTILine;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ready ();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief service, open a window if there are frames to send or the radio must be polled.
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+void CC2530::service (void){
+    SPI_ns::status_t retval;
+
+    if ((state != st_idle) || ((txLen == 0) && !rxPending))
+        return;
+
+    /* attached by hand, the SPI queue waits for the end of the window */
+    retval = spi_p->SM_device_attach (device);
+    if (retval != SPI_ns::successful){
+        stats.busRetries++;
+        return; // next tick
+    }
+
+    rxPending = false;
+    idleTimer = 0;
+    readyTimer = readyTimeout_ms;
+    state = st_waitReady;
+    stats.windows++;
+
+    spi_p->SM_device_select (device);
+    EXTI_enable (true);
+
+    /* SO may be low already, no edge then */
+    if (spi_p->misc_MISO_read () == 0)
+        ready ();
+}
+
+/**
+ * @brief ready, radio is ready, send queued frames (or poll at once).
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+void CC2530::ready (void){
+    if (state != st_waitReady)
+        return;
+
+    EXTI_enable (false); // MISO toggles during transfers
+
+    if (txLen == 0){
+        poll_start ();
+        return;
+    }
+
+    batchLen = txLen;
+    batchFrames = txFrames;
+    state = st_tx;
+    if (spi_p->transfer (device, txBuf, NULL, batchLen, txDone, this) != SPI_ns::successful)
+        window_abort ();
+}
+
+/**
+ * @brief poll_start, ask the radio for its next frame.
+ * @return None
+ */
+void CC2530::poll_start (void){
+    state = st_poll;
+    if (spi_p->transfer (device, CC2530_pollTx, pollRx, poll_size, pollDone, this) != SPI_ns::successful)
+        window_abort ();
+}
+
+/**
+ * @brief window_end, CS high, give SPI back, next window if needed.
+ * @return None
+ */
+void CC2530::window_end (void){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    spi_p->SM_device_release (device); // deselects, restarts SPI queue
+    state = st_idle;
+    service ();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief window_abort, ready timeout or SPI/DMA error, frames are kept, radio is polled again.
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+void CC2530::window_abort (void){
+    EXTI_enable (false);
+    spi_p->SM_device_release (device);
+    state = st_idle;
+    rxPending = true; // next tick
+}
+
+/**
+ * @brief EXTI_enable, unmask/mask EXTI of MISO, old edges are dropped.
+ * @return None
+ */
+void CC2530::EXTI_enable (bool isEnabled){
+    EXTI->PR = EXTILine;
+    if (isEnabled)
+        EXTI->IMR |= EXTILine;
+    else
+        EXTI->IMR &= ~EXTILine;
+}
+
+/**
+ * @brief txDone, queued frames have been sent (DMA ISR context).
+ * @return None
+ */
+void CC2530::txDone (void *arg, SPI_ns::status_t status){
+    CC2530 *cc2530_p = (CC2530 *) arg;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (status != SPI_ns::successful){
+        cc2530_p->window_abort ();
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    /* frames queued meanwhile go down to the start */
+    memmove (cc2530_p->txBuf, &cc2530_p->txBuf[cc2530_p->batchLen], cc2530_p->txLen - cc2530_p->batchLen);
+    cc2530_p->txLen -= cc2530_p->batchLen;
+    cc2530_p->txFrames -= cc2530_p->batchFrames;
+
+    cc2530_p->stats.framesSent += cc2530_p->batchFrames;
+    cc2530_p->stats.bytesSent += cc2530_p->batchLen;
+    if (cc2530_p->batchFrames > cc2530_p->stats.framesPerWindow_max)
+        cc2530_p->stats.framesPerWindow_max = cc2530_p->batchFrames;
+    cc2530_p->batchLen = 0;
+    cc2530_p->batchFrames = 0;
+
+    cc2530_p->poll_start ();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief pollDone, header of the next frame of the radio has been read (DMA ISR context).
+ * @return None
+ */
+void CC2530::pollDone (void *arg, SPI_ns::status_t status){
+    CC2530 *cc2530_p = (CC2530 *) arg;
+    uint8_t len = cc2530_p->pollRx[header_size];
+
+    if (status != SPI_ns::successful){
+        cc2530_p->window_abort ();
+        return;
+    }
+
+    if (len == 0){
+        cc2530_p->window_end ();
+        return;
+    }
+
+    if (len > dataLen_max){
+        cc2530_p->stats.rxDropped++;
+        cc2530_p->window_end (); // radio keeps it, drops it when CS goes high
+        return;
+    }
+
+    cc2530_p->state = st_rx;
+    if (cc2530_p->spi_p->transfer (cc2530_p->device, NULL, cc2530_p->rxData, len, rxDone, cc2530_p) != SPI_ns::successful)
+        cc2530_p->window_abort ();
+}
+
+/**
+ * @brief rxDone, data of a received frame (DMA ISR context).
+ * @return None
+ */
+void CC2530::rxDone (void *arg, SPI_ns::status_t status){
+    CC2530 *cc2530_p = (CC2530 *) arg;
+    uint8_t len = cc2530_p->pollRx[header_size];
+
+    if (status != SPI_ns::successful){
+        cc2530_p->window_abort ();
+        return;
+    }
+
+    cc2530_p->stats.framesReceived++;
+    cc2530_p->stats.bytesReceived += header_size + len;
+
+    if (cc2530_p->rx_p != NULL)
+        cc2530_p->rx_p (cc2530_p->rxArg, cc2530_p->pollRx[header_size + 1], cc2530_p->pollRx[header_size + 2],
+                        cc2530_p->rxData, len);
+
+    cc2530_p->rxPending = true; // radio may have more
+    cc2530_p->window_end ();
+}
+
+/**<----------------------------- ISRs ------------------------------------*/
+
+/**
+ * @brief cc2530_miscTIMISR, ticks of all CC2530s which have begun.
+ * @return None
+ */
+void cc2530_miscTIMISR (void){
+    uint8_t count;
+
+    for (count = 0; count < objs_max; count++){
+        if (_cc2530Objs[count] != NULL)
+            _cc2530Objs[count]->tick ();
+    }
+}
+
+/**
+ * @brief CC2530_EXTI_dispatch, each CC2530 checks and clears its own line, other pending lines are
+ * left to the caller (EXTIx_IRQHandler of the application).
+ * @return None
+ */
+void CC2530_EXTI_dispatch (void){
+    uint8_t count;
+
+    for (count = 0; count < objs_max; count++){
+        if (_cc2530Objs[count] != NULL)
+            _cc2530Objs[count]->ready_ISR ();
+    }
+}
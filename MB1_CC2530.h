@@ -0,0 +1,139 @@
+/**
+ * @file MB1_CC2530.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for CC2530 radio (network processor over SPI) on MBoard-1.
+ * Radio is ready when it pulls SO (MISO) low after CS goes low. Instead of polling misc_MISO_read,
+ * the driver arms an EXTI (falling edge) on MISO while it waits, the CPU is free meanwhile.
+ * Frames : | len (1) | cmd0 (1) | cmd1 (1) | data (len) |, len <= dataLen_max.
+ * One CS window :
+ *      CS low, wait SO low (EXTI, readyTimeout_ms),
+ *      all queued frames, back to back (one DMA transfer),
+ *      poll : | 0 | 0 | 0 | then 3 dummy bytes, radio answers the header of its next frame (len = 0 : nothing),
+ *      data of the received frame (if any), CS high.
+ * After a received frame, a new window polls again until the radio has nothing left.
+ * Windows are also opened every idlePoll_ms (or by rx_check) to get frames from the radio.
+ * How to use this lib:
+ * - SPI has been init-ed and cc2530_1 is mapped to a decode value (SM_deviceToDecoder_set).
+ * - cc2530_miscTIMISR is assigned to miscTIM : set MB1_conf_cc2530Tick_isUsed in MB1_System.cpp (off
+ *   by default, miscTIM has numOfSubISR_max sub-ISRs), or subISR_assign it in the application.
+ * - Declare a CC2530 (&MB1_SPI1, SPI_ns::cc2530_1), begin (rx_p, arg), then frame_send.
+ * - rx_p is called in DMA ISR context while CS is still low, keep it short (frame_send is allowed).
+ * - The driver uses EXTI line and IRQ of MISO pin (EXTI6 for SPI1, EXTI14 for SPI2). The library
+ *   doesn't define EXTI IRQ handlers : EXTI9_5_IRQHandler (PA6, SPI1), EXTI4_IRQHandler (PB4, SPI1
+ *   remapped) or EXTI15_10_IRQHandler (PB14, SPI2) of the application calls CC2530_EXTI_dispatch,
+ *   and clears its other lines itself, like serial_t::IRQ_handler.
+ * - MB1_CC2530Model.h is a host model of the radio, host/mb1_cc2530check.cpp checks the driver with it.
+ */
+
+#ifndef __MB1_CC2530_H
+#define __MB1_CC2530_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_SPI.h"
+
+namespace CC2530_ns {
+
+/**< config (compile-time) */
+const uint8_t dataLen_max = 64;
+const uint16_t txBuf_size = 256;        // queued frames (with headers)
+const uint8_t objs_max = 2;
+const uint16_t readyTimeout_ms = 10;
+const uint16_t idlePoll_ms = 50;        // 0 : no idle poll
+
+/**< wire format */
+const uint8_t header_size = 3;
+const uint8_t poll_size = 2 * header_size;
+
+typedef enum {
+    successful,
+    failed,
+    busy
+} status_t;
+
+typedef enum {
+    st_idle,
+    st_waitReady,
+    st_tx,
+    st_poll,
+    st_rx
+} state_t;
+
+/**< received frame, DMA ISR context */
+typedef void (* rx_t) (void *arg, uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len);
+
+typedef struct {
+    uint32_t windows;
+    uint32_t framesSent;
+    uint32_t framesReceived;
+    uint32_t bytesSent;
+    uint32_t bytesReceived;
+    uint32_t readyTimeouts;
+    uint32_t busRetries;                // SPI was used by another device or DMA by another driver
+    uint32_t rxDropped;                 // len > dataLen_max
+    uint8_t framesPerWindow_max;
+} stats_t;
+
+}
+
+class CC2530 {
+public:
+    CC2530 (SPI *spi_p, SPI_ns::SM_device_t device);
+    CC2530_ns::status_t begin (CC2530_ns::rx_t rx_p, void *rxArg);
+
+    CC2530_ns::status_t frame_send (uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len);
+    uint16_t tx_free (void);
+    void rx_check (void);
+    bool isIdle (void);
+
+    void stats_get (CC2530_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+    /**< called by cc2530_miscTIMISR and CC2530_EXTI_dispatch */
+    void tick (void);
+    void ready_ISR (void);
+
+private:
+    SPI *spi_p;
+    SPI_ns::SM_device_t device;
+    CC2530_ns::rx_t rx_p;
+    void *rxArg;
+    uint32_t EXTILine;
+
+    volatile CC2530_ns::state_t state;
+    volatile bool rxPending;            // a window is needed to poll the radio
+    uint16_t readyTimer;                // ms left before ready timeout
+    uint16_t idleTimer;                 // ms since the last window
+
+    uint8_t txBuf [CC2530_ns::txBuf_size];
+    volatile uint16_t txLen;
+    volatile uint8_t txFrames;
+    uint16_t batchLen;
+    uint8_t batchFrames;
+
+    uint8_t pollRx [CC2530_ns::poll_size];
+    uint8_t rxData [CC2530_ns::dataLen_max];
+
+    CC2530_ns::stats_t stats;
+
+    void service (void);
+    void ready (void);
+    void poll_start (void);
+    void window_end (void);
+    void window_abort (void);
+    void EXTI_enable (bool isEnabled);
+
+    static void txDone (void *arg, SPI_ns::status_t status);
+    static void pollDone (void *arg, SPI_ns::status_t status);
+    static void rxDone (void *arg, SPI_ns::status_t status);
+};
+
+/**< misc timer ISR for CC2530s */
+void cc2530_miscTIMISR (void);
+
+/**< EXTI of MISO lines, to be called from EXTIx_IRQHandler of the application */
+void CC2530_EXTI_dispatch (void);
+
+#endif // __MB1_CC2530_H
@@ -0,0 +1,239 @@
+/**
+ * @file MB1_CC2530Model.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for a host model of CC2530 radio on SPI.
+ */
+
+/* Includes */
+#include "MB1_CC2530Model.h"
+using namespace CC2530Model_ns;
+
+/**<----------------------------- class CC2530Model ------------------------------------*/
+
+/**
+ * @brief CC2530Model
+ * @param uint32_t wakeup_us : time from CS low to SO low.
+ */
+CC2530Model::CC2530Model (uint32_t wakeup_us){
+    this->wakeup_us = wakeup_us;
+    wakeupLeft_us = 0;
+    csLow = false;
+
+    inCount = 0;
+    framesThisWindow = 0;
+    isOut = false;
+    outCount = 0;
+    outHasFrame = false;
+
+    rxHead = 0;
+    rxCount = 0;
+    txHead = 0;
+    txCount = 0;
+
+    stats_reset ();
+}
+
+/**
+ * @brief cs_set, a window starts on CS low, partial frames are dropped on CS high.
+ * @param bool isLow
+ * @return None
+ */
+void CC2530Model::cs_set (bool isLow){
+    if (isLow == csLow)
+        return;
+
+    csLow = isLow;
+    if (isLow){
+        wakeupLeft_us = wakeup_us;
+        inCount = 0;
+        isOut = false;
+        framesThisWindow = 0;
+        stats.windows++;
+        return;
+    }
+
+    if ((inCount != 0) || (isOut && outHasFrame))
+        stats.errors++;
+    inCount = 0;
+    isOut = false;
+    outHasFrame = false;
+    if (framesThisWindow > stats.maxFramesPerWindow)
+        stats.maxFramesPerWindow = framesThisWindow;
+}
+
+/**
+ * @brief so_get, SO level between transfers.
+ * @return bool : false (low) when CS is low and the radio is ready.
+ */
+bool CC2530Model::so_get (void){
+    return !(csLow && (wakeupLeft_us == 0));
+}
+
+/**
+ * @brief transfer, one byte in full duplex.
+ * @param uint8_t mosi
+ * @return uint8_t : miso
+ */
+uint8_t CC2530Model::transfer (uint8_t mosi){
+    if (!csLow)
+        return 0xFF;
+
+    if (wakeupLeft_us != 0){
+        stats.notReady++;
+        return 0xFF;
+    }
+
+    if (isOut)
+        return out_byte ();
+
+    in_byte (mosi);
+    return 0x00;
+}
+
+/**
+ * @brief tick_us, time goes on for wake-up.
+ * @param uint32_t us
+ * @return None
+ */
+void CC2530Model::tick_us (uint32_t us){
+    wakeupLeft_us = (us >= wakeupLeft_us) ? 0 : wakeupLeft_us - us;
+}
+
+/**
+ * @brief rx_push, a frame for the host (received over the air).
+ * @return bool : false if list is full or frame is too long.
+ */
+bool CC2530Model::rx_push (uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len){
+    frame_s *frame_p;
+
+    if ((rxCount >= frames_max) || (len > dataLen_max) || (len == 0))
+        return false; // len = 0 is "nothing" in an answer to a poll
+
+    frame_p = &rxFrames[(rxHead + rxCount) % frames_max];
+    frame_p->len = len;
+    frame_p->cmd0 = cmd0;
+    frame_p->cmd1 = cmd1;
+    memcpy (frame_p->data, data, len);
+    rxCount++;
+
+    return true;
+}
+
+/**
+ * @brief rx_pending
+ * @return uint8_t : frames not yet read by the host.
+ */
+uint8_t CC2530Model::rx_pending (void){
+    return rxCount;
+}
+
+/**
+ * @brief tx_pop, oldest frame sent by the host.
+ * @return bool : false if there is none.
+ */
+bool CC2530Model::tx_pop (frame_s *frame_p){
+    if (txCount == 0)
+        return false;
+
+    *frame_p = txFrames[txHead];
+    txHead = (txHead + 1) % frames_max;
+    txCount--;
+
+    return true;
+}
+
+/**
+ * @brief stats_get
+ * @return None
+ */
+void CC2530Model::stats_get (stats_t *stats_p){
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void CC2530Model::stats_reset (void){
+    memset (&stats, 0, sizeof (stats));
+}
+
+/**
+ * @brief out_byte, answer to a poll : header of next frame (or zeros), then its data.
+ * @return uint8_t : miso
+ */
+uint8_t CC2530Model::out_byte (void){
+    const frame_s *frame_p = &rxFrames[rxHead];
+    uint8_t miso;
+
+    if (!outHasFrame){
+        miso = 0x00;
+        if (++outCount == header_size)
+            isOut = false;
+        return miso;
+    }
+
+    if (outCount == 0)
+        miso = frame_p->len;
+    else if (outCount == 1)
+        miso = frame_p->cmd0;
+    else if (outCount == 2)
+        miso = frame_p->cmd1;
+    else
+        miso = frame_p->data[outCount - header_size];
+
+    if (++outCount == header_size + frame_p->len){
+        rxHead = (rxHead + 1) % frames_max;
+        rxCount--;
+        stats.framesOut++;
+        isOut = false;
+        outHasFrame = false;
+    }
+
+    return miso;
+}
+
+/**
+ * @brief in_byte, frames from the host, an empty 0/0 frame is a poll.
+ * @return None
+ */
+void CC2530Model::in_byte (uint8_t mosi){
+    if (inCount == 0)
+        inFrame.len = mosi;
+    else if (inCount == 1)
+        inFrame.cmd0 = mosi;
+    else if (inCount == 2)
+        inFrame.cmd1 = mosi;
+    else
+        inFrame.data[inCount - header_size] = mosi;
+    inCount++;
+
+    if ((inCount == 1) && (inFrame.len > dataLen_max)){
+        stats.errors++;
+        inCount = 0;
+        return;
+    }
+
+    if (inCount < header_size + inFrame.len)
+        return;
+    inCount = 0;
+
+    if ((inFrame.len == 0) && (inFrame.cmd0 == 0) && (inFrame.cmd1 == 0)){
+        stats.polls++;
+        isOut = true;
+        outCount = 0;
+        outHasFrame = (rxCount != 0);
+        return;
+    }
+
+    if (txCount >= frames_max){
+        stats.errors++;
+        return;
+    }
+    txFrames[(txHead + txCount) % frames_max] = inFrame;
+    txCount++;
+    stats.framesIn++;
+    framesThisWindow++;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file MB1_CC2530Model.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for a host model of CC2530 radio on SPI (protocol of MB1_CC2530.h).
+ * The model works at byte level, like the radio on the bus : CS low, SO goes low when ready
+ * (after wakeup_us), bytes in/out, CS high.
+ * - Frames from the host are parsed back to back and kept in a TX list (tx_pop).
+ * - Frames "received over the air" are pushed by the test (rx_push), they are answered to polls,
+ *   a frame is removed only when it has been clocked out completely.
+ * - A partial frame when CS goes high is counted as an error and dropped.
+ * This file only depends on stdint.h and string.h, host/mb1_cc2530check.cpp runs it with MB1_CC2530
+ * on the host model of SPI, DMA and EXTI (MB1_Host.h).
+ * How to use this lib:
+ * - Declare a CC2530Model, rx_push frames the driver should receive.
+ * - cs_set (true), wait so_get () == false (tick_us), transfer each byte, cs_set (false).
+ * - tx_pop frames the driver has sent, stats_get for counters.
+ */
+
+#ifndef __MB1_CC2530MODEL_H
+#define __MB1_CC2530MODEL_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "string.h"
+
+namespace CC2530Model_ns {
+
+/**< config (compile-time) */
+const uint8_t dataLen_max = 64;         // same as CC2530_ns::dataLen_max
+const uint8_t frames_max = 8;           // per direction
+const uint8_t header_size = 3;
+
+typedef struct {
+    uint8_t len;
+    uint8_t cmd0;
+    uint8_t cmd1;
+    uint8_t data [dataLen_max];
+} frame_s;
+
+typedef struct {
+    uint32_t windows;
+    uint32_t framesIn;                  // from host
+    uint32_t framesOut;                 // to host
+    uint32_t polls;
+    uint32_t maxFramesPerWindow;
+    uint32_t notReady;                  // bytes clocked before SO went low
+    uint32_t errors;                    // partial frames, frames too long, TX list full
+} stats_t;
+
+}
+
+class CC2530Model {
+public:
+    CC2530Model (uint32_t wakeup_us);
+    void cs_set (bool isLow);
+    bool so_get (void);
+    uint8_t transfer (uint8_t mosi);
+    void tick_us (uint32_t us);
+
+    bool rx_push (uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len);
+    uint8_t rx_pending (void);
+    bool tx_pop (CC2530Model_ns::frame_s *frame_p);
+
+    void stats_get (CC2530Model_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+private:
+    uint32_t wakeup_us;
+    uint32_t wakeupLeft_us;
+    bool csLow;
+
+    /* parser of host bytes */
+    CC2530Model_ns::frame_s inFrame;
+    uint8_t inCount;                    // bytes of inFrame received
+    uint32_t framesThisWindow;
+
+    /* answer to a poll */
+    bool isOut;
+    uint8_t outCount;                   // bytes of answer sent
+    bool outHasFrame;
+
+    CC2530Model_ns::frame_s rxFrames [CC2530Model_ns::frames_max];   // to host
+    uint8_t rxHead, rxCount;
+    CC2530Model_ns::frame_s txFrames [CC2530Model_ns::frames_max];   // from host
+    uint8_t txHead, txCount;
+
+    CC2530Model_ns::stats_t stats;
+
+    uint8_t out_byte (void);
+    void in_byte (uint8_t mosi);
+};
+
+#endif // __MB1_CC2530MODEL_H
@@ -0,0 +1,611 @@
+/**
+ * @file MB1_Cache.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is source file for the write-back block cache over an AT25 flash.
+ */
+
+/* Includes */
+#include "MB1_Cache.h"
+#include "string.h"
+using namespace Cache_ns;
+
+/**
+ * @brief BlockCache
+ * @param AT25 *at25_p : has begun.
+ * @param Cache_ns::line_s *lines, uint8_t numOfLines : cache lines (numOfLines > 0), owned by the caller.
+ * @param uint8_t *sectorBuf : sector_size bytes for write-backs which need an erase, NULL : these write-backs fail.
+ */
+BlockCache::BlockCache (AT25 *at25_p, line_s *lines, uint8_t numOfLines, uint8_t *sectorBuf){
+    uint8_t count;
+
+    this->at25_p = at25_p;
+    this->lines = lines;
+    this->numOfLines = numOfLines;
+    this->sectorBuf = sectorBuf;
+
+    for (count = 0; count < numOfLines; count++){
+        lines[count].page = page_none;
+        lines[count].lastUse = 0;
+        lines[count].state = line_invalid;
+        lines[count].isAhead = false;
+    }
+
+    useCount = 0;
+    readAhead = 0;
+    lastPage = page_none;
+    aheadNumOfLines = 0;
+    aheadDone = 0;
+    aheadFinished = 0;
+
+    stats_reset ();
+}
+
+/**
+ * @brief readAhead_set, number of pages read ahead of sequential reads.
+ * @param uint8_t numOfLines : 0 to disable, <= readAhead_max and < number of lines.
+ * @return None
+ */
+void BlockCache::readAhead_set (uint8_t numOfLines){
+    if (numOfLines > readAhead_max)
+        numOfLines = readAhead_max;
+    if (numOfLines >= this->numOfLines)
+        numOfLines = this->numOfLines - 1;
+
+    readAhead = numOfLines;
+}
+
+/**
+ * @brief read, from cache lines, missing pages are read from flash into LRU lines.
+ * @param uint32_t addr, uint8_t *buf, uint32_t len
+ * @return Cache_ns::status_t
+ */
+status_t BlockCache::read (uint32_t addr, uint8_t *buf, uint32_t len){
+    uint32_t page, firstPage, offset, chunk, start, end;
+    bool isSequential;
+    line_s *line_p;
+    uint8_t count;
+
+    if (len == 0)
+        return successful;
+
+    firstPage = addr / line_size;
+    isSequential = (lastPage != page_none) && ((firstPage == lastPage) || (firstPage == lastPage + 1));
+    lastPage = (addr + len - 1) / line_size;
+
+    if (len >= 2 * (uint32_t) line_size){
+        /* long read : one command to buf, then newer data of cached lines */
+        ahead_wait ();
+        if (flash_read (addr, buf, len) != AT25_ns::successful)
+            return failed;
+        stats.bypassReads++;
+
+        for (count = 0; count < numOfLines; count++){
+            line_p = &lines[count];
+            if ((line_p->state != line_clean) && (line_p->state != line_dirty))
+                continue;
+
+            start = line_p->page * line_size;
+            end = start + line_size;
+            if ((end <= addr) || (start >= addr + len))
+                continue;
+
+            if (start < addr)
+                start = addr;
+            if (end > addr + len)
+                end = addr + len;
+            memcpy (&buf[start - addr], &line_p->data[start - line_p->page * line_size], end - start);
+        }
+    }
+    else {
+        while (len > 0){
+            page = addr / line_size;
+            offset = addr % line_size;
+            chunk = line_size - offset;
+            if (chunk > len)
+                chunk = len;
+
+            ahead_finish ();
+            line_p = line_find (page);
+            if (line_p != NULL)
+                stats.readHits++;
+            else {
+                stats.readMisses++;
+                line_p = line_get (page, false);
+                if (line_p == NULL)
+                    return failed;
+            }
+
+            if (line_p->isAhead){
+                line_p->isAhead = false;
+                stats.readAheadHits++;
+            }
+            line_p->lastUse = ++useCount;
+            memcpy (buf, &line_p->data[offset], chunk);
+
+            addr += chunk;
+            buf += chunk;
+            len -= chunk;
+        }
+    }
+
+    if (isSequential && (readAhead > 0))
+        ahead_next (lastPage);
+
+    return successful;
+}
+
+/**
+ * @brief write, to cache lines (write-allocate), flash is programmed on eviction, flush or sync.
+ * @param uint32_t addr, const uint8_t *buf, uint32_t len
+ * @return Cache_ns::status_t
+ */
+status_t BlockCache::write (uint32_t addr, const uint8_t *buf, uint32_t len){
+    uint32_t page, offset, chunk;
+    line_s *line_p;
+
+    while (len > 0){
+        page = addr / line_size;
+        offset = addr % line_size;
+        chunk = line_size - offset;
+        if (chunk > len)
+            chunk = len;
+
+        ahead_finish ();
+        line_p = line_find (page);
+        if (line_p != NULL)
+            stats.writeHits++;
+        else {
+            stats.writeMisses++;
+            line_p = line_get (page, (chunk == line_size));
+            if (line_p == NULL)
+                return failed;
+        }
+
+        memcpy (&line_p->data[offset], buf, chunk);
+        line_p->state = line_dirty;
+        line_p->isAhead = false;
+        line_p->lastUse = ++useCount;
+
+        addr += chunk;
+        buf += chunk;
+        len -= chunk;
+    }
+
+    return successful;
+}
+
+/**
+ * @brief flush, writes back all dirty lines, they stay in cache (clean).
+ * @return Cache_ns::status_t : failed if a line couldn't be written back (it stays dirty).
+ */
+status_t BlockCache::flush (void){
+    status_t retval = successful;
+    uint8_t count;
+
+    for (count = 0; count < numOfLines; count++){
+        /* a sector rewrite cleans other lines too, state is checked again */
+        if (lines[count].state != line_dirty)
+            continue;
+
+        if (line_writeBack (&lines[count]) != successful)
+            retval = failed;
+    }
+
+    return retval;
+}
+
+/**
+ * @brief sync, flush, then forgets all lines and waits for the end of flash operations.
+ * @return Cache_ns::status_t : failed if a line couldn't be written back (it stays dirty and cached).
+ */
+status_t BlockCache::sync (void){
+    status_t retval;
+    uint8_t count;
+
+    retval = flush ();
+    ahead_wait ();
+
+    for (count = 0; count < numOfLines; count++){
+        if (lines[count].state == line_dirty)
+            continue;
+
+        lines[count].page = page_none;
+        lines[count].state = line_invalid;
+        lines[count].isAhead = false;
+    }
+    lastPage = page_none;
+
+    while (at25_p->isBusy ());
+
+    return retval;
+}
+
+/**
+ * @brief stats_get
+ * @param Cache_ns::stats_t *stats_p
+ * @return None
+ */
+void BlockCache::stats_get (stats_t *stats_p){
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void BlockCache::stats_reset (void){
+    memset (&stats, 0, sizeof (stats));
+}
+
+/**
+ * @brief line_peek, line holding page (clean, dirty or loading), doesn't wait.
+ * @return line_s *, NULL if not cached.
+ */
+line_s *BlockCache::line_peek (uint32_t page){
+    uint8_t count;
+
+    for (count = 0; count < numOfLines; count++){
+        if ((lines[count].page == page) && (lines[count].state != line_invalid))
+            return &lines[count];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief line_find, line holding page (clean or dirty), waits for a read-ahead of this page.
+ * @return line_s *, NULL if not cached.
+ */
+line_s *BlockCache::line_find (uint32_t page){
+    line_s *line_p;
+
+    line_p = line_peek (page);
+    if ((line_p == NULL) || (line_p->state != line_loading))
+        return line_p;
+
+    ahead_wait ();
+
+    return (line_p->state == line_invalid) ? NULL : line_p;
+}
+
+/**
+ * @brief line_victim, invalid line first, then least recently used.
+ * @param bool isForAhead : only invalid lines, or clean lines which aren't read-ahead
+ * pages waiting to be used (read-ahead never writes back nor throws away its own pages).
+ * @return line_s *, NULL if none.
+ */
+line_s *BlockCache::line_victim (bool isForAhead){
+    line_s *victim_p = NULL;
+    uint8_t count;
+
+    for (count = 0; count < numOfLines; count++){
+        if (lines[count].state == line_invalid)
+            return &lines[count];
+
+        if (lines[count].state == line_loading)
+            continue;
+
+        if (isForAhead && ((lines[count].state == line_dirty) || lines[count].isAhead))
+            continue;
+
+        if ((victim_p == NULL) || (lines[count].lastUse < victim_p->lastUse))
+            victim_p = &lines[count];
+    }
+
+    return victim_p;
+}
+
+/**
+ * @brief line_get, line for a missing page, the victim is written back if dirty.
+ * @param bool isFullWrite : the whole page will be written, flash isn't read.
+ * @return line_s *, NULL if failed.
+ */
+line_s *BlockCache::line_get (uint32_t page, bool isFullWrite){
+    line_s *line_p;
+
+    ahead_wait ();
+
+    line_p = line_victim (false);
+    if (line_p == NULL)
+        return NULL;
+
+    if (line_p->state != line_invalid){
+        if ((line_p->state == line_dirty) && (line_writeBack (line_p) != successful))
+            return NULL;
+        stats.evictions++;
+    }
+
+    line_p->page = page;
+    line_p->isAhead = false;
+    line_p->state = line_invalid;
+
+    if (!isFullWrite){
+        if (flash_read (page * line_size, line_p->data, line_size) != AT25_ns::successful){
+            line_p->page = page_none;
+            return NULL;
+        }
+    }
+
+    line_p->state = line_clean;
+
+    return line_p;
+}
+
+/**
+ * @brief line_writeBack, page program if the line only clears bits of the page in flash,
+ * sector rewrite otherwise.
+ * @return Cache_ns::status_t
+ */
+status_t BlockCache::line_writeBack (line_s *line_p){
+    bool isSame = true;
+    bool isProgrammable = true;
+    uint16_t count;
+
+    ahead_wait ();
+
+    if (flash_read (line_p->page * line_size, pageBuf, line_size) != AT25_ns::successful)
+        return failed;
+
+    for (count = 0; count < line_size; count++){
+        if (pageBuf[count] != line_p->data[count])
+            isSame = false;
+        if ((pageBuf[count] & line_p->data[count]) != line_p->data[count]){
+            isProgrammable = false;
+            break;
+        }
+    }
+
+    if (!isProgrammable)
+        return sector_rewrite (line_p->page * line_size / sector_size);
+
+    if (!isSame){
+        if (flash_program (line_p->page * line_size, line_p->data, line_size) != AT25_ns::successful)
+            return failed;
+        stats.writeBacks++;
+    }
+
+    line_p->state = line_clean;
+
+    return successful;
+}
+
+/**
+ * @brief sector_rewrite, read sector to sectorBuf, merge all dirty lines of the sector, erase, program.
+ * @param uint32_t sector : sector number.
+ * @return Cache_ns::status_t
+ */
+status_t BlockCache::sector_rewrite (uint32_t sector){
+    uint32_t base = sector * sector_size;
+    uint32_t offset;
+    uint16_t count;
+    bool isErased;
+
+    if (sectorBuf == NULL)
+        return failed;
+
+    if (flash_read (base, sectorBuf, sector_size) != AT25_ns::successful)
+        return failed;
+
+    for (count = 0; count < numOfLines; count++){
+        if ((lines[count].state == line_dirty) && (lines[count].page * line_size / sector_size == sector))
+            memcpy (&sectorBuf[lines[count].page * line_size - base], lines[count].data, line_size);
+    }
+
+    if (flash_erase (base, sector_size) != AT25_ns::successful)
+        return sector_lost (sector);
+
+    for (offset = 0; offset < sector_size; offset += line_size){
+        isErased = true;
+        for (count = 0; count < line_size; count++){
+            if (sectorBuf[offset + count] != 0xFF){
+                isErased = false;
+                break;
+            }
+        }
+        if (isErased)
+            continue;
+
+        if (flash_program (base + offset, &sectorBuf[offset], line_size) != AT25_ns::successful)
+            return sector_lost (sector);
+        stats.writeBacks++;
+    }
+    stats.sectorRewrites++;
+
+    for (count = 0; count < numOfLines; count++){
+        if ((lines[count].state == line_dirty) && (lines[count].page * line_size / sector_size == sector))
+            lines[count].state = line_clean;
+    }
+
+    return successful;
+}
+
+/**
+ * @brief sector_lost, erase or program of a sector has failed : its flash content is unknown,
+ * cached lines of it must be written again.
+ * @param uint32_t sector : sector number.
+ * @return Cache_ns::status_t : failed.
+ */
+status_t BlockCache::sector_lost (uint32_t sector){
+    uint8_t count;
+
+    for (count = 0; count < numOfLines; count++){
+        if ((lines[count].state == line_clean) && (lines[count].page * line_size / sector_size == sector))
+            lines[count].state = line_dirty;
+    }
+
+    return failed;
+}
+
+/**
+ * @brief ahead_next, lines for the pages after page which aren't cached (up to readAhead),
+ * they join the chain of reads, which is started if it isn't running.
+ * @return None
+ */
+void BlockCache::ahead_next (uint32_t page){
+    uint32_t primask;
+    bool isRunning;
+    uint8_t count;
+
+    ahead_finish ();
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    isRunning = (aheadDone < aheadNumOfLines);
+
+    for (count = 1; (count <= readAhead) && (aheadNumOfLines < readAhead_max); count++){
+        if (line_peek (page + count) != NULL)
+            continue; // cached or loading
+
+        if (!ahead_reserve (page + count))
+            break;
+    }
+
+    if (!isRunning)
+        ahead_chain ();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ahead_reserve, a free/clean line for page joins the chain (loading).
+ * @return bool : false if there is no line for read-ahead.
+ * @attention : called with IRQs disabled.
+ */
+bool BlockCache::ahead_reserve (uint32_t page){
+    line_s *line_p;
+
+    line_p = line_victim (true);
+    if (line_p == NULL)
+        return false;
+
+    if (line_p->state != line_invalid)
+        stats.evictions++;
+
+    line_p->page = page;
+    line_p->state = line_loading;
+    line_p->isAhead = true;
+    line_p->lastUse = ++useCount;
+
+    aheadLines[aheadNumOfLines++] = line_p;
+
+    return true;
+}
+
+/**
+ * @brief ahead_chain, starts the read of the next line of the chain by DMA, returns without waiting.
+ * If the flash is used by someone else, lines left in the chain are given back (busy).
+ * @return None
+ * @attention : called with IRQs disabled, or by aheadDone_handler (ISR context).
+ */
+void BlockCache::ahead_chain (void){
+    line_s *line_p;
+
+    if (aheadDone >= aheadNumOfLines)
+        return;
+
+    line_p = aheadLines[aheadDone];
+    if (at25_p->read_start (line_p->page * line_size, line_p->data, line_size, aheadDone_handler, this) ==
+        AT25_ns::successful)
+        return;
+
+    /* try again on the next read */
+    while (aheadDone < aheadNumOfLines)
+        aheadStatus[aheadDone++] = AT25_ns::busy;
+}
+
+/**
+ * @brief ahead_finish, lines of the chain whose read has ended become clean (or invalid),
+ * the chain is emptied when all of them have ended.
+ * @return None
+ */
+void BlockCache::ahead_finish (void){
+    line_s *line_p;
+    AT25_ns::status_t status;
+
+    while (aheadFinished < aheadDone){
+        line_p = aheadLines[aheadFinished];
+        status = aheadStatus[aheadFinished];
+        aheadFinished++;
+
+        if (status == AT25_ns::successful){
+            line_p->state = line_clean;
+            stats.readAheads++;
+        }
+        else {
+            line_p->page = page_none;
+            line_p->state = line_invalid;
+            line_p->isAhead = false;
+        }
+        if (status != AT25_ns::busy)
+            stats.flashReads++;
+    }
+
+    /* chain has ended, nothing touches it in ISR context */
+    if ((aheadFinished != 0) && (aheadFinished == aheadNumOfLines)){
+        aheadNumOfLines = 0;
+        aheadDone = 0;
+        aheadFinished = 0;
+    }
+}
+
+/**
+ * @brief ahead_wait, waits for the end of the chain of reads.
+ * @return None
+ */
+void BlockCache::ahead_wait (void){
+    while (aheadDone < aheadNumOfLines);
+    ahead_finish ();
+}
+
+/**
+ * @brief flash_read, blocking read, waits while the AT25 is used by someone else.
+ * @return AT25_ns::status_t
+ */
+AT25_ns::status_t BlockCache::flash_read (uint32_t addr, uint8_t *buf, uint32_t len){
+    AT25_ns::status_t retval;
+
+    while ((retval = at25_p->read (addr, buf, len)) == AT25_ns::busy);
+    stats.flashReads++;
+
+    return retval;
+}
+
+/**
+ * @brief flash_program, blocking program, waits while the AT25 is used by someone else.
+ * @return AT25_ns::status_t
+ */
+AT25_ns::status_t BlockCache::flash_program (uint32_t addr, const uint8_t *buf, uint32_t len){
+    AT25_ns::status_t retval;
+
+    while ((retval = at25_p->program (addr, buf, len)) == AT25_ns::busy);
+
+    return retval;
+}
+
+/**
+ * @brief flash_erase, blocking erase, waits while the AT25 is used by someone else.
+ * @return AT25_ns::status_t
+ */
+AT25_ns::status_t BlockCache::flash_erase (uint32_t addr, uint32_t len){
+    AT25_ns::status_t retval;
+
+    while ((retval = at25_p->erase (addr, len)) == AT25_ns::busy);
+
+    return retval;
+}
+
+/**
+ * @brief aheadDone_handler, end of a read-ahead, starts the next one of the chain (ISR context).
+ * @param void *arg : BlockCache.
+ * @return None
+ */
+void BlockCache::aheadDone_handler (void *arg, AT25_ns::status_t status){
+    BlockCache *cache_p = (BlockCache *) arg;
+
+    cache_p->aheadStatus[cache_p->aheadDone] = status;
+    cache_p->aheadDone++;
+    cache_p->ahead_chain ();
+}
@@ -0,0 +1,134 @@
+/**
+ * @file MB1_Cache.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is header file for a write-back block cache over an AT25 flash.
+ * Blocks are flash pages (line_size), any byte range can be read/written through the cache.
+ * - Lines are kept in LRU order, a dirty line is written back when it's evicted, or by flush/sync.
+ * - Writes are coalesced in lines : many small writes of one page cost one page program.
+ * - Write-back programs the page if new data only clear bits of flash data (checked against
+ *   the page in flash), otherwise the whole 4KB sector is read to sectorBuf, all dirty lines of
+ *   the sector are merged, the sector is erased and programmed again (failed if sectorBuf is NULL).
+ * - Read-ahead : on sequential reads, the next pages (up to readAhead lines ahead of the reader)
+ *   get free/clean lines at once, they are read by AT25::read_start (DMA) one after the other,
+ *   each read is started by the end of the previous one, while the application goes on.
+ * - Reads of 2 pages or more go straight to the caller buffer (one command), cached lines are
+ *   copied over it (they are newer), they don't evict lines.
+ * How to use this lib:
+ * - at25Flash_1.begin (), declare Cache_ns::line_s lines [N] (and optionally uint8_t sectorBuf [4096]).
+ * - BlockCache cache (&at25Flash_1, lines, N, sectorBuf); readAhead_set (2);
+ * - read/write, flush to write back dirty lines, sync to write back and forget all lines
+ *   (before other users of the flash, e.g. MB1_Kv, touch the same area).
+ * - stats_get : hits/misses to size N and readAhead for a workload.
+ * - Task context only (blocking AT25 calls, they need at25_miscTIMISR).
+ * - host/mb1_cachecheck.cpp checks it against a reference image, on MB1_AT25Model.
+ */
+
+#ifndef __MB1_CACHE_H
+#define __MB1_CACHE_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_AT25.h"
+
+namespace Cache_ns {
+
+/**< config (compile-time) */
+const uint16_t line_size = AT25_ns::page_size;
+const uint32_t sector_size = AT25_ns::block4K_size;
+const uint8_t readAhead_max = 8;
+const uint32_t page_none = 0xFFFFFFFF;
+
+typedef enum {
+    successful,
+    failed
+} status_t;
+
+typedef enum {
+    line_invalid,
+    line_clean,
+    line_dirty,
+    line_loading        // read-ahead in progress
+} lineState_t;
+
+/**< cache line, array is owned by the caller */
+typedef struct {
+    uint32_t page;      // page number (addr / line_size)
+    uint32_t lastUse;
+    uint8_t state;
+    bool isAhead;       // loaded by read-ahead, not used yet
+    uint8_t data [line_size];
+} line_s;
+
+typedef struct {
+    uint32_t readHits;
+    uint32_t readMisses;
+    uint32_t writeHits;
+    uint32_t writeMisses;
+    uint32_t readAheads;                // pages read ahead
+    uint32_t readAheadHits;             // of them, used later
+    uint32_t bypassReads;               // long reads straight to caller buffer
+    uint32_t evictions;
+    uint32_t writeBacks;                // page programs
+    uint32_t sectorRewrites;            // erase and program of a sector
+    uint32_t flashReads;                // read commands (round trips)
+} stats_t;
+
+}
+
+class BlockCache {
+public:
+    BlockCache (AT25 *at25_p, Cache_ns::line_s *lines, uint8_t numOfLines, uint8_t *sectorBuf);
+    void readAhead_set (uint8_t numOfLines);
+
+    Cache_ns::status_t read (uint32_t addr, uint8_t *buf, uint32_t len);
+    Cache_ns::status_t write (uint32_t addr, const uint8_t *buf, uint32_t len);
+    Cache_ns::status_t flush (void);
+    Cache_ns::status_t sync (void);
+
+    void stats_get (Cache_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+private:
+    AT25 *at25_p;
+    Cache_ns::line_s *lines;
+    uint8_t numOfLines;
+    uint8_t *sectorBuf;
+    uint8_t pageBuf [Cache_ns::line_size];
+
+    uint32_t useCount;
+    uint8_t readAhead;
+    uint32_t lastPage;                  // last page read, for sequential detection
+
+    /**< read-ahead chain : lines loading in page order, aheadDone_handler starts the next read */
+    Cache_ns::line_s *aheadLines [Cache_ns::readAhead_max];
+    volatile AT25_ns::status_t aheadStatus [Cache_ns::readAhead_max];
+    volatile uint8_t aheadNumOfLines;   // lines in the chain, 0 if none
+    volatile uint8_t aheadDone;         // lines whose read has ended (ISR)
+    uint8_t aheadFinished;              // lines made clean (or invalid) by ahead_finish
+
+    Cache_ns::stats_t stats;
+
+    Cache_ns::line_s *line_peek (uint32_t page);
+    Cache_ns::line_s *line_find (uint32_t page);
+    Cache_ns::line_s *line_victim (bool isForAhead);
+    Cache_ns::line_s *line_get (uint32_t page, bool isFullWrite);
+    Cache_ns::status_t line_writeBack (Cache_ns::line_s *line_p);
+    Cache_ns::status_t sector_rewrite (uint32_t sector);
+    Cache_ns::status_t sector_lost (uint32_t sector);
+
+    void ahead_next (uint32_t page);
+    bool ahead_reserve (uint32_t page);
+    void ahead_chain (void);
+    void ahead_finish (void);
+    void ahead_wait (void);
+
+    AT25_ns::status_t flash_read (uint32_t addr, uint8_t *buf, uint32_t len);
+    AT25_ns::status_t flash_program (uint32_t addr, const uint8_t *buf, uint32_t len);
+    AT25_ns::status_t flash_erase (uint32_t addr, uint32_t len);
+
+    static void aheadDone_handler (void *arg, AT25_ns::status_t status);
+};
+
+#endif // __MB1_CACHE_H
@@ -0,0 +1,314 @@
+/**
+ * @file MB1_Cobs.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for streaming COBS packet framing with CRC-32 trailer.
+ */
+
+/* Includes */
+#include "MB1_Cobs.h"
+using namespace Cobs_ns;
+
+/**
+ * @brief cobs_crcWord_sw, CRC-32 of 1 more word, bit by bit, same as STM32 CRC peripheral.
+ * @param uint32_t crc : running CRC (Cobs_ns::crcInit at start).
+ * @param uint32_t word
+ * @return uint32_t : new running CRC.
+ */
+uint32_t cobs_crcWord_sw (uint32_t crc, uint32_t word){
+    uint8_t bit;
+
+    crc ^= word;
+    for (bit = 0; bit < 32; bit++){
+        if ((crc & 0x80000000) != 0)
+            crc = (crc << 1) ^ 0x04C11DB7;
+        else
+            crc <<= 1;
+    }
+
+    return crc;
+}
+
+/**<----------------------------- class CobsEncoder ----------------------------------*/
+
+/**
+ * @brief CobsEncoder.
+ * @param Cobs_ns::sink_t sink_p : output of encoded bytes (not NULL).
+ * @param void *sinkCtx : passed to sink_p.
+ * @param Cobs_ns::crcWord_t crcWord_p : CRC function, NULL for frames without CRC trailer.
+ */
+CobsEncoder::CobsEncoder (sink_t sink_p, void *sinkCtx, crcWord_t crcWord_p){
+    this->sink_p = sink_p;
+    this->sinkCtx = sinkCtx;
+    this->crcWord_p = crcWord_p;
+
+    frame_begin ();
+}
+
+/**
+ * @brief frame_begin, start a new frame.
+ * @return None
+ */
+void CobsEncoder::frame_begin (void){
+    blockLen = 0;
+
+    crc = crcInit;
+    crcWord = 0;
+    crcWordBytes = 0;
+    payloadLen = 0;
+}
+
+/**
+ * @brief data_put, add 1 payload byte to current frame.
+ * @param uint8_t data
+ * @return None
+ */
+void CobsEncoder::data_put (uint8_t data){
+    if (crcWord_p != NULL){
+        crcWord |= (uint32_t) data << (crcWordBytes * 8);
+        if (++crcWordBytes == 4){
+            crc = crcWord_p (crc, crcWord);
+            crcWord = 0;
+            crcWordBytes = 0;
+        }
+        payloadLen++;
+    }
+
+    byte_encode (data);
+}
+
+/**
+ * @brief data_put, add payload bytes to current frame.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void CobsEncoder::data_put (const uint8_t *buf, uint16_t len){
+    uint16_t count;
+
+    for (count = 0; count < len; count++)
+        data_put (buf[count]);
+}
+
+/**
+ * @brief frame_end, append CRC-32 (if used) and the 0x00 delimiter, then send the last block.
+ * @return None
+ */
+void CobsEncoder::frame_end (void){
+    uint8_t delimiter = 0x00;
+    uint8_t count;
+
+    if (crcWord_p != NULL){
+        if (crcWordBytes != 0)
+            crc = crcWord_p (crc, crcWord);
+        crc = crcWord_p (crc, payloadLen);
+
+        for (count = 0; count < crcLen; count++)
+            byte_encode ((uint8_t) (crc >> (count * 8)));
+    }
+
+    block_flush ();
+    sink_p (sinkCtx, &delimiter, 1);
+
+    frame_begin ();
+}
+
+/**
+ * @brief byte_encode, COBS-encode 1 byte into current block.
+ * @param uint8_t data
+ * @return None
+ */
+void CobsEncoder::byte_encode (uint8_t data){
+    if (data == 0x00){
+        block_flush ();
+        return;
+    }
+
+    block[++blockLen] = data;
+    if (blockLen == blockData_max)
+        block_flush ();
+}
+
+/**
+ * @brief block_flush, send code byte and data of current block.
+ * @return None
+ */
+void CobsEncoder::block_flush (void){
+    block[0] = blockLen + 1;
+    sink_p (sinkCtx, block, blockLen + 1);
+    blockLen = 0;
+}
+
+/**<----------------------------- class CobsDecoder ----------------------------------*/
+
+/**
+ * @brief CobsDecoder.
+ * @param uint8_t *buf : decoded frame (payload + CRC), bufSize >= max payload + Cobs_ns::crcLen.
+ * @param uint16_t bufSize
+ * @param Cobs_ns::crcWord_t crcWord_p : CRC function, NULL for frames without CRC trailer.
+ * @attention The STM32 CRC peripheral can't be shared by an encoder and a decoder working
+ * at the same time, use cobs_crcWord_sw for one of them.
+ */
+CobsDecoder::CobsDecoder (uint8_t *buf, uint16_t bufSize, crcWord_t crcWord_p){
+    this->buf = buf;
+    this->bufSize = bufSize;
+    this->crcWord_p = crcWord_p;
+    trailerLen = (crcWord_p != NULL) ? crcLen : 0;
+
+    crcErrors = 0;
+    otherErrors = 0;
+    frameLen = 0;
+
+    reset ();
+}
+
+/**
+ * @brief reset, drop current frame and wait for a new one.
+ * @return None
+ */
+void CobsDecoder::reset (void){
+    len = 0;
+    code = 0;
+    codeLeft = 0;
+    zeroPending = false;
+    isDropping = false;
+
+    crc = crcInit;
+    crcWord = 0;
+    crcWordBytes = 0;
+}
+
+/**
+ * @brief data_put, decode 1 received byte.
+ * @param uint8_t data
+ * @return Cobs_ns::status_t
+ * - frameReady : a frame with good CRC has been received, get it by frame_get.
+ * - frameError : a broken frame has been dropped.
+ * - inProgress : otherwise.
+ */
+status_t CobsDecoder::data_put (uint8_t data){
+    uint8_t count;
+    uint32_t rxCrc;
+
+    /**< delimiter */
+    if (data == 0x00){
+        if (isDropping){
+            reset ();
+            return inProgress;
+        }
+
+        if ((len == 0) && (code == 0)) // idle line, 0x00 0x00
+            return inProgress;
+
+        if ((codeLeft != 0) || (len < trailerLen)){
+            otherErrors++;
+            reset ();
+            return frameError;
+        }
+
+        if (crcWord_p == NULL){
+            frameLen = len;
+            reset ();
+            return frameReady;
+        }
+
+        /**< last 4 bytes are CRC, all payload bytes have been fed */
+        if (crcWordBytes != 0)
+            crc = crcWord_p (crc, crcWord);
+        crc = crcWord_p (crc, (uint32_t) (len - crcLen));
+
+        rxCrc = 0;
+        for (count = 0; count < crcLen; count++)
+            rxCrc |= (uint32_t) buf[len - crcLen + count] << (count * 8);
+
+        if (rxCrc != crc){
+            crcErrors++;
+            reset ();
+            return frameError;
+        }
+
+        frameLen = len - crcLen;
+        reset ();
+        return frameReady;
+    }
+
+    if (isDropping)
+        return inProgress;
+
+    /**< code byte */
+    if (codeLeft == 0){
+        if (zeroPending){
+            if (!byte_store (0x00))
+                return frameError;
+        }
+        code = data;
+        codeLeft = data - 1;
+        zeroPending = (data != 0xFF);
+        return inProgress;
+    }
+
+    /**< data byte */
+    codeLeft--;
+    if (!byte_store (data))
+        return frameError;
+
+    return inProgress;
+}
+
+/**
+ * @brief byte_store, store 1 decoded byte and CRC the byte 4 positions before it
+ * (it can't be a CRC byte any more).
+ * @param uint8_t data
+ * @return bool : false if frame is too long (frame is dropped).
+ */
+bool CobsDecoder::byte_store (uint8_t data){
+    uint8_t payloadByte;
+
+    if (len >= bufSize){
+        otherErrors++;
+        isDropping = true;
+        return false;
+    }
+
+    buf[len++] = data;
+
+    if ((crcWord_p != NULL) && (len > crcLen)){
+        payloadByte = buf[len - crcLen - 1];
+        crcWord |= (uint32_t) payloadByte << (crcWordBytes * 8);
+        if (++crcWordBytes == 4){
+            crc = crcWord_p (crc, crcWord);
+            crcWord = 0;
+            crcWordBytes = 0;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief frame_get, get last received frame.
+ * @param const uint8_t **payload_pp : set to payload.
+ * @return uint16_t : payload length, valid until next data_put.
+ */
+uint16_t CobsDecoder::frame_get (const uint8_t **payload_pp){
+    *payload_pp = buf;
+
+    return frameLen;
+}
+
+/**
+ * @brief crcErrors_get, number of frames dropped because of CRC.
+ * @return uint32_t
+ */
+uint32_t CobsDecoder::crcErrors_get (void){
+    return crcErrors;
+}
+
+/**
+ * @brief otherErrors_get, number of frames dropped because of overflow or bad COBS.
+ * @return uint32_t
+ */
+uint32_t CobsDecoder::otherErrors_get (void){
+    return otherErrors;
+}
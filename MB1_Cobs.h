@@ -0,0 +1,112 @@
+/**
+ * @file MB1_Cobs.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for streaming COBS packet framing with CRC-32 trailer.
+ * Frame on the wire : COBS (payload, CRC-32 LE) 0x00.
+ * CRC-32 is the STM32 one (poly 0x04C11DB7, init 0xFFFFFFFF, 32-bit words, no reflection),
+ * computed over the payload packed into little-endian words (last word zero padded),
+ * then over the payload length (1 word).
+ * Both encoder and decoder work in one pass, bytes are CRC-ed as they are put.
+ * This file only depends on stdint.h, so host tools build the same encoder/decoder
+ * (with cobs_crcWord_sw), the board uses CRC_hwWord (hl_crc.h) or cobs_crcWord_sw.
+ * How to use this lib:
+ * - Encoder : frame_begin, data_put (many times), frame_end. Encoded bytes go to sink_p.
+ * - Decoder : data_put every received byte, frame_get when it returns frameReady.
+ * Decoder drops broken frames (CRC, overflow, COBS errors) and resynchronises on next 0x00.
+ * With crcWord_p = NULL, frames have no CRC trailer (e.g. short log records).
+ */
+
+#ifndef __MB1_COBS_H
+#define __MB1_COBS_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+
+namespace Cobs_ns {
+
+/**< config (compile-time) */
+const uint8_t blockData_max = 254;
+const uint32_t crcInit = 0xFFFFFFFF;
+const uint8_t crcLen = 4;
+
+typedef enum {
+    inProgress,
+    frameReady,
+    frameError
+} status_t;
+
+/**< output of encoder, e.g. serial_t::Out_sink */
+typedef void (* sink_t) (void *sinkCtx, const uint8_t *buf, uint16_t len);
+
+/**< CRC of 1 more word : returns new CRC from running CRC (crcInit at start) */
+typedef uint32_t (* crcWord_t) (uint32_t crc, uint32_t word);
+
+}
+
+/* Software CRC, same result as STM32 CRC peripheral */
+uint32_t cobs_crcWord_sw (uint32_t crc, uint32_t word);
+
+class CobsEncoder {
+public:
+    CobsEncoder (Cobs_ns::sink_t sink_p, void *sinkCtx, Cobs_ns::crcWord_t crcWord_p);
+
+    void frame_begin (void);
+    void data_put (uint8_t data);
+    void data_put (const uint8_t *buf, uint16_t len);
+    void frame_end (void);
+
+private:
+    Cobs_ns::sink_t sink_p;
+    void *sinkCtx;
+    Cobs_ns::crcWord_t crcWord_p;
+
+    uint8_t block [Cobs_ns::blockData_max + 1]; // code + data
+    uint8_t blockLen;
+
+    uint32_t crc;
+    uint32_t crcWord;
+    uint8_t crcWordBytes;
+    uint32_t payloadLen;
+
+    void byte_encode (uint8_t data);
+    void block_flush (void);
+};
+
+class CobsDecoder {
+public:
+    CobsDecoder (uint8_t *buf, uint16_t bufSize, Cobs_ns::crcWord_t crcWord_p);
+
+    Cobs_ns::status_t data_put (uint8_t data);
+    uint16_t frame_get (const uint8_t **payload_pp);
+
+    void reset (void);
+    uint32_t crcErrors_get (void);
+    uint32_t otherErrors_get (void);
+
+private:
+    uint8_t *buf;
+    uint16_t bufSize;
+    Cobs_ns::crcWord_t crcWord_p;
+    uint8_t trailerLen;     // crcLen, or 0 without CRC
+
+    uint16_t len;
+    uint8_t code;           // code of current block, 0 : waiting for a code byte
+    uint8_t codeLeft;       // data bytes left in current block
+    bool zeroPending;       // previous block ended by an implicit 0x00
+    bool isDropping;        // broken frame, wait for 0x00
+
+    uint32_t crc;
+    uint32_t crcWord;
+    uint8_t crcWordBytes;
+    uint16_t frameLen;
+
+    uint32_t crcErrors;
+    uint32_t otherErrors;
+
+    bool byte_store (uint8_t data);
+};
+
+#endif // __MB1_COBS_H
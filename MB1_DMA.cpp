@@ -0,0 +1,172 @@
+/**
+ * @file MB1_DMA.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for DMA channel sharing on MBoard-1.
+ */
+
+/* Includes */
+#include "MB1_DMA.h"
+using namespace DMA_ns;
+
+/**< sys_conf */
+DMA_Channel_TypeDef* DMA_channels [numOfChannels] = {   DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4,
+                                                        DMA1_Channel5, DMA1_Channel6, DMA1_Channel7,
+                                                        DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4,
+                                                        DMA2_Channel5 };
+const uint8_t DMA_IRQns [numOfChannels] = {     DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+                                                DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+                                                DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_5_IRQn,
+                                                DMA2_Channel4_5_IRQn };
+
+const uint8_t DMA_IRQ_preemptionPriority = 0x01;
+const uint8_t DMA_IRQ_subPriority = 0x00;
+/**< end sys_conf */
+
+/**< owners */
+static handler_t DMA_handlers [numOfChannels] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+static void * DMA_args [numOfChannels] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+
+/**
+  * @brief DMA_channel_claim, take a DMA channel, enable DMA clock and channel IRQ.
+  * @param DMA_ns::channel_t channel
+  * @param DMA_ns::handler_t handler, called in ISR context with channel event flags.
+  * NULL if the owner doesn't use channel interrupts (channel IRQ is not enabled then).
+  * @param void *arg (not a NULL ptr), passed to handler, it's also the owner id.
+  * @return DMA_ns::status_t, busy if channel has been claimed by other owner.
+  */
+status_t DMA_channel_claim (channel_t channel, handler_t handler, void *arg){
+    NVIC_InitTypeDef nvicStruct;
+
+    if ((channel >= numOfChannels) || (arg == NULL))
+        return failed;
+
+    if ((DMA_args[channel] != NULL) && (DMA_args[channel] != arg))
+        return busy;
+
+    RCC_AHBPeriphClockCmd ((channel < DMA2_ch1) ? RCC_AHBPeriph_DMA1 : RCC_AHBPeriph_DMA2, ENABLE);
+
+    DMA_args[channel] = arg;
+    DMA_handlers[channel] = handler;
+
+    if (handler == NULL)
+        return successful;
+
+    nvicStruct.NVIC_IRQChannel = DMA_IRQns[channel];
+    nvicStruct.NVIC_IRQChannelCmd = ENABLE;
+    nvicStruct.NVIC_IRQChannelPreemptionPriority = DMA_IRQ_preemptionPriority;
+    nvicStruct.NVIC_IRQChannelSubPriority = DMA_IRQ_subPriority;
+    NVIC_Init (&nvicStruct);
+
+    return successful;
+}
+
+/**
+  * @brief DMA_channel_release, disable and give back a DMA channel.
+  * @param DMA_ns::channel_t channel
+  * @param void *arg, owner id given in DMA_channel_claim.
+  * @return DMA_ns::status_t
+  */
+status_t DMA_channel_release (channel_t channel, void *arg){
+    if (channel >= numOfChannels)
+        return failed;
+
+    if ((arg == NULL) || (DMA_args[channel] != arg))
+        return failed;
+
+    DMA_DeInit (DMA_channels[channel]);
+    DMA_handlers[channel] = NULL;
+    DMA_args[channel] = NULL;
+
+    return successful;
+}
+
+/**
+  * @brief DMA_channel_get, get registers of a DMA channel.
+  * @param DMA_ns::channel_t channel
+  * @return DMA_Channel_TypeDef *, NULL if channel is invalid.
+  */
+DMA_Channel_TypeDef * DMA_channel_get (channel_t channel){
+    if (channel >= numOfChannels)
+        return NULL;
+
+    return DMA_channels[channel];
+}
+
+/**
+  * @brief DMA_channel_dispatch, clear events of a channel and call its handler.
+  * @param DMA_ns::channel_t channel
+  * @return None
+  */
+static void DMA_channel_dispatch (channel_t channel){
+    DMA_TypeDef *dma;
+    uint8_t shift;
+    uint32_t flags;
+
+    if (channel < DMA2_ch1){
+        dma = DMA1;
+        shift = channel * 4;
+    }
+    else{
+        dma = DMA2;
+        shift = (channel - DMA2_ch1) * 4;
+    }
+
+    flags = (dma->ISR >> shift) & 0x0F;
+    if (flags == 0)
+        return;
+
+    dma->IFCR = (uint32_t)0x0F << shift;
+
+    if (DMA_handlers[channel] != NULL)
+        DMA_handlers[channel] (DMA_args[channel], flags);
+
+    return;
+}
+
+/* ISRs */
+void DMA1_Channel1_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch1);
+}
+
+void DMA1_Channel2_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch2);
+}
+
+void DMA1_Channel3_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch3);
+}
+
+void DMA1_Channel4_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch4);
+}
+
+void DMA1_Channel5_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch5);
+}
+
+void DMA1_Channel6_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch6);
+}
+
+void DMA1_Channel7_IRQHandler (void){
+    DMA_channel_dispatch (DMA1_ch7);
+}
+
+void DMA2_Channel1_IRQHandler (void){
+    DMA_channel_dispatch (DMA2_ch1);
+}
+
+void DMA2_Channel2_IRQHandler (void){
+    DMA_channel_dispatch (DMA2_ch2);
+}
+
+void DMA2_Channel3_IRQHandler (void){
+    DMA_channel_dispatch (DMA2_ch3);
+}
+
+void DMA2_Channel4_5_IRQHandler (void){
+    DMA_channel_dispatch (DMA2_ch4);
+    DMA_channel_dispatch (DMA2_ch5);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file MB1_DMA.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for DMA channel sharing on MBoard-1.
+ * USARTs and SPIs share the channels of DMA1 (e.g. DMA1 channel 2 is USART3_TX and SPI1_RX),
+ * so a driver claims a channel before using it, and the DMA IRQ handlers of this file
+ * dispatch channel events (TC, HT, TE) to the owner.
+ * How to use this lib:
+ * - DMA_channel_claim with a handler (busy if another driver owns the channel).
+ * - Config the channel registers got by DMA_channel_get.
+ * - DMA_channel_release when finished.
+ */
+
+#ifndef __MB1_DMA_H
+#define __MB1_DMA_H
+
+/* Includes */
+#include "MB1_Glb.h"
+
+namespace DMA_ns {
+
+typedef enum {
+    successful,
+    failed,
+    busy
+} status_t;
+
+typedef enum {
+    DMA1_ch1 = 0,
+    DMA1_ch2,
+    DMA1_ch3,
+    DMA1_ch4,
+    DMA1_ch5,
+    DMA1_ch6,
+    DMA1_ch7,
+    DMA2_ch1,
+    DMA2_ch2,
+    DMA2_ch3,
+    DMA2_ch4,
+    DMA2_ch5,
+    noChannel
+} channel_t;
+
+const uint8_t numOfChannels = noChannel;
+
+/**< channel event flags, passed to handler */
+const uint32_t flag_TC = 0x02;
+const uint32_t flag_HT = 0x04;
+const uint32_t flag_TE = 0x08;
+
+/**< handler (ISR context), arg is the one given to DMA_channel_claim */
+typedef void (* handler_t) (void *arg, uint32_t flags);
+
+}
+
+/* Prototypes */
+DMA_ns::status_t DMA_channel_claim (DMA_ns::channel_t channel, DMA_ns::handler_t handler, void *arg);
+DMA_ns::status_t DMA_channel_release (DMA_ns::channel_t channel, void *arg);
+DMA_Channel_TypeDef * DMA_channel_get (DMA_ns::channel_t channel);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ISRs */
+void DMA1_Channel1_IRQHandler (void);
+void DMA1_Channel2_IRQHandler (void);
+void DMA1_Channel3_IRQHandler (void);
+void DMA1_Channel4_IRQHandler (void);
+void DMA1_Channel5_IRQHandler (void);
+void DMA1_Channel6_IRQHandler (void);
+void DMA1_Channel7_IRQHandler (void);
+void DMA2_Channel1_IRQHandler (void);
+void DMA2_Channel2_IRQHandler (void);
+void DMA2_Channel3_IRQHandler (void);
+void DMA2_Channel4_5_IRQHandler (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MB1_DMA_H
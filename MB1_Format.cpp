@@ -0,0 +1,189 @@
+/**
+ * @file MB1_Format.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for number formatting on MBoard-1 (decimal, hex, fixed-point).
+ */
+
+/* Includes */
+#include "MB1_Format.h"
+using namespace Fmt_ns;
+
+/* Private vars and definitions */
+static const char fmt_hexDigits [16] = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                        '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+static const uint32_t fmt_pow10 [decimals_max + 1] = {1, 10, 100, 1000, 10000, 100000,
+                                                      1000000, 10000000, 100000000, 1000000000};
+
+/**
+ * @brief fmt_div10, num / 10 by reciprocal multiplication (exact for all uint32_t).
+ * @param uint32_t num
+ * @return uint32_t
+ */
+static inline uint32_t fmt_div10 (uint32_t num){
+    return (uint32_t) (((uint64_t) num * 0xCCCCCCCDu) >> 35);
+}
+
+/**
+ * @brief fmt_reversedDec, write decimal digits of num in reversed order.
+ * @param char *digits, at least 10 chars.
+ * @param uint32_t num
+ * @return uint8_t : number of digits.
+ */
+static uint8_t fmt_reversedDec (char *digits, uint32_t num){
+    uint8_t count = 0;
+    uint32_t quotient;
+
+    do{
+        quotient = fmt_div10 (num);
+        digits[count++] = '0' + (char) (num - quotient * 10);
+        num = quotient;
+    }while (num != 0);
+
+    return count;
+}
+
+/**
+ * @brief fmt_output, write sign, padding and reversed digits to buf.
+ * @param char *buf
+ * @param const char *digits : reversed digits.
+ * @param uint8_t numOfDigits
+ * @param bool isNegative
+ * @param uint8_t width : min length of output.
+ * @param Fmt_ns::pad_t pad
+ * @return uint8_t : length of output (without NUL).
+ */
+static uint8_t fmt_output (char *buf, const char *digits, uint8_t numOfDigits, bool isNegative,
+                           uint8_t width, pad_t pad){
+    uint8_t len = 0;
+    uint8_t used = numOfDigits + (isNegative ? 1 : 0);
+    uint8_t padding;
+
+    if (width > width_max)
+        width = width_max;
+    padding = (width > used) ? (width - used) : 0;
+
+    if (pad == pad_space){
+        while (padding-- > 0)
+            buf[len++] = ' ';
+        if (isNegative)
+            buf[len++] = '-';
+    }
+    else{
+        if (isNegative)
+            buf[len++] = '-';
+        while (padding-- > 0)
+            buf[len++] = '0';
+    }
+
+    while (numOfDigits > 0)
+        buf[len++] = digits[--numOfDigits];
+
+    buf[len] = '\0';
+
+    return len;
+}
+
+/**
+ * @brief fmt_u32, format unsigned decimal.
+ * @param char *buf : at least Fmt_ns::bufLen_max chars.
+ * @param uint32_t num
+ * @param uint8_t width : min length, 0 for no padding.
+ * @param Fmt_ns::pad_t pad
+ * @return uint8_t : length of formatted string.
+ */
+uint8_t fmt_u32 (char *buf, uint32_t num, uint8_t width, pad_t pad){
+    char digits [10];
+    uint8_t numOfDigits = fmt_reversedDec (digits, num);
+
+    return fmt_output (buf, digits, numOfDigits, false, width, pad);
+}
+
+/**
+ * @brief fmt_i32, format signed decimal.
+ * @param char *buf : at least Fmt_ns::bufLen_max chars.
+ * @param int32_t num
+ * @param uint8_t width : min length (sign included), 0 for no padding.
+ * @param Fmt_ns::pad_t pad
+ * @return uint8_t : length of formatted string.
+ */
+uint8_t fmt_i32 (char *buf, int32_t num, uint8_t width, pad_t pad){
+    char digits [10];
+    bool isNegative = (num < 0);
+    uint32_t absNum = isNegative ? (0u - (uint32_t) num) : (uint32_t) num;
+    uint8_t numOfDigits = fmt_reversedDec (digits, absNum);
+
+    return fmt_output (buf, digits, numOfDigits, isNegative, width, pad);
+}
+
+/**
+ * @brief fmt_hex, format hexadecimal (upper case, no prefix).
+ * @param char *buf : at least Fmt_ns::bufLen_max chars.
+ * @param uint32_t num
+ * @param uint8_t width : min length, 0 for no padding.
+ * @param Fmt_ns::pad_t pad
+ * @return uint8_t : length of formatted string.
+ */
+uint8_t fmt_hex (char *buf, uint32_t num, uint8_t width, pad_t pad){
+    char digits [8];
+    uint8_t numOfDigits = 0;
+
+    do{
+        digits[numOfDigits++] = fmt_hexDigits[num & 0x0F];
+        num >>= 4;
+    }while (num != 0);
+
+    return fmt_output (buf, digits, numOfDigits, false, width, pad);
+}
+
+/**
+ * @brief fmt_fixed, format a signed fixed-point number (Q format), rounded to decimals.
+ * @param char *buf : at least Fmt_ns::bufLen_max chars.
+ * @param int32_t num : real value = num / 2^qBits.
+ * @param uint8_t qBits : number of fractional bits (0 - 31).
+ * @param uint8_t decimals : number of digits after '.' (0 - Fmt_ns::decimals_max).
+ * @param uint8_t width : min length (sign and '.' included), 0 for no padding.
+ * @param Fmt_ns::pad_t pad
+ * @return uint8_t : length of formatted string.
+ * e.g. fmt_fixed (buf, -0x18000, 16, 2, 0, pad_space) -> "-1.50".
+ */
+uint8_t fmt_fixed (char *buf, int32_t num, uint8_t qBits, uint8_t decimals, uint8_t width, pad_t pad){
+    char digits [10 + 1 + decimals_max];
+    uint8_t numOfDigits = 0;
+    bool isNegative = (num < 0);
+    uint32_t absNum = isNegative ? (0u - (uint32_t) num) : (uint32_t) num;
+    uint32_t intPart, fracPart, quotient;
+    uint8_t count;
+
+    if (qBits > 31)
+        qBits = 31;
+    if (decimals > decimals_max)
+        decimals = decimals_max;
+
+    intPart = absNum >> qBits;
+
+    /**< fraction scaled to 10^decimals and rounded, one 32x32->64 multiplication */
+    fracPart = absNum & ((1u << qBits) - 1);
+    fracPart = (uint32_t) ((((uint64_t) fracPart * fmt_pow10[decimals]) + ((1u << qBits) >> 1)) >> qBits);
+    if (fracPart >= fmt_pow10[decimals]){ // rounded up to next integer
+        fracPart -= fmt_pow10[decimals];
+        intPart++;
+    }
+    if ((intPart == 0) && (fracPart == 0)) // "-0.00" is printed as "0.00"
+        isNegative = false;
+
+    /**< reversed : fraction digits, '.', integer digits */
+    if (decimals > 0){
+        for (count = 0; count < decimals; count++){
+            quotient = fmt_div10 (fracPart);
+            digits[numOfDigits++] = '0' + (char) (fracPart - quotient * 10);
+            fracPart = quotient;
+        }
+        digits[numOfDigits++] = '.';
+    }
+    numOfDigits += fmt_reversedDec (&digits[numOfDigits], intPart);
+
+    return fmt_output (buf, digits, numOfDigits, isNegative, width, pad);
+}
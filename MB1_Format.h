@@ -0,0 +1,42 @@
+/**
+ * @file MB1_Format.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for number formatting on MBoard-1 (decimal, hex, fixed-point).
+ * Decimal digits are got by reciprocal multiplication (no division), so it's much lighter
+ * than printf. Formatted strings are written to a caller buffer (NUL-terminated), serial_t
+ * uses them in Print, PrintHex, PrintFixed.
+ * How to use this lib:
+ * - Declare a char buffer of Fmt_ns::bufLen_max.
+ * - fmt_xxx (buffer, number, ...), returned value is the length of the string.
+ */
+
+#ifndef __MB1_FORMAT_H
+#define __MB1_FORMAT_H
+
+/* Includes */
+#include "stdint.h"
+
+namespace Fmt_ns {
+
+/**< max length of formatted string, including NUL */
+const uint8_t bufLen_max = 32;
+/**< max width and decimals, bigger values are clipped */
+const uint8_t width_max = bufLen_max - 1;
+const uint8_t decimals_max = 9;
+
+typedef enum {
+    pad_space,      // "  42"
+    pad_zero        // "0042", "-042"
+} pad_t;
+
+}
+
+/* Prototypes */
+uint8_t fmt_u32 (char *buf, uint32_t num, uint8_t width, Fmt_ns::pad_t pad);
+uint8_t fmt_i32 (char *buf, int32_t num, uint8_t width, Fmt_ns::pad_t pad);
+uint8_t fmt_hex (char *buf, uint32_t num, uint8_t width, Fmt_ns::pad_t pad);
+uint8_t fmt_fixed (char *buf, int32_t num, uint8_t qBits, uint8_t decimals, uint8_t width, Fmt_ns::pad_t pad);
+
+#endif // __MB1_FORMAT_H
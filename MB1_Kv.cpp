@@ -0,0 +1,616 @@
+/**
+ * @file MB1_Kv.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is source file for a log-structured key-value store on SPI flash.
+ */
+
+/* Includes */
+#include "MB1_Kv.h"
+#include "string.h"
+using namespace Kv_ns;
+
+/* Private functions */
+static uint32_t kv_word_get (const uint8_t *buf);
+static void kv_word_put (uint8_t *buf, uint32_t word);
+
+/**<----------------------------- helpers ------------------------------------*/
+
+/**
+ * @brief kv_recordSize
+ * @param uint16_t len : value length, or tombstone_len.
+ * @return uint16_t : bytes in flash (header and padded value).
+ */
+uint16_t kv_recordSize (uint16_t len){
+    if (len == tombstone_len)
+        return recordHeader_size;
+
+    return recordHeader_size + ((len + 3) & ~0x03);
+}
+
+/**
+ * @brief kv_word_get, little-endian.
+ */
+static uint32_t kv_word_get (const uint8_t *buf){
+    return (uint32_t) buf[0] | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+/**
+ * @brief kv_word_put, little-endian.
+ */
+static void kv_word_put (uint8_t *buf, uint32_t word){
+    buf[0] = (uint8_t) word;
+    buf[1] = (uint8_t) (word >> 8);
+    buf[2] = (uint8_t) (word >> 16);
+    buf[3] = (uint8_t) (word >> 24);
+}
+
+/**<----------------------------- class KvStore ------------------------------------*/
+
+/**
+ * @brief KvStore
+ * @param const Kv_ns::io_s *io_p : flash access, must stay valid.
+ * @param Cobs_ns::crcWord_t crcWord_p : CRC_hwWord on target, cobs_crcWord_sw on host.
+ */
+KvStore::KvStore (const io_s *io_p, Cobs_ns::crcWord_t crcWord_p){
+    uint16_t count;
+
+    this->io_p = io_p;
+    this->crcWord_p = crcWord_p;
+
+    base = 0;
+    numOfSectors = 0;
+    seqNext = 1;
+
+    for (count = 0; count < keys_max; count++){
+        indexAddr[count] = addr_none;
+        indexLen[count] = 0;
+    }
+
+    freeSectors = 0;
+    active = sectors_max;
+    writePos = sector_size;
+    gcVictim = sectors_max;
+    gcPos = 0;
+
+    stats_reset ();
+}
+
+/**
+ * @brief mount, rebuild index and sector states from flash (after reset or power loss).
+ * @param uint32_t base : address of first sector, sector aligned.
+ * @param uint16_t numOfSectors : >= 3 (head, GC spare, data).
+ * @return Kv_ns::status_t : failed on read error or bad geometry.
+ */
+status_t KvStore::mount (uint32_t base, uint16_t numOfSectors){
+    uint8_t header [sectorHeader_size];
+    uint32_t crc, seqLast, eraseMax;
+    uint16_t sector, next, count;
+
+    if ((numOfSectors < 3) || (numOfSectors > sectors_max) || ((base % sector_size) != 0))
+        return failed;
+
+    this->base = base;
+    this->numOfSectors = numOfSectors;
+    for (count = 0; count < keys_max; count++){
+        indexAddr[count] = addr_none;
+        indexLen[count] = 0;
+    }
+    freeSectors = 0;
+    active = sectors_max;
+    writePos = sector_size;
+    gcVictim = sectors_max;
+    seqNext = 1;
+    eraseMax = 0;
+
+    /**< sector headers */
+    for (sector = 0; sector < numOfSectors; sector++){
+        sectorLive[sector] = 0;
+        sectorSeqs[sector] = 0;
+        sectorErases[sector] = 0;
+
+        if (!io_p->read_p (io_p->ctx, sector_addr (sector), header, sectorHeader_size))
+            return failed;
+
+        crc = Cobs_ns::crcInit;
+        for (count = 0; count < sectorHeader_size - 4; count += 4)
+            crc = crcWord_p (crc, kv_word_get (&header[count]));
+
+        if ((kv_word_get (header) == magic) && (kv_word_get (&header[12]) == crc) && (kv_word_get (&header[4]) != 0)){
+            sectorStates[sector] = sector_used;
+            sectorSeqs[sector] = kv_word_get (&header[4]);
+            sectorErases[sector] = kv_word_get (&header[8]);
+            if (sectorErases[sector] > eraseMax)
+                eraseMax = sectorErases[sector];
+            if (sectorSeqs[sector] >= seqNext)
+                seqNext = sectorSeqs[sector] + 1;
+        }
+        else if (sector_isBlank (sector)){
+            sectorStates[sector] = sector_free;
+            freeSectors++;
+        }
+        else
+            sectorStates[sector] = sector_dirty; // interrupted erase or header
+    }
+
+    /* erase count of sectors without header is lost, take the worst */
+    for (sector = 0; sector < numOfSectors; sector++){
+        if (sectorStates[sector] != sector_used)
+            sectorErases[sector] = eraseMax;
+    }
+
+    /**< replay sectors in seq order */
+    seqLast = 0;
+    while (1){
+        next = sectors_max;
+        for (sector = 0; sector < numOfSectors; sector++){
+            if ((sectorStates[sector] == sector_used) && (sectorSeqs[sector] > seqLast) &&
+                ((next == sectors_max) || (sectorSeqs[sector] < sectorSeqs[next])))
+                next = sector;
+        }
+        if (next == sectors_max)
+            break;
+
+        sector_scan (next);
+        seqLast = sectorSeqs[next];
+        active = next;
+    }
+
+    /* last sector is the head, writePos has been left by sector_scan */
+    if (active != sectors_max)
+        sectorStates[active] = sector_active;
+
+    return successful;
+}
+
+/**
+ * @brief format, erase all sectors of the store (blocking).
+ * @return Kv_ns::status_t
+ */
+status_t KvStore::format (void){
+    uint16_t sector, count;
+
+    if (numOfSectors == 0)
+        return failed;
+
+    io_wait ();
+    for (sector = 0; sector < numOfSectors; sector++){
+        if (sectorStates[sector] != sector_free){
+            sectorStates[sector] = sector_dirty;
+            sectorLive[sector] = 0;
+        }
+    }
+    for (count = 0; count < keys_max; count++){
+        indexAddr[count] = addr_none;
+        indexLen[count] = 0;
+    }
+    active = sectors_max;
+    writePos = sector_size;
+    gcVictim = sectors_max;
+
+    while (service ());
+
+    return successful;
+}
+
+/**
+ * @brief set, append a new value of key.
+ * @param uint16_t key : < keys_max.
+ * @param const uint8_t *value
+ * @param uint16_t len : <= value_max.
+ * @return Kv_ns::status_t : noSpace if live data don't fit anymore.
+ * @attention : waits for an erase started by service, runs GC itself if the last spare sector is needed.
+ */
+status_t KvStore::set (uint16_t key, const uint8_t *value, uint16_t len){
+    status_t retval;
+
+    if ((key >= keys_max) || (len > value_max) || ((value == NULL) && (len != 0)) || (numOfSectors == 0))
+        return failed;
+
+    retval = append (key, value, len, false);
+    if (retval == successful){
+        stats.sets++;
+        stats.userBytes += len;
+    }
+
+    return retval;
+}
+
+/**
+ * @brief get, last value of key (one flash read).
+ * @param uint16_t key
+ * @param uint8_t *value
+ * @param uint16_t size : of value buffer.
+ * @param uint16_t *len_p : length of the value, can be NULL.
+ * @return Kv_ns::status_t : notFound if key has no value, failed if size is too small.
+ */
+status_t KvStore::get (uint16_t key, uint8_t *value, uint16_t size, uint16_t *len_p){
+    if (key >= keys_max)
+        return failed;
+    if ((indexAddr[key] == addr_none) || (indexLen[key] == tombstone_len))
+        return notFound;
+
+    if (len_p != NULL)
+        *len_p = indexLen[key];
+    if (indexLen[key] > size)
+        return failed;
+    if (indexLen[key] == 0)
+        return successful;
+
+    io_wait ();
+    if (!io_p->read_p (io_p->ctx, indexAddr[key] + recordHeader_size, value, indexLen[key]))
+        return failed;
+
+    return successful;
+}
+
+/**
+ * @brief remove, append a tombstone of key.
+ * @param uint16_t key
+ * @return Kv_ns::status_t : notFound if key has no value.
+ */
+status_t KvStore::remove (uint16_t key){
+    status_t retval;
+
+    if ((key >= keys_max) || (numOfSectors == 0))
+        return failed;
+    if ((indexAddr[key] == addr_none) || (indexLen[key] == tombstone_len))
+        return notFound;
+
+    retval = append (key, NULL, tombstone_len, false);
+    if (retval == successful)
+        stats.removes++;
+
+    return retval;
+}
+
+/**
+ * @brief service, one step of background work : end of an erase, an erase, or one GC copy.
+ * @return bool : true if there is more work.
+ */
+bool KvStore::service (void){
+    uint8_t *header = recBuf;
+    uint32_t recAddr, word0;
+    uint16_t sector, key, len, size, oldest;
+
+    if (numOfSectors == 0)
+        return false;
+
+    /**< erase in progress */
+    for (sector = 0; sector < numOfSectors; sector++){
+        if (sectorStates[sector] != sector_erasing)
+            continue;
+        if ((io_p->busy_p != NULL) && io_p->busy_p (io_p->ctx))
+            return true;
+        sectorStates[sector] = sector_free;
+        freeSectors++;
+    }
+
+    /**< erase a dirty sector */
+    for (sector = 0; sector < numOfSectors; sector++){
+        if (sectorStates[sector] != sector_dirty)
+            continue;
+
+        io_wait ();
+        if (!io_p->erase_p (io_p->ctx, sector_addr (sector)))
+            return false;
+        sectorErases[sector]++;
+        stats.erases++;
+        sectorStates[sector] = sector_erasing;
+        if (io_p->busy_p == NULL){
+            sectorStates[sector] = sector_free;
+            freeSectors++;
+        }
+        return true;
+    }
+
+    /**< choose a victim : oldest used sector */
+    if (gcVictim == sectors_max){
+        if (freeSectors >= gcFree_min)
+            return false;
+
+        oldest = sectors_max;
+        for (sector = 0; sector < numOfSectors; sector++){
+            if ((sectorStates[sector] == sector_used) &&
+                ((oldest == sectors_max) || (sectorSeqs[sector] < sectorSeqs[oldest])))
+                oldest = sector;
+        }
+        if (oldest == sectors_max)
+            return false; // only the head is used
+        gcVictim = oldest;
+        gcPos = sectorHeader_size;
+    }
+
+    /**< one record of the victim */
+    recAddr = sector_addr (gcVictim) + gcPos;
+    word0 = 0xFFFFFFFF;
+    if (gcPos + recordHeader_size <= sector_size){
+        io_wait ();
+        if (!io_p->read_p (io_p->ctx, recAddr, header, recordHeader_size))
+            return false;
+        word0 = kv_word_get (header);
+    }
+
+    key = (uint16_t) word0;
+    len = (uint16_t) (word0 >> 16);
+    if ((word0 == 0xFFFFFFFF) || (key >= keys_max) || ((len > value_max) && (len != tombstone_len))){
+        /* end of victim, nothing live is left */
+        sectorStates[gcVictim] = sector_dirty;
+        sectorLive[gcVictim] = 0;
+        gcVictim = sectors_max;
+        return true;
+    }
+
+    size = kv_recordSize (len);
+    gcPos += size;
+
+    if (indexAddr[key] != recAddr)
+        return true; // old value
+
+    if (len == tombstone_len){
+        /* victim is the oldest sector, older values of key are erased with it */
+        sectorLive[gcVictim] -= size;
+        indexAddr[key] = addr_none;
+        indexLen[key] = 0;
+        return true;
+    }
+
+    if (!io_p->read_p (io_p->ctx, recAddr + recordHeader_size, &recBuf[recordHeader_size], len))
+        return false;
+    if (append (key, &recBuf[recordHeader_size], len, true) != successful)
+        return false;
+    stats.gcCopies++;
+    stats.gcBytes += size;
+
+    return true;
+}
+
+/**
+ * @brief stats_get
+ * @param Kv_ns::stats_t *stats_p
+ * @return None
+ */
+void KvStore::stats_get (stats_t *stats_p){
+    uint16_t sector;
+
+    stats.eraseCount_min = 0xFFFFFFFF;
+    stats.eraseCount_max = 0;
+    stats.liveBytes = 0;
+    for (sector = 0; sector < numOfSectors; sector++){
+        if (sectorErases[sector] < stats.eraseCount_min)
+            stats.eraseCount_min = sectorErases[sector];
+        if (sectorErases[sector] > stats.eraseCount_max)
+            stats.eraseCount_max = sectorErases[sector];
+        stats.liveBytes += sectorLive[sector];
+    }
+    if (numOfSectors == 0)
+        stats.eraseCount_min = 0;
+    stats.freeSectors = freeSectors;
+
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void KvStore::stats_reset (void){
+    memset (&stats, 0, sizeof (stats));
+}
+
+/**
+ * @brief sector_addr
+ */
+uint32_t KvStore::sector_addr (uint16_t sector){
+    return base + (uint32_t) sector * sector_size;
+}
+
+/**
+ * @brief sector_of, sector of an address of the store.
+ */
+uint16_t KvStore::sector_of (uint32_t addr){
+    return (uint16_t) ((addr - base) / sector_size);
+}
+
+/**
+ * @brief sector_open, new head : next free sector in ring order, header is programmed.
+ * @param bool isGC : GC copies may take the last spare sector.
+ * @return Kv_ns::status_t : noSpace if no sector can be freed.
+ */
+status_t KvStore::sector_open (bool isGC){
+    uint8_t header [sectorHeader_size];
+    uint32_t crc, erasesStart = stats.erases;
+    uint16_t sector, count;
+
+    /* keep a spare sector for GC, free one now if needed (a whole round without gain : full) */
+    while (!isGC && (freeSectors <= spare_min)){
+        if (!service () || (stats.erases - erasesStart > numOfSectors))
+            return noSpace;
+    }
+    if (freeSectors == 0)
+        return noSpace;
+
+    sector = (active == sectors_max) ? numOfSectors - 1 : active;
+    for (count = 0; count < numOfSectors; count++){
+        sector = (sector + 1 == numOfSectors) ? 0 : sector + 1;
+        if (sectorStates[sector] == sector_free)
+            break;
+    }
+
+    kv_word_put (&header[0], magic);
+    kv_word_put (&header[4], seqNext);
+    kv_word_put (&header[8], sectorErases[sector]);
+    crc = Cobs_ns::crcInit;
+    for (count = 0; count < sectorHeader_size - 4; count += 4)
+        crc = crcWord_p (crc, kv_word_get (&header[count]));
+    kv_word_put (&header[12], crc);
+
+    io_wait ();
+    if (!io_p->program_p (io_p->ctx, sector_addr (sector), header, sectorHeader_size)){
+        sectorStates[sector] = sector_dirty;
+        freeSectors--;
+        return failed;
+    }
+    stats.programmedBytes += sectorHeader_size;
+
+    if (active != sectors_max)
+        sectorStates[active] = sector_used;
+    sectorStates[sector] = sector_active;
+    sectorSeqs[sector] = seqNext++;
+    sectorLive[sector] = 0;
+    freeSectors--;
+    active = sector;
+    writePos = sectorHeader_size;
+
+    return successful;
+}
+
+/**
+ * @brief sector_scan, replay records of a sector into the index (mount).
+ * @return None
+ */
+void KvStore::sector_scan (uint16_t sector){
+    uint32_t pos = sectorHeader_size;
+    uint32_t word0, recAddr;
+    uint16_t key, len, size;
+
+    writePos = sector_size;
+
+    while (pos + recordHeader_size <= sector_size){
+        recAddr = sector_addr (sector) + pos;
+        if (!io_p->read_p (io_p->ctx, recAddr, recBuf, recordHeader_size))
+            return;
+
+        word0 = kv_word_get (recBuf);
+        if (word0 == 0xFFFFFFFF){
+            writePos = pos; // end of log in this sector
+            return;
+        }
+
+        key = (uint16_t) word0;
+        len = (uint16_t) (word0 >> 16);
+        size = kv_recordSize (len);
+        if ((key >= keys_max) || ((len > value_max) && (len != tombstone_len)) || (pos + size > sector_size)){
+            stats.corruptRecords++;
+            return; // sector is closed
+        }
+
+        if ((len != tombstone_len) && (len != 0) &&
+            !io_p->read_p (io_p->ctx, recAddr + recordHeader_size, &recBuf[recordHeader_size], size - recordHeader_size))
+            return;
+        if (record_crc (recBuf, len) != kv_word_get (&recBuf[4])){
+            stats.corruptRecords++;
+            return; // power loss while programming, sector is closed
+        }
+
+        index_update (key, recAddr, len);
+        stats.recoveredRecords++;
+        pos += size;
+    }
+}
+
+/**
+ * @brief sector_isBlank, all bytes are 0xFF.
+ * @return bool
+ */
+bool KvStore::sector_isBlank (uint16_t sector){
+    uint32_t pos;
+    uint16_t count;
+
+    for (pos = 0; pos < sector_size; pos += sizeof (recBuf) - 8){
+        count = sizeof (recBuf) - 8;
+        if (pos + count > sector_size)
+            count = sector_size - pos;
+        if (!io_p->read_p (io_p->ctx, sector_addr (sector) + pos, recBuf, count))
+            return false;
+        while (count != 0){
+            if (recBuf[--count] != 0xFF)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief append, program a record at the head, update index.
+ * @param bool isGC : copy of GC (value may be in recBuf already).
+ * @return Kv_ns::status_t
+ */
+status_t KvStore::append (uint16_t key, const uint8_t *value, uint16_t len, bool isGC){
+    uint16_t size = kv_recordSize (len);
+    uint16_t count;
+    uint32_t recAddr;
+    status_t retval;
+
+    if ((active == sectors_max) || (writePos + size > sector_size)){
+        retval = sector_open (isGC);
+        if (retval != successful)
+            return retval;
+    }
+
+    /* value first (it may be recBuf of GC), then header and padding */
+    if ((len != tombstone_len) && (len != 0)){
+        if (value != &recBuf[recordHeader_size])
+            memcpy (&recBuf[recordHeader_size], value, len);
+        for (count = recordHeader_size + len; count < size; count++)
+            recBuf[count] = 0xFF;
+    }
+    kv_word_put (&recBuf[0], (uint32_t) key | ((uint32_t) len << 16));
+    kv_word_put (&recBuf[4], record_crc (recBuf, len));
+
+    recAddr = sector_addr (active) + writePos;
+    io_wait ();
+    if (!io_p->program_p (io_p->ctx, recAddr, recBuf, size)){
+        writePos = sector_size; // unknown state, next record in a new sector
+        return failed;
+    }
+    writePos += size;
+    stats.programmedBytes += size;
+
+    index_update (key, recAddr, len);
+
+    return successful;
+}
+
+/**
+ * @brief index_update, new last record of key, live bytes of sectors follow.
+ * @return None
+ */
+void KvStore::index_update (uint16_t key, uint32_t addr, uint16_t len){
+    if (indexAddr[key] != addr_none)
+        sectorLive[sector_of (indexAddr[key])] -= kv_recordSize (indexLen[key]);
+
+    indexAddr[key] = addr;
+    indexLen[key] = len;
+    sectorLive[sector_of (addr)] += kv_recordSize (len);
+}
+
+/**
+ * @brief record_crc, CRC of header word and padded value of a record in a buffer.
+ * @param const uint8_t *rec
+ * @param uint16_t len
+ * @return uint32_t
+ */
+uint32_t KvStore::record_crc (const uint8_t *rec, uint16_t len){
+    uint32_t crc = Cobs_ns::crcInit;
+    uint16_t pos, size = kv_recordSize (len);
+
+    crc = crcWord_p (crc, kv_word_get (rec));
+    for (pos = recordHeader_size; pos < size; pos += 4)
+        crc = crcWord_p (crc, kv_word_get (&rec[pos]));
+
+    return crc;
+}
+
+/**
+ * @brief io_wait, wait for an erase started by service.
+ * @return None
+ */
+void KvStore::io_wait (void){
+    if (io_p->busy_p == NULL)
+        return;
+
+    while (io_p->busy_p (io_p->ctx));
+}
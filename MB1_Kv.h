@@ -0,0 +1,160 @@
+/**
+ * @file MB1_Kv.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is header file for a log-structured key-value store on SPI flash.
+ * Updates are appended, nothing is erased on the write path :
+ *      sector : | magic (4) | seq (4) | eraseCount (4) | CRC (4) | records ... | 0xFF ... |
+ *      record : | key (2) | len (2) | CRC (4) | value, padded to 4 bytes with 0xFF |
+ * little-endian, CRC-32 (STM32 CRC unit, see crcWord_t of MB1_Cobs.h) over all words but the CRC.
+ * len = tombstone_len : key has been removed.
+ * - RAM index : address and length of the last record of each key (keys < keys_max), get is one read.
+ * - Sectors are written in ring order, garbage collection takes the oldest sector (circular log),
+ *   copies its live records to the head, then erases it : all sectors wear at the same rate.
+ * - GC runs one record (or one erase) per service call, from the main loop, when there are less
+ *   than gcFree_min free sectors. set only runs GC itself when the last spare sector is needed.
+ * - mount rebuilds the index from the sectors in seq order. A record with a bad CRC (power loss
+ *   while programming) ends its sector, sectors without a valid header are erased before use.
+ * This file only depends on stdint.h and string.h, so host tools build the same code (io_s on
+ * a flash model, see MB1_KvBench.h).
+ * How to use this lib:
+ * - Target : kv_at25Io_set of MB1_KvTarget.h (AT25), then KvStore kv (&io, CRC_hwWord).
+ * - mount (base, numOfSectors), set/get/remove, service () in the main loop.
+ */
+
+#ifndef __MB1_KV_H
+#define __MB1_KV_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "MB1_Cobs.h"
+
+namespace Kv_ns {
+
+/**< config (compile-time) */
+const uint16_t keys_max = 64;
+const uint16_t sectors_max = 32;
+const uint32_t sector_size = 4096;      // erase unit
+const uint16_t value_max = 256;
+const uint8_t gcFree_min = 2;           // background GC below this
+const uint8_t spare_min = 1;            // only GC copies may take the last spare sector
+
+/**< layout */
+const uint32_t magic = 0x3130564B;      // "KV01"
+const uint8_t sectorHeader_size = 16;
+const uint8_t recordHeader_size = 8;
+const uint16_t tombstone_len = 0xFFFE;
+const uint32_t addr_none = 0xFFFFFFFF;
+
+typedef enum {
+    successful,
+    failed,
+    notFound,
+    noSpace
+} status_t;
+
+typedef enum {
+    sector_free,        // erased
+    sector_dirty,       // must be erased before use
+    sector_erasing,
+    sector_used,
+    sector_active       // head of the log
+} sectorState_t;
+
+/**< flash access, addresses are absolute */
+typedef bool (* read_t) (void *ctx, uint32_t addr, uint8_t *buf, uint32_t len);
+typedef bool (* program_t) (void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len);
+/**< erase one sector, may return before the end if busy_p isn't NULL */
+typedef bool (* erase_t) (void *ctx, uint32_t addr);
+typedef bool (* busy_t) (void *ctx);
+
+typedef struct {
+    void *ctx;
+    read_t read_p;
+    program_t program_p;
+    erase_t erase_p;
+    busy_t busy_p;      // NULL : erase_p is blocking
+} io_s;
+
+typedef struct {
+    uint32_t sets;
+    uint32_t removes;
+    uint32_t userBytes;                 // value bytes given to set
+    uint32_t programmedBytes;           // all bytes programmed (records, GC copies, sector headers)
+    uint32_t erases;
+    uint32_t gcCopies;
+    uint32_t gcBytes;
+    uint32_t recoveredRecords;
+    uint32_t corruptRecords;
+    uint32_t eraseCount_min;            // over sectors of the store
+    uint32_t eraseCount_max;
+    uint16_t freeSectors;
+    uint32_t liveBytes;
+} stats_t;
+
+}
+
+class KvStore {
+public:
+    KvStore (const Kv_ns::io_s *io_p, Cobs_ns::crcWord_t crcWord_p);
+
+    Kv_ns::status_t mount (uint32_t base, uint16_t numOfSectors);
+    Kv_ns::status_t format (void);
+
+    Kv_ns::status_t set (uint16_t key, const uint8_t *value, uint16_t len);
+    Kv_ns::status_t get (uint16_t key, uint8_t *value, uint16_t size, uint16_t *len_p);
+    Kv_ns::status_t remove (uint16_t key);
+
+    bool service (void);
+
+    void stats_get (Kv_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+private:
+    const Kv_ns::io_s *io_p;
+    Cobs_ns::crcWord_t crcWord_p;
+
+    uint32_t base;
+    uint16_t numOfSectors;
+    uint32_t seqNext;
+
+    /* index */
+    uint32_t indexAddr [Kv_ns::keys_max];
+    uint16_t indexLen [Kv_ns::keys_max];
+
+    /* sectors */
+    uint8_t sectorStates [Kv_ns::sectors_max];
+    uint32_t sectorSeqs [Kv_ns::sectors_max];
+    uint32_t sectorErases [Kv_ns::sectors_max];
+    uint16_t sectorLive [Kv_ns::sectors_max];
+    uint16_t freeSectors;
+
+    /* head */
+    uint16_t active;                    // sectors_max : none
+    uint32_t writePos;                  // offset in active sector
+
+    /* GC */
+    uint16_t gcVictim;                  // sectors_max : none
+    uint32_t gcPos;
+
+    uint8_t recBuf [Kv_ns::recordHeader_size + Kv_ns::value_max];
+    Kv_ns::stats_t stats;
+
+    uint32_t sector_addr (uint16_t sector);
+    uint16_t sector_of (uint32_t addr);
+    Kv_ns::status_t sector_open (bool isGC);
+    void sector_scan (uint16_t sector);
+    bool sector_isBlank (uint16_t sector);
+
+    Kv_ns::status_t append (uint16_t key, const uint8_t *value, uint16_t len, bool isGC);
+    void index_update (uint16_t key, uint32_t addr, uint16_t len);
+    uint32_t record_crc (const uint8_t *rec, uint16_t len);
+    void io_wait (void);
+};
+
+/* size of a record in flash */
+uint16_t kv_recordSize (uint16_t len);
+
+#endif // __MB1_KV_H
@@ -0,0 +1,340 @@
+/**
+ * @file MB1_KvBench.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is source file for a host benchmark of the key-value store on the AT25 model.
+ */
+
+/* Includes */
+#include "MB1_KvBench.h"
+#include "MB1_AT25Model.h"
+#include "MB1_Format.h"
+#include "string.h"
+using namespace KvBench_ns;
+
+/**< simulated flash : model and time */
+typedef struct {
+    AT25Model *model_p;
+    uint32_t now_us;
+    uint32_t bits;              // SPI bits not yet counted in now_us
+    uint32_t programmedBytes;
+} KvBench_flash_s;
+
+typedef struct {
+    uint32_t lat_sum;
+    uint32_t lat_max;
+    uint32_t programmedBytes;
+    uint32_t userBytes;
+    uint32_t erases;
+    uint32_t erase_min;
+    uint32_t erase_max;
+} KvBench_result_s;
+
+static const uint32_t KvBench_memSize = 65536;
+static uint8_t KvBench_mem [KvBench_memSize];
+
+/* Private functions */
+static void KvBench_time (KvBench_flash_s *flash_p, uint32_t us);
+static void KvBench_cmd (KvBench_flash_s *flash_p, const uint8_t *cmd, uint8_t cmdLen,
+                         const uint8_t *tx, uint8_t *rx, uint32_t len);
+static void KvBench_waitReady (KvBench_flash_s *flash_p);
+static bool KvBench_read (void *ctx, uint32_t addr, uint8_t *buf, uint32_t len);
+static bool KvBench_program (void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len);
+static bool KvBench_erase (void *ctx, uint32_t addr);
+static bool KvBench_eraseBlocking (void *ctx, uint32_t addr);
+static bool KvBench_busy (void *ctx);
+static void KvBench_value (uint8_t *value, uint16_t size, uint16_t key, uint16_t update);
+static void KvBench_run_kv (uint16_t size, KvBench_result_s *result_p);
+static void KvBench_run_rmw (uint16_t size, KvBench_result_s *result_p);
+static void KvBench_print (KvBench_ns::line_t line_p, void *ctx, const char *store, uint16_t size,
+                           const KvBench_result_s *result_p);
+
+/**
+ * @brief kv_bench, update latency and write amplification, kv and rmw, for each value size.
+ * @param KvBench_ns::line_t line_p : output of CSV lines.
+ * @param void *ctx : passed to line_p.
+ * @return None
+ */
+void kv_bench (line_t line_p, void *ctx){
+    KvBench_result_s result;
+    uint8_t count;
+
+    line_p (ctx, "kvbench,store,value_size,updates,lat_avg_us,lat_max_us,write_amp,erases,erase_min,erase_max");
+
+    for (count = 0; count < numOfSizes; count++){
+        KvBench_run_kv (sizes[count], &result);
+        KvBench_print (line_p, ctx, "kv", sizes[count], &result);
+
+        KvBench_run_rmw (sizes[count], &result);
+        KvBench_print (line_p, ctx, "rmw", sizes[count], &result);
+    }
+}
+
+/**
+ * @brief KvBench_run_kv, updates of numOfKeys keys in turn, application idle between updates.
+ * @return None
+ */
+static void KvBench_run_kv (uint16_t size, KvBench_result_s *result_p){
+    AT25Model model (KvBench_mem, KvBench_memSize);
+    KvBench_flash_s flash = {&model, 0, 0, 0};
+    Kv_ns::io_s io = {&flash, KvBench_read, KvBench_program, KvBench_erase, KvBench_busy};
+    KvStore kv (&io, cobs_crcWord_sw);
+    Kv_ns::stats_t stats;
+    uint8_t value [Kv_ns::value_max];
+    uint32_t start, lat;
+    uint16_t update;
+
+    memset (result_p, 0, sizeof (*result_p));
+    kv.mount (0, numOfSectors);
+
+    for (update = 0; update < updates; update++){
+        KvBench_value (value, size, update % numOfKeys, update);
+
+        start = flash.now_us;
+        kv.set (update % numOfKeys, value, size);
+        lat = flash.now_us - start;
+
+        result_p->lat_sum += lat;
+        if (lat > result_p->lat_max)
+            result_p->lat_max = lat;
+
+        /* idle time of the application, background work */
+        start = flash.now_us;
+        while (flash.now_us - start < interval_us){
+            if (!kv.service () && (flash.now_us - start < interval_us))
+                KvBench_time (&flash, poll_us);
+        }
+    }
+
+    kv.stats_get (&stats);
+    result_p->programmedBytes = stats.programmedBytes;
+    result_p->userBytes = stats.userBytes;
+    result_p->erases = stats.erases;
+    result_p->erase_min = stats.eraseCount_min;
+    result_p->erase_max = stats.eraseCount_max;
+}
+
+/**
+ * @brief KvBench_run_rmw, same updates, values at fixed places : read sector, erase, program sector.
+ * @return None
+ */
+static void KvBench_run_rmw (uint16_t size, KvBench_result_s *result_p){
+    AT25Model model (KvBench_mem, KvBench_memSize);
+    KvBench_flash_s flash = {&model, 0, 0, 0};
+    static uint8_t sector [Kv_ns::sector_size];
+    uint32_t sectorErases [numOfSectors];
+    uint32_t start, lat, addr;
+    uint16_t update, key, perSector, index;
+
+    memset (result_p, 0, sizeof (*result_p));
+    memset (sectorErases, 0, sizeof (sectorErases));
+    perSector = Kv_ns::sector_size / size;
+
+    for (update = 0; update < updates; update++){
+        key = update % numOfKeys;
+        index = key / perSector;
+        addr = (uint32_t) index * Kv_ns::sector_size;
+
+        start = flash.now_us;
+        KvBench_read (&flash, addr, sector, Kv_ns::sector_size);
+        KvBench_value (&sector[(key % perSector) * size], size, key, update);
+        KvBench_eraseBlocking (&flash, addr);
+        KvBench_program (&flash, addr, sector, Kv_ns::sector_size);
+        lat = flash.now_us - start;
+
+        sectorErases[index]++;
+        result_p->erases++;
+        result_p->userBytes += size;
+        result_p->lat_sum += lat;
+        if (lat > result_p->lat_max)
+            result_p->lat_max = lat;
+
+        KvBench_time (&flash, interval_us);
+    }
+
+    result_p->programmedBytes = flash.programmedBytes;
+    /* sectors which hold values */
+    result_p->erase_min = 0xFFFFFFFF;
+    for (index = 0; index <= (numOfKeys - 1) / perSector; index++){
+        if (sectorErases[index] < result_p->erase_min)
+            result_p->erase_min = sectorErases[index];
+        if (sectorErases[index] > result_p->erase_max)
+            result_p->erase_max = sectorErases[index];
+    }
+}
+
+/**
+ * @brief KvBench_print, one CSV line.
+ * @return None
+ */
+static void KvBench_print (line_t line_p, void *ctx, const char *store, uint16_t size,
+                           const KvBench_result_s *result_p){
+    char line [line_size];
+    uint16_t pos;
+    int32_t writeAmp_q8;
+
+    writeAmp_q8 = (result_p->userBytes == 0) ? 0 :
+                  (int32_t) (((uint64_t) result_p->programmedBytes << 8) / result_p->userBytes);
+
+    strcpy (line, "kvbench,");
+    strcat (line, store);
+    pos = strlen (line);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], size, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], updates, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], result_p->lat_sum / updates, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], result_p->lat_max, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_fixed (&line[pos], writeAmp_q8, 8, 2, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], result_p->erases, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], result_p->erase_min, 0, Fmt_ns::pad_space);
+    line[pos++] = ',';
+    pos += fmt_u32 (&line[pos], result_p->erase_max, 0, Fmt_ns::pad_space);
+    line[pos] = 0;
+
+    line_p (ctx, line);
+}
+
+/**
+ * @brief KvBench_value, a value which changes at each update.
+ * @return None
+ */
+static void KvBench_value (uint8_t *value, uint16_t size, uint16_t key, uint16_t update){
+    uint16_t count;
+
+    for (count = 0; count < size; count++)
+        value[count] = (uint8_t) (key * 31 + update + count);
+}
+
+/**
+ * @brief KvBench_time, time goes on for the model.
+ * @return None
+ */
+static void KvBench_time (KvBench_flash_s *flash_p, uint32_t us){
+    flash_p->model_p->tick_us (us);
+    flash_p->now_us += us;
+}
+
+/**
+ * @brief KvBench_cmd, one CS window : command bytes then data, SPI time is counted.
+ * @return None
+ */
+static void KvBench_cmd (KvBench_flash_s *flash_p, const uint8_t *cmd, uint8_t cmdLen,
+                         const uint8_t *tx, uint8_t *rx, uint32_t len){
+    uint32_t count;
+    uint8_t miso;
+
+    flash_p->model_p->cs_set (true);
+    for (count = 0; count < cmdLen; count++)
+        flash_p->model_p->transfer (cmd[count]);
+    for (count = 0; count < len; count++){
+        miso = flash_p->model_p->transfer ((tx != NULL) ? tx[count] : 0xFF);
+        if (rx != NULL)
+            rx[count] = miso;
+    }
+    flash_p->model_p->cs_set (false);
+
+    flash_p->bits += (cmdLen + len) * 8;
+    KvBench_time (flash_p, flash_p->bits / spi_MHz);
+    flash_p->bits %= spi_MHz;
+}
+
+/**
+ * @brief KvBench_waitReady, status polled every poll_us (at25_miscTIMISR).
+ * @return None
+ */
+static void KvBench_waitReady (KvBench_flash_s *flash_p){
+    const uint8_t statusCmd = 0x05;
+    uint8_t status;
+
+    do {
+        KvBench_time (flash_p, poll_us);
+        KvBench_cmd (flash_p, &statusCmd, 1, NULL, &status, 1);
+    } while ((status & 0x01) != 0);
+}
+
+/**
+ * @brief KvBench_read, fast read, like AT25::read.
+ */
+static bool KvBench_read (void *ctx, uint32_t addr, uint8_t *buf, uint32_t len){
+    KvBench_flash_s *flash_p = (KvBench_flash_s *) ctx;
+    uint8_t cmd [5] = {0x0B, (uint8_t) (addr >> 16), (uint8_t) (addr >> 8), (uint8_t) addr, 0};
+
+    KvBench_cmd (flash_p, cmd, 5, NULL, buf, len);
+
+    return true;
+}
+
+/**
+ * @brief KvBench_program, page by page, like AT25::program.
+ */
+static bool KvBench_program (void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len){
+    KvBench_flash_s *flash_p = (KvBench_flash_s *) ctx;
+    const uint8_t wren = 0x06;
+    uint8_t cmd [4];
+    uint32_t chunk;
+
+    while (len != 0){
+        chunk = AT25Model_ns::page_size - (addr % AT25Model_ns::page_size);
+        if (chunk > len)
+            chunk = len;
+
+        cmd[0] = 0x02;
+        cmd[1] = (uint8_t) (addr >> 16);
+        cmd[2] = (uint8_t) (addr >> 8);
+        cmd[3] = (uint8_t) addr;
+        KvBench_cmd (flash_p, &wren, 1, NULL, NULL, 0);
+        KvBench_cmd (flash_p, cmd, 4, buf, NULL, chunk);
+        KvBench_waitReady (flash_p);
+
+        flash_p->programmedBytes += chunk;
+        addr += chunk;
+        buf += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief KvBench_erase, start of a 4KB erase, like AT25::erase_start.
+ */
+static bool KvBench_erase (void *ctx, uint32_t addr){
+    KvBench_flash_s *flash_p = (KvBench_flash_s *) ctx;
+    const uint8_t wren = 0x06;
+    uint8_t cmd [4] = {0x20, (uint8_t) (addr >> 16), (uint8_t) (addr >> 8), (uint8_t) addr};
+
+    KvBench_cmd (flash_p, &wren, 1, NULL, NULL, 0);
+    KvBench_cmd (flash_p, cmd, 4, NULL, NULL, 0);
+
+    return true;
+}
+
+/**
+ * @brief KvBench_eraseBlocking, like AT25::erase.
+ */
+static bool KvBench_eraseBlocking (void *ctx, uint32_t addr){
+    KvBench_erase (ctx, addr);
+    KvBench_waitReady ((KvBench_flash_s *) ctx);
+
+    return true;
+}
+
+/**
+ * @brief KvBench_busy, like AT25::isBusy, a caller which spins on it lets time go on.
+ */
+static bool KvBench_busy (void *ctx){
+    KvBench_flash_s *flash_p = (KvBench_flash_s *) ctx;
+
+    if (!flash_p->model_p->isBusy ())
+        return false;
+
+    KvBench_time (flash_p, poll_us);
+    return true;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file MB1_KvBench.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is header file for a host benchmark of the key-value store (MB1_Kv.h) on the
+ * AT25 model (MB1_AT25Model.h), against read-modify-erase-write of a whole sector per update.
+ * Time is simulated : SPI bytes at spi_MHz, program/erase times of the model, BUSY polled
+ * every poll_us like at25_miscTIMISR. Between updates the application is idle for interval_us,
+ * KvStore::service runs then (GC, erases).
+ * Results are CSV lines :
+ *      kvbench,store,value_size,updates,lat_avg_us,lat_max_us,write_amp,erases,erase_min,erase_max
+ * store : kv or rmw, lat : time spent in one update, write_amp : bytes programmed / value bytes,
+ * erase_min/max : erase count of the least/most worn sector (of sectors which hold data for rmw).
+ * This file only depends on portable files, it builds on a host with MB1_Kv, MB1_AT25Model,
+ * MB1_Cobs and MB1_Format.
+ * How to use this lib:
+ * - kv_bench (line_p, ctx), line_p gets each NUL-terminated line (without end of line).
+ * - host/mb1_kvbench.cpp runs it on Linux (build line there).
+ */
+
+#ifndef __MB1_KVBENCH_H
+#define __MB1_KVBENCH_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "MB1_Kv.h"
+
+namespace KvBench_ns {
+
+/**< config (compile-time) */
+const uint32_t spi_MHz = 18;
+const uint32_t poll_us = 1000;
+const uint32_t interval_us = 20000;
+const uint16_t numOfSectors = 16;
+const uint16_t numOfKeys = 16;
+const uint16_t updates = 4000;
+const uint8_t numOfSizes = 3;
+const uint16_t sizes [numOfSizes] = {8, 32, 128};
+const uint16_t line_size = 128;
+
+typedef void (* line_t) (void *ctx, const char *line);
+
+}
+
+void kv_bench (KvBench_ns::line_t line_p, void *ctx);
+
+#endif // __MB1_KVBENCH_H
@@ -0,0 +1,63 @@
+/**
+ * @file MB1_KvTarget.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is source file for the key-value store (MB1_Kv.h) on an AT25 flash.
+ */
+
+/* Includes */
+#include "MB1_KvTarget.h"
+using namespace Kv_ns;
+
+/* Private functions */
+static bool KvTarget_read (void *ctx, uint32_t addr, uint8_t *buf, uint32_t len);
+static bool KvTarget_program (void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len);
+static bool KvTarget_erase (void *ctx, uint32_t addr);
+static bool KvTarget_busy (void *ctx);
+
+/**
+ * @brief kv_at25Io_set, flash access of KvStore on an AT25.
+ * @param Kv_ns::io_s *io_p : must stay valid while KvStore is used.
+ * @param AT25 *at25_p : has begun.
+ * @return None
+ */
+void kv_at25Io_set (io_s *io_p, AT25 *at25_p){
+    io_p->ctx = at25_p;
+    io_p->read_p = KvTarget_read;
+    io_p->program_p = KvTarget_program;
+    io_p->erase_p = KvTarget_erase;
+    io_p->busy_p = KvTarget_busy;
+}
+
+/**
+ * @brief KvTarget_read
+ * @param void *ctx : AT25.
+ */
+static bool KvTarget_read (void *ctx, uint32_t addr, uint8_t *buf, uint32_t len){
+    return (((AT25 *) ctx)->read (addr, buf, len) == AT25_ns::successful);
+}
+
+/**
+ * @brief KvTarget_program
+ * @param void *ctx : AT25.
+ */
+static bool KvTarget_program (void *ctx, uint32_t addr, const uint8_t *buf, uint32_t len){
+    return (((AT25 *) ctx)->program (addr, buf, len) == AT25_ns::successful);
+}
+
+/**
+ * @brief KvTarget_erase, start erase of one sector, KvStore checks KvTarget_busy.
+ * @param void *ctx : AT25.
+ */
+static bool KvTarget_erase (void *ctx, uint32_t addr){
+    return (((AT25 *) ctx)->erase_start (addr, sector_size, NULL, NULL) == AT25_ns::successful);
+}
+
+/**
+ * @brief KvTarget_busy
+ * @param void *ctx : AT25.
+ */
+static bool KvTarget_busy (void *ctx){
+    return ((AT25 *) ctx)->isBusy ();
+}
@@ -0,0 +1,26 @@
+/**
+ * @file MB1_KvTarget.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 17-10-2026
+ * @brief This is header file for the key-value store (MB1_Kv.h) on an AT25 flash.
+ * Reads and programs use the blocking AT25 calls, erases of GC are started by service and run
+ * while the application goes on (BUSY polled by at25_miscTIMISR).
+ * Record CRCs are computed by the STM32 CRC unit (CRC_hwWord, it turns the CRC clock on).
+ * How to use this lib:
+ * - at25Flash_1.begin ().
+ * - Kv_ns::io_s io; kv_at25Io_set (&io, &at25Flash_1); KvStore kv (&io, CRC_hwWord);
+ * - kv.mount (base, numOfSectors), then kv.service () in the main loop.
+ */
+
+#ifndef __MB1_KVTARGET_H
+#define __MB1_KVTARGET_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_AT25.h"
+#include "MB1_Kv.h"
+
+void kv_at25Io_set (Kv_ns::io_s *io_p, AT25 *at25_p);
+
+#endif // __MB1_KVTARGET_H
@@ -0,0 +1,135 @@
+/**
+ * @file MB1_Log.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for deferred-formatting binary logging on MBoard-1.
+ */
+
+/* Includes */
+#include "MB1_Log.h"
+using namespace Log_ns;
+
+/**< section tag, it also makes sure section mb1_log_fmt exists (for __start_mb1_log_fmt) */
+const char Log_ns::sectionTag [] __attribute__ ((section ("mb1_log_fmt"), used)) = "MB1_LOG v1";
+
+/**<----------------------------- class Logger ----------------------------------*/
+
+/**
+ * @brief Logger.
+ * @param Cobs_ns::sink_t sink_p : output of records (not NULL).
+ * @param void *sinkCtx : passed to sink_p.
+ * @param Log_ns::timestamp_t timestamp_p : NULL for timestamp = 0.
+ */
+Logger::Logger (Cobs_ns::sink_t sink_p, void *sinkCtx, timestamp_t timestamp_p)
+    : encoder (sink_p, sinkCtx, NULL){
+    this->timestamp_p = timestamp_p;
+
+    records = 0;
+    bytes = 0;
+}
+
+/**
+ * @brief record, send a record without arg. Use MB1_LOG, not this method.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @return None
+ */
+void Logger::record (const char *fmt){
+    record_send (fmt, 0, NULL);
+}
+
+/**
+ * @brief record, send a record with 1 arg. Use MB1_LOG, not this method.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @param uint32_t arg0
+ * @return None
+ */
+void Logger::record (const char *fmt, uint32_t arg0){
+    uint32_t args [1] = {arg0};
+
+    record_send (fmt, 1, args);
+}
+
+/**
+ * @brief record, send a record with 2 args. Use MB1_LOG, not this method.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @param uint32_t arg0, arg1
+ * @return None
+ */
+void Logger::record (const char *fmt, uint32_t arg0, uint32_t arg1){
+    uint32_t args [2] = {arg0, arg1};
+
+    record_send (fmt, 2, args);
+}
+
+/**
+ * @brief record, send a record with 3 args. Use MB1_LOG, not this method.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @param uint32_t arg0, arg1, arg2
+ * @return None
+ */
+void Logger::record (const char *fmt, uint32_t arg0, uint32_t arg1, uint32_t arg2){
+    uint32_t args [3] = {arg0, arg1, arg2};
+
+    record_send (fmt, 3, args);
+}
+
+/**
+ * @brief record, send a record with 4 args. Use MB1_LOG, not this method.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @param uint32_t arg0, arg1, arg2, arg3
+ * @return None
+ */
+void Logger::record (const char *fmt, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3){
+    uint32_t args [4] = {arg0, arg1, arg2, arg3};
+
+    record_send (fmt, 4, args);
+}
+
+/**
+ * @brief records_get, number of records sent.
+ * @return uint32_t
+ */
+uint32_t Logger::records_get (void){
+    return records;
+}
+
+/**
+ * @brief bytes_get, number of record bytes sent (before COBS), to compare with text logging.
+ * @return uint32_t
+ */
+uint32_t Logger::bytes_get (void){
+    return bytes;
+}
+
+/**
+ * @brief record_send, build a record and send it as a COBS frame.
+ * @param const char *fmt : format string in section mb1_log_fmt.
+ * @param uint8_t numOfArgs
+ * @param const uint32_t args[]
+ * @return None
+ */
+void Logger::record_send (const char *fmt, uint8_t numOfArgs, const uint32_t args[]){
+    uint8_t record [header_len + 4 * args_max];
+    uint16_t fmtId = (uint16_t) (fmt - __start_mb1_log_fmt);
+    uint32_t timestamp = (timestamp_p != NULL) ? timestamp_p () : 0;
+    uint8_t len, count, arg;
+
+    record[0] = (uint8_t) fmtId;
+    record[1] = (uint8_t) (fmtId >> 8);
+    for (count = 0; count < 4; count++)
+        record[2 + count] = (uint8_t) (timestamp >> (count * 8));
+
+    len = header_len;
+    for (arg = 0; arg < numOfArgs; arg++){
+        for (count = 0; count < 4; count++)
+            record[len++] = (uint8_t) (args[arg] >> (count * 8));
+    }
+
+    encoder.frame_begin ();
+    encoder.data_put (record, len);
+    encoder.frame_end ();
+
+    records++;
+    bytes += len;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file MB1_Log.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for deferred-formatting binary logging on MBoard-1.
+ * A log record only carries the id of its format string, a timestamp and the raw arguments,
+ * formatting is done on the host from the ELF file (MB1_LogDecode.h, host/mb1_logdecode.cpp).
+ * - Format strings are put in section "mb1_log_fmt", they are never sent.
+ * The section can be dropped from flash in the linker script :
+ *      mb1_log_fmt 0 (INFO) : { KEEP(*(mb1_log_fmt)) }
+ * - Record (payload of a COBS frame, see MB1_Cobs.h, no CRC by default), little-endian :
+ *      | fmtId (2 bytes) | timestamp (4 bytes, msec) | arg0 (4 bytes) | ... | argN (4 bytes) |
+ * fmtId is the offset of the format string in section mb1_log_fmt, number of args = (len - 6) / 4.
+ * Args are 32-bit words, %d %i %u %x %X %c and %p are supported by the host decoder.
+ * - The section holds Log_ns::sectionTag, so a host tool can check the ELF file.
+ * How to use this lib:
+ * - Declare a Logger with a sink (e.g. serial_t::Out_sink, &MB1_USART2) and a timestamp function (e.g. ticks_ms_get).
+ * - MB1_LOG (logger, "adc=%u temp=%d", adc, temp); up to Log_ns::args_max args.
+ * - Logger is not reentrant, log from one context (or from ISRs of one priority only).
+ */
+
+#ifndef __MB1_LOG_H
+#define __MB1_LOG_H
+
+/* Includes */
+#include "stdint.h"
+#include "MB1_Cobs.h"
+
+namespace Log_ns {
+
+/**< config (compile-time) */
+const uint8_t args_max = 4;
+const uint8_t header_len = 6; // fmtId + timestamp
+
+/**< first string of section mb1_log_fmt */
+extern const char sectionTag [];
+
+typedef uint32_t (* timestamp_t) (void);
+
+}
+
+/**< start of section mb1_log_fmt, made by the linker */
+extern "C" const char __start_mb1_log_fmt [];
+
+/**
+ * MB1_LOG (logger, fmt, args...), fmt must be a string literal, args are converted to uint32_t.
+ */
+#define MB1_LOG(logger, fmt, ...) \
+    do { \
+        static const char MB1_LOG_fmt [] __attribute__ ((section ("mb1_log_fmt"), used)) = fmt; \
+        (logger).record (MB1_LOG_fmt, ##__VA_ARGS__); \
+    } while (0)
+
+class Logger {
+public:
+    Logger (Cobs_ns::sink_t sink_p, void *sinkCtx, Log_ns::timestamp_t timestamp_p);
+
+    void record (const char *fmt);
+    void record (const char *fmt, uint32_t arg0);
+    void record (const char *fmt, uint32_t arg0, uint32_t arg1);
+    void record (const char *fmt, uint32_t arg0, uint32_t arg1, uint32_t arg2);
+    void record (const char *fmt, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+
+    uint32_t records_get (void);
+    uint32_t bytes_get (void);
+
+private:
+    CobsEncoder encoder;
+    Log_ns::timestamp_t timestamp_p;
+
+    uint32_t records;
+    uint32_t bytes;
+
+    void record_send (const char *fmt, uint8_t numOfArgs, const uint32_t args[]);
+};
+
+#endif // __MB1_LOG_H
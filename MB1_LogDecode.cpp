@@ -0,0 +1,360 @@
+/**
+ * @file MB1_LogDecode.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief This is source file for the host decoder of binary log records (MB1_Log.h).
+ */
+
+/* Includes */
+#include "MB1_LogDecode.h"
+#include "MB1_Format.h"
+#include "string.h"
+using namespace LogDec_ns;
+
+/* Private functions */
+static uint32_t LogDec_le_get (const uint8_t *buf, uint8_t numOfBytes);
+static void LogDec_str_put (char *line, uint16_t *pos_p, const char *str, uint16_t len);
+
+/**
+ * @brief logDec_elfSection_find, find a section by name in an ELF file (32 or 64-bit, little-endian).
+ * @param const uint8_t *elf, uint32_t elfLen : whole ELF file.
+ * @param const char *name : e.g. LogDec_ns::sectionName.
+ * @param uint32_t *offset_p, uint32_t *size_p : place of the section content in elf.
+ * @return LogDec_ns::status_t : failed if not an ELF file, section not found or without content.
+ */
+status_t logDec_elfSection_find (const uint8_t *elf, uint32_t elfLen, const char *name,
+                                 uint32_t *offset_p, uint32_t *size_p){
+    bool is64;
+    uint32_t shOff, shEntSize, shNum, shStrIndex;
+    uint32_t strOff, strSize, entry, nameOff, secOff, secSize;
+    uint32_t index;
+    uint32_t nameLen = strlen (name);
+
+    if ((elfLen < 64) || (memcmp (elf, "\x7f" "ELF", 4) != 0) || (elf[5] != 1))
+        return failed;
+
+    is64 = (elf[4] == 2);
+    if (is64){
+        shOff = LogDec_le_get (&elf[0x28], 4);
+        if (LogDec_le_get (&elf[0x2C], 4) != 0)
+            return failed;
+        shEntSize = LogDec_le_get (&elf[0x3A], 2);
+        shNum = LogDec_le_get (&elf[0x3C], 2);
+        shStrIndex = LogDec_le_get (&elf[0x3E], 2);
+    }
+    else {
+        shOff = LogDec_le_get (&elf[0x20], 4);
+        shEntSize = LogDec_le_get (&elf[0x2E], 2);
+        shNum = LogDec_le_get (&elf[0x30], 2);
+        shStrIndex = LogDec_le_get (&elf[0x32], 2);
+    }
+
+    if ((shEntSize < (is64 ? 64U : 40U)) || (shStrIndex >= shNum) ||
+        (shOff > elfLen) || ((elfLen - shOff) / shEntSize < shNum))
+        return failed;
+
+    /* section name table */
+    entry = shOff + shStrIndex * shEntSize;
+    strOff = LogDec_le_get (&elf[entry + (is64 ? 0x18 : 0x10)], 4);
+    strSize = LogDec_le_get (&elf[entry + (is64 ? 0x20 : 0x14)], 4);
+    if ((strOff > elfLen) || (strSize > elfLen - strOff))
+        return failed;
+
+    for (index = 0; index < shNum; index++){
+        entry = shOff + index * shEntSize;
+        nameOff = LogDec_le_get (&elf[entry], 4);
+        if ((nameOff >= strSize) || (strSize - nameOff <= nameLen))
+            continue;
+        if ((memcmp (&elf[strOff + nameOff], name, nameLen) != 0) || (elf[strOff + nameOff + nameLen] != '\0'))
+            continue;
+
+        /* SHT_NOBITS has no content in the file */
+        if (LogDec_le_get (&elf[entry + 4], 4) == 8)
+            return failed;
+
+        secOff = LogDec_le_get (&elf[entry + (is64 ? 0x18 : 0x10)], 4);
+        secSize = LogDec_le_get (&elf[entry + (is64 ? 0x20 : 0x14)], 4);
+        if ((secOff > elfLen) || (secSize > elfLen - secOff))
+            return failed;
+
+        *offset_p = secOff;
+        *size_p = secSize;
+        return successful;
+    }
+
+    return failed;
+}
+
+/**<----------------------------- class LogDecoder ----------------------------------*/
+
+/**
+ * @brief LogDecoder.
+ * @param LogDec_ns::line_t line_p : output of decoded lines (not NULL).
+ * @param void *ctx : passed to line_p.
+ */
+LogDecoder::LogDecoder (line_t line_p, void *ctx)
+    : decoder (frameBuf, frame_max, NULL){
+    this->line_p = line_p;
+    this->ctx = ctx;
+    section = NULL;
+    size = 0;
+
+    records = 0;
+    errors = 0;
+}
+
+/**
+ * @brief fmt_set, format strings (content of section mb1_log_fmt).
+ * @param const char *section, uint32_t size : must stay valid while decoding.
+ * @return LogDec_ns::status_t : failed if Log_ns::sectionTag isn't in the section.
+ */
+status_t LogDecoder::fmt_set (const char *section, uint32_t size){
+    uint32_t tagLen = strlen (Log_ns::sectionTag) + 1;
+    uint32_t pos = 0;
+
+    /* strings are NUL-separated, the tag is one of them (its place depends on the link order) */
+    while ((pos < size) && (size - pos >= tagLen)){
+        if (memcmp (&section[pos], Log_ns::sectionTag, tagLen) == 0){
+            this->section = section;
+            this->size = size;
+            return successful;
+        }
+        while ((pos < size) && (section[pos] != '\0'))
+            pos++;
+        while ((pos < size) && (section[pos] == '\0'))
+            pos++;
+    }
+
+    return failed;
+}
+
+/**
+ * @brief data_put, one captured byte, a line is output at the end of each record.
+ * @param uint8_t data
+ * @return None
+ */
+void LogDecoder::data_put (uint8_t data){
+    const uint8_t *record;
+    uint16_t len;
+
+    if (decoder.data_put (data) != Cobs_ns::frameReady)
+        return;
+
+    len = decoder.frame_get (&record);
+    record_decode (record, len);
+}
+
+/**
+ * @brief data_put, captured bytes.
+ * @param const uint8_t *buf, uint32_t len
+ * @return None
+ */
+void LogDecoder::data_put (const uint8_t *buf, uint32_t len){
+    uint32_t count;
+
+    for (count = 0; count < len; count++)
+        data_put (buf[count]);
+}
+
+/**
+ * @brief records_get, number of records decoded.
+ * @return uint32_t
+ */
+uint32_t LogDecoder::records_get (void){
+    return records;
+}
+
+/**
+ * @brief errors_get, records with a bad fmtId or a bad length, missing args, broken frames.
+ * @return uint32_t
+ */
+uint32_t LogDecoder::errors_get (void){
+    return errors + decoder.otherErrors_get ();
+}
+
+/**
+ * @brief record_decode, format one record and output it.
+ * @param const uint8_t *record, uint16_t len
+ * @return None
+ */
+void LogDecoder::record_decode (const uint8_t *record, uint16_t len){
+    char line [line_max];
+    char num [Fmt_ns::bufLen_max];
+    uint32_t args [Log_ns::args_max];
+    uint32_t fmtId;
+    uint16_t pos = 0;
+    uint8_t numOfArgs, count;
+
+    records++;
+
+    if ((len < Log_ns::header_len) || ((len - Log_ns::header_len) % 4 != 0) ||
+        ((len - Log_ns::header_len) / 4 > Log_ns::args_max)){
+        errors++;
+        LogDec_str_put (line, &pos, "<bad record>", 12);
+        line_p (ctx, line);
+        return;
+    }
+
+    fmtId = LogDec_le_get (record, 2);
+    numOfArgs = (len - Log_ns::header_len) / 4;
+    for (count = 0; count < numOfArgs; count++)
+        args[count] = LogDec_le_get (&record[Log_ns::header_len + 4 * count], 4);
+
+    LogDec_str_put (line, &pos, "[", 1);
+    LogDec_str_put (line, &pos, num, fmt_u32 (num, LogDec_le_get (&record[2], 4), 0, Fmt_ns::pad_space));
+    LogDec_str_put (line, &pos, "] ", 2);
+
+    /* fmtId must point to a string of the section */
+    if ((section == NULL) || (fmtId >= size) || (memchr (&section[fmtId], '\0', size - fmtId) == NULL)){
+        errors++;
+        LogDec_str_put (line, &pos, "<bad fmtId 0x", 13);
+        LogDec_str_put (line, &pos, num, fmt_hex (num, fmtId, 4, Fmt_ns::pad_zero));
+        LogDec_str_put (line, &pos, ">", 1);
+    }
+    else if (!text_format (line, &pos, &section[fmtId], args, numOfArgs))
+        errors++;
+
+    line_p (ctx, line);
+}
+
+/**
+ * @brief text_format, printf-like formatting of 32-bit args.
+ * @param char *line, uint16_t *pos_p : output, NUL-terminated.
+ * @param const char *fmt
+ * @param const uint32_t args[], uint8_t numOfArgs
+ * @return bool : false if fmt needs more args (missing ones are printed "<?>").
+ */
+bool LogDecoder::text_format (char *line, uint16_t *pos_p, const char *fmt, const uint32_t args[], uint8_t numOfArgs){
+    char num [Fmt_ns::bufLen_max];
+    Fmt_ns::pad_t pad;
+    uint8_t width, leftWidth, argId = 0, len, count;
+    uint32_t arg;
+    char conv;
+    bool isLeft;
+    bool retval = true;
+
+    while (*fmt != '\0'){
+        if (*fmt != '%'){
+            LogDec_str_put (line, pos_p, fmt++, 1);
+            continue;
+        }
+
+        fmt++;
+        if (*fmt == '%'){
+            LogDec_str_put (line, pos_p, fmt++, 1);
+            continue;
+        }
+
+        pad = Fmt_ns::pad_space;
+        isLeft = false;
+        while ((*fmt == '0') || (*fmt == '-')){
+            if (*fmt == '0')
+                pad = Fmt_ns::pad_zero;
+            else
+                isLeft = true;
+            fmt++;
+        }
+        width = 0;
+        while ((*fmt >= '0') && (*fmt <= '9')){
+            if (width < Fmt_ns::width_max)
+                width = width * 10 + (*fmt - '0');
+            fmt++;
+        }
+        while ((*fmt == 'l') || (*fmt == 'h'))
+            fmt++;
+
+        conv = *fmt;
+        if (conv == '\0')
+            break;
+        fmt++;
+
+        if (argId >= numOfArgs){
+            LogDec_str_put (line, pos_p, "<?>", 3);
+            retval = false;
+            continue;
+        }
+        arg = args[argId++];
+
+        /* left-justified : number without padding, spaces after it */
+        leftWidth = 0;
+        if (isLeft){
+            leftWidth = width;
+            width = 0;
+        }
+
+        switch (conv){
+        case 'd':
+        case 'i':
+            len = fmt_i32 (num, (int32_t) arg, width, pad);
+            break;
+        case 'u':
+            len = fmt_u32 (num, arg, width, pad);
+            break;
+        case 'x':
+        case 'X':
+            len = fmt_hex (num, arg, width, pad);
+            if (conv == 'x'){
+                for (count = 0; count < len; count++){
+                    if ((num[count] >= 'A') && (num[count] <= 'F'))
+                        num[count] += 'a' - 'A';
+                }
+            }
+            break;
+        case 'c':
+            num[0] = (char) arg;
+            len = 1;
+            break;
+        case 'p':
+            LogDec_str_put (line, pos_p, "0x", 2);
+            len = fmt_hex (num, arg, 8, Fmt_ns::pad_zero);
+            break;
+        default:
+            /* unknown conversion, copied as is */
+            num[0] = '%';
+            num[1] = conv;
+            len = 2;
+            argId--;
+            break;
+        }
+        LogDec_str_put (line, pos_p, num, len);
+
+        while (leftWidth > len){
+            LogDec_str_put (line, pos_p, " ", 1);
+            leftWidth--;
+        }
+    }
+
+    return retval;
+}
+
+/**
+ * @brief LogDec_le_get, little-endian number.
+ * @param const uint8_t *buf
+ * @param uint8_t numOfBytes : 1 to 4.
+ * @return uint32_t
+ */
+static uint32_t LogDec_le_get (const uint8_t *buf, uint8_t numOfBytes){
+    uint32_t value = 0;
+
+    while (numOfBytes > 0){
+        numOfBytes--;
+        value = (value << 8) | buf[numOfBytes];
+    }
+
+    return value;
+}
+
+/**
+ * @brief LogDec_str_put, append chars to a line, the line is cut at line_max - 1 chars.
+ * @param char *line, uint16_t *pos_p : line and its length.
+ * @param const char *str, uint16_t len
+ * @return None
+ */
+static void LogDec_str_put (char *line, uint16_t *pos_p, const char *str, uint16_t len){
+    while ((len > 0) && (*pos_p < line_max - 1)){
+        line[(*pos_p)++] = *str++;
+        len--;
+    }
+    line[*pos_p] = '\0';
+}
@@ -0,0 +1,77 @@
+/**
+ * @file MB1_LogDecode.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief This is header file for the host decoder of binary log records (MB1_Log.h).
+ * Captured bytes (COBS frames, no CRC) are decoded back to text lines :
+ *      [timestamp_ms] formatted text
+ * Format strings are read from section mb1_log_fmt of the firmware ELF file (ELF32 or ELF64,
+ * little-endian), fmtId of a record is the offset of its string in the section.
+ * Supported conversions : %d %i %u %x %X %c %p %%, flags '0' and '-', width, 'l'/'h' are ignored.
+ * A record with a bad fmtId, or with less args than its format, is printed with "<...>" and
+ * counted as an error.
+ * This file only depends on portable files (MB1_Cobs, MB1_Format), host tools build it,
+ * see host/mb1_logdecode.cpp.
+ * How to use this lib:
+ * - logDec_elfSection_find (elf, elfLen, "mb1_log_fmt", &offset, &size), or load a raw dump of
+ *   the section (objcopy, see host/mb1_logdecode.cpp).
+ * - LogDecoder decoder (line_p, ctx); fmt_set (section, size); data_put every captured byte.
+ */
+
+#ifndef __MB1_LOGDECODE_H
+#define __MB1_LOGDECODE_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "MB1_Log.h"
+
+namespace LogDec_ns {
+
+/**< config (compile-time) */
+const uint16_t line_max = 200;              // including NUL, longer lines are cut
+const uint16_t frame_max = 64;              // bigger frames are dropped by the COBS decoder
+const char sectionName [] = "mb1_log_fmt";
+
+typedef enum {
+    successful,
+    failed
+} status_t;
+
+/**< output of decoder, line is NUL-terminated, without end of line */
+typedef void (* line_t) (void *ctx, const char *line);
+
+}
+
+LogDec_ns::status_t logDec_elfSection_find (const uint8_t *elf, uint32_t elfLen, const char *name,
+                                            uint32_t *offset_p, uint32_t *size_p);
+
+class LogDecoder {
+public:
+    LogDecoder (LogDec_ns::line_t line_p, void *ctx);
+
+    LogDec_ns::status_t fmt_set (const char *section, uint32_t size);
+    void data_put (uint8_t data);
+    void data_put (const uint8_t *buf, uint32_t len);
+
+    uint32_t records_get (void);
+    uint32_t errors_get (void);
+
+private:
+    CobsDecoder decoder;
+    uint8_t frameBuf [LogDec_ns::frame_max];
+
+    LogDec_ns::line_t line_p;
+    void *ctx;
+    const char *section;
+    uint32_t size;
+
+    uint32_t records;
+    uint32_t errors;
+
+    void record_decode (const uint8_t *record, uint16_t len);
+    bool text_format (char *line, uint16_t *pos_p, const char *fmt, const uint32_t args[], uint8_t numOfArgs);
+};
+
+#endif // __MB1_LOGDECODE_H
@@ -0,0 +1,325 @@
+/**
+ * @file MB1_Lz.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for streaming LZSS compression (heatshrink-like) of serial output.
+ */
+
+/* Includes */
+#include "MB1_Lz.h"
+using namespace Lz_ns;
+
+/**<----------------------------- class LzEncoder -------------------------------*/
+
+/**
+ * @brief LzEncoder.
+ * @param Lz_ns::sink_t sink_p : output of compressed bytes (not NULL).
+ * @param void *sinkCtx : passed to sink_p.
+ * @param Lz_ns::cycles_t cycles_p : NULL if cycles are not counted.
+ */
+LzEncoder::LzEncoder (sink_t sink_p, void *sinkCtx, cycles_t cycles_p){
+    this->sink_p = sink_p;
+    this->sinkCtx = sinkCtx;
+    this->cycles_p = cycles_p;
+
+    reset ();
+    stats_reset ();
+}
+
+/**
+ * @brief data_put, put 1 byte.
+ * @param uint8_t data
+ * @return None
+ */
+void LzEncoder::data_put (uint8_t data){
+    uint32_t start = 0;
+
+    if (cycles_p != NULL)
+        start = cycles_p ();
+
+    byte_put (data);
+
+    if (cycles_p != NULL)
+        stats.cycles += cycles_p () - start;
+}
+
+/**
+ * @brief data_put, put a buffer.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void LzEncoder::data_put (const uint8_t *buf, uint16_t len){
+    uint32_t start = 0;
+    uint16_t count;
+
+    if (cycles_p != NULL)
+        start = cycles_p ();
+
+    for (count = 0; count < len; count++)
+        byte_put (buf[count]);
+
+    if (cycles_p != NULL)
+        stats.cycles += cycles_p () - start;
+}
+
+/**
+ * @brief flush, encode all bytes in lookahead and end the block (pad last byte).
+ * @return None
+ */
+void LzEncoder::flush (void){
+    uint32_t start = 0;
+
+    if (cycles_p != NULL)
+        start = cycles_p ();
+
+    while (laLen > 0)
+        step ();
+
+    if (bitCount > 0)
+        bits_put (0, 8 - bitCount);
+    out_flush ();
+
+    if (cycles_p != NULL)
+        stats.cycles += cycles_p () - start;
+}
+
+/**
+ * @brief reset, forget history, bytes not flushed are lost.
+ * @return None
+ */
+void LzEncoder::reset (void){
+    winPos = 0;
+    winFill = 0;
+    laLen = 0;
+    bitBuf = 0;
+    bitCount = 0;
+    outLen = 0;
+}
+
+/**
+ * @brief stats_get
+ * @param Lz_ns::stats_t *stats_p
+ * @return None
+ */
+void LzEncoder::stats_get (stats_t *stats_p){
+    *stats_p = stats;
+}
+
+/**
+ * @brief stats_reset
+ * @return None
+ */
+void LzEncoder::stats_reset (void){
+    stats.bytesIn = 0;
+    stats.bytesOut = 0;
+    stats.cycles = 0;
+}
+
+/**
+ * @brief In_sink, put a buffer to the encoder given by encoderObj.
+ * @param void *encoderObj : LzEncoder.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void LzEncoder::In_sink (void *encoderObj, const uint8_t *buf, uint16_t len){
+    ((LzEncoder *) encoderObj)->data_put (buf, len);
+}
+
+/**
+ * @brief byte_put, add 1 byte to lookahead, encode when lookahead is full.
+ * @param uint8_t data
+ * @return None
+ */
+void LzEncoder::byte_put (uint8_t data){
+    lookahead[laLen++] = data;
+    stats.bytesIn++;
+
+    if (laLen == match_max)
+        step ();
+}
+
+/**
+ * @brief step, encode the head of lookahead as a literal or a backref, move it to window.
+ * Matches may run into lookahead (distance < length), decoder copies byte by byte.
+ * @return None
+ */
+void LzEncoder::step (void){
+    uint16_t dist, bestDist = 0;
+    uint8_t len, bestLen = 0;
+    uint8_t pos, count;
+
+    for (dist = 1; dist <= winFill; dist++){
+        pos = (uint8_t) (winPos - dist);
+        if (window[pos] != lookahead[0])
+            continue;
+
+        for (len = 1; len < laLen; len++){
+            if (len < dist){
+                if (window[(uint8_t) (pos + len)] != lookahead[len])
+                    break;
+            }
+            else if (lookahead[len - dist] != lookahead[len])
+                break;
+        }
+
+        if (len > bestLen){
+            bestLen = len;
+            bestDist = dist;
+            if (len == laLen)
+                break;
+        }
+    }
+
+    if (bestLen >= match_min){
+        bits_put (0, 1);
+        bits_put (bestDist - 1, window_bits);
+        bits_put (bestLen - match_min, length_bits);
+    }
+    else {
+        bestLen = 1;
+        bits_put (0x100 | lookahead[0], 9);
+    }
+
+    /* move matched bytes to window */
+    for (count = 0; count < bestLen; count++){
+        window[winPos++] = lookahead[count];
+        if (winFill < window_size)
+            winFill++;
+    }
+    for (count = bestLen; count < laLen; count++)
+        lookahead[count - bestLen] = lookahead[count];
+    laLen -= bestLen;
+}
+
+/**
+ * @brief bits_put, add bits to output, MSB first.
+ * @param uint32_t bits
+ * @param uint8_t numOfBits : <= 16.
+ * @return None
+ */
+void LzEncoder::bits_put (uint32_t bits, uint8_t numOfBits){
+    bitBuf = (bitBuf << numOfBits) | (bits & ((1UL << numOfBits) - 1));
+    bitCount += numOfBits;
+
+    while (bitCount >= 8){
+        bitCount -= 8;
+        outBuf[outLen++] = (uint8_t) (bitBuf >> bitCount);
+        stats.bytesOut++;
+        if (outLen == outBuf_size)
+            out_flush ();
+    }
+}
+
+/**
+ * @brief out_flush, send outBuf to sink.
+ * @return None
+ */
+void LzEncoder::out_flush (void){
+    if (outLen == 0)
+        return;
+
+    sink_p (sinkCtx, outBuf, outLen);
+    outLen = 0;
+}
+
+/**<----------------------------- class LzDecoder -------------------------------*/
+
+/**
+ * @brief LzDecoder.
+ * @param Lz_ns::sink_t sink_p : output of plain bytes (not NULL).
+ * @param void *sinkCtx : passed to sink_p.
+ */
+LzDecoder::LzDecoder (sink_t sink_p, void *sinkCtx){
+    this->sink_p = sink_p;
+    this->sinkCtx = sinkCtx;
+
+    reset ();
+}
+
+/**
+ * @brief data_put, decode compressed bytes, plain bytes go to sink_p.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void LzDecoder::data_put (const uint8_t *buf, uint16_t len){
+    uint16_t count;
+    uint8_t dist, matchLen;
+
+    for (count = 0; count < len; count++){
+        bitBuf = (bitBuf << 8) | buf[count];
+        bitCount += 8;
+
+        /* literal needs 9 bits, backref needs 13 bits */
+        while (bitCount >= 9){
+            if ((bitBuf >> (bitCount - 1)) & 0x01){
+                bitCount -= 9;
+                byte_out ((uint8_t) (bitBuf >> bitCount));
+            }
+            else {
+                if (bitCount < 1 + window_bits + length_bits)
+                    break;
+                bitCount -= 1 + window_bits + length_bits;
+                dist = (uint8_t) (bitBuf >> (bitCount + length_bits)) + 1;
+                matchLen = (uint8_t) ((bitBuf >> bitCount) & ((1 << length_bits) - 1)) + match_min;
+
+                while (matchLen-- > 0)
+                    byte_out (window[(uint8_t) (winPos - dist)]);
+            }
+        }
+    }
+
+    out_flush ();
+}
+
+/**
+ * @brief block_end, drop padding bits at end of a block.
+ * @return None
+ */
+void LzDecoder::block_end (void){
+    bitBuf = 0;
+    bitCount = 0;
+}
+
+/**
+ * @brief reset, forget history.
+ * @return None
+ */
+void LzDecoder::reset (void){
+    uint16_t count;
+
+    for (count = 0; count < window_size; count++)
+        window[count] = 0;
+    winPos = 0;
+    bitBuf = 0;
+    bitCount = 0;
+    outLen = 0;
+}
+
+/**
+ * @brief byte_out, add 1 decoded byte to window and output.
+ * @param uint8_t data
+ * @return None
+ */
+void LzDecoder::byte_out (uint8_t data){
+    window[winPos++] = data;
+
+    outBuf[outLen++] = data;
+    if (outLen == outBuf_size)
+        out_flush ();
+}
+
+/**
+ * @brief out_flush, send outBuf to sink.
+ * @return None
+ */
+void LzDecoder::out_flush (void){
+    if (outLen == 0)
+        return;
+
+    sink_p (sinkCtx, outBuf, outLen);
+    outLen = 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file MB1_Lz.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for streaming LZSS compression (heatshrink-like) of serial output.
+ * Window is 256 bytes, matches are 2 to 17 bytes. Encoder needs ~300 bytes of RAM, decoder ~270 bytes.
+ * Bit stream, MSB first :
+ *      literal   : 1, byte (8 bits)
+ *      backref   : 0, distance - 1 (8 bits), length - 2 (4 bits)
+ * flush ends a block, last byte is padded with 0 bits, decoder must be told by block_end
+ * (e.g. one block per COBS frame). History is kept between blocks, so both sides must reset
+ * together if a block is lost.
+ * This file only depends on stdint.h, so host tools build the same encoder/decoder.
+ * How to use this lib:
+ * - Encoder : data_put (or In_sink as sink of other layers), flush at end of a block.
+ *   Compressed bytes go to sink_p (e.g. serial_t::Out_sink).
+ * - Decoder : data_put compressed bytes, block_end at end of a block. Plain bytes go to sink_p.
+ * - stats_get : bytes in/out and cycles (with cycles_p, e.g. cycles_get of MB1_Misc.h),
+ *   ratio = bytesOut / bytesIn, cycles per byte = cycles / bytesIn.
+ */
+
+#ifndef __MB1_LZ_H
+#define __MB1_LZ_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+
+namespace Lz_ns {
+
+/**< config (compile-time) */
+const uint8_t window_bits = 8;
+const uint16_t window_size = 1 << window_bits;
+const uint8_t length_bits = 4;
+const uint8_t match_min = 2;
+const uint8_t match_max = match_min + (1 << length_bits) - 1;
+const uint8_t outBuf_size = 16;
+
+/**< output, same as Cobs_ns::sink_t */
+typedef void (* sink_t) (void *sinkCtx, const uint8_t *buf, uint16_t len);
+
+/**< free-running cycle counter, for stats */
+typedef uint32_t (* cycles_t) (void);
+
+typedef struct {
+    uint32_t bytesIn;
+    uint32_t bytesOut;
+    uint32_t cycles;    // 0 without cycles_p
+} stats_t;
+
+}
+
+class LzEncoder {
+public:
+    LzEncoder (Lz_ns::sink_t sink_p, void *sinkCtx, Lz_ns::cycles_t cycles_p);
+
+    void data_put (uint8_t data);
+    void data_put (const uint8_t *buf, uint16_t len);
+    void flush (void);
+    void reset (void);
+
+    void stats_get (Lz_ns::stats_t *stats_p);
+    void stats_reset (void);
+
+    /**< sink for stream layers (e.g. Logger), encoderObj is a LzEncoder* */
+    static void In_sink (void *encoderObj, const uint8_t *buf, uint16_t len);
+
+private:
+    Lz_ns::sink_t sink_p;
+    void *sinkCtx;
+    Lz_ns::cycles_t cycles_p;
+
+    uint8_t window [Lz_ns::window_size];
+    uint8_t winPos;             // next byte to be written
+    uint16_t winFill;
+
+    uint8_t lookahead [Lz_ns::match_max];
+    uint8_t laLen;
+
+    uint32_t bitBuf;
+    uint8_t bitCount;
+    uint8_t outBuf [Lz_ns::outBuf_size];
+    uint8_t outLen;
+
+    Lz_ns::stats_t stats;
+
+    void byte_put (uint8_t data);
+    void step (void);
+    void bits_put (uint32_t bits, uint8_t numOfBits);
+    void out_flush (void);
+};
+
+class LzDecoder {
+public:
+    LzDecoder (Lz_ns::sink_t sink_p, void *sinkCtx);
+
+    void data_put (const uint8_t *buf, uint16_t len);
+    void block_end (void);
+    void reset (void);
+
+private:
+    Lz_ns::sink_t sink_p;
+    void *sinkCtx;
+
+    uint8_t window [Lz_ns::window_size];
+    uint8_t winPos;
+
+    uint32_t bitBuf;
+    uint8_t bitCount;
+    uint8_t outBuf [Lz_ns::outBuf_size];
+    uint8_t outLen;
+
+    void byte_out (uint8_t data);
+    void out_flush (void);
+};
+
+#endif // __MB1_LZ_H
@@ -17,8 +17,15 @@ uint16_t ledBeat_period = 0;
 
 static uint32_t Delayms_count = 0; // for IRQ of Delayms
 
+static volatile uint32_t Ticks_ms = 0; // for IRQ of ticks_ms
+
 uint16_t miscTIM_period = 0;
 
+/* DWT cycle counter */
+#define DWT_CTRL_reg (*(volatile uint32_t *) 0xE0001000)
+#define DWT_CYCCNT_reg (*(volatile uint32_t *) 0xE0001004)
+#define DWT_CTRL_CYCCNTENA ((uint32_t) 0x00000001)
+
 
 
 /* Functions implementation */
@@ -155,3 +162,44 @@ void delay_ms_miscTIMISR (void){
 
     return;
 }
+
+/**
+ * @brief ticks_ms_get
+ * @return uint32_t : time since ticks_ms_miscTIMISR has been assigned, in msec (wraps after ~49 days).
+ * Use global var : Ticks_ms (static).
+ */
+uint32_t ticks_ms_get (void){
+    return Ticks_ms;
+}
+
+/**
+ * @brief ticks_ms_miscTIMISR
+ * @return void
+ * Use global var : miscTIM_period, Ticks_ms (static).
+ */
+void ticks_ms_miscTIMISR (void){
+    Ticks_ms += miscTIM_period;
+
+    return;
+}
+
+/**
+ * @brief cycles_enable, start DWT cycle counter.
+ * @return void
+ * DWT registers are used by address, core_cm3.h of StdPeriph doesn't define them.
+ */
+void cycles_enable (void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT_CYCCNT_reg = 0;
+    DWT_CTRL_reg |= DWT_CTRL_CYCCNTENA;
+
+    return;
+}
+
+/**
+ * @brief cycles_get
+ * @return uint32_t : CPU cycles since cycles_enable (wraps after 2^32 cycles, ~59 s at 72 MHz).
+ */
+uint32_t cycles_get (void){
+    return DWT_CYCCNT_reg;
+}
@@ -39,4 +39,10 @@ void miscTIM_run (TIM_TypeDef *miscTIM, uint16_t prescaler, uint16_t reloadVal);
 void LedBeat (bool On, uint16_t msec, Led *aLed);
 void LedBeat_miscTIMISR (void); // It should be placed in miscTIMISR.
 
+uint32_t ticks_ms_get (void);
+void ticks_ms_miscTIMISR (void); // It should be placed in miscTIMISR.
+
+void cycles_enable (void);
+uint32_t cycles_get (void); // CPU cycles (DWT), for benchmarks.
+
 #endif // __MB1_MISC_H
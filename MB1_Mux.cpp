@@ -0,0 +1,365 @@
+/**
+ * @file MB1_Mux.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for prioritised virtual channels multiplexed over one serial_t.
+ */
+
+/* Includes */
+#include "MB1_Mux.h"
+using namespace Mux_ns;
+
+/**< Muxes which have been begun, for dmaDone_handler */
+static Mux *_muxObjs [muxObjs_max] = {NULL};
+
+/**<----------------------------- class Mux -------------------------------------*/
+
+/**
+ * @brief Mux.
+ * @param serial_t *serial_p : serial_t to be used, not NULL.
+ */
+Mux::Mux (serial_t *serial_p)
+    : encoder (chunk_sink, this, NULL){
+    uint8_t chId;
+
+    this->serial_p = serial_p;
+
+    for (chId = 0; chId < channels_max; chId++){
+        channels[chId].mux_p = this;
+        channels[chId].chId = chId;
+        channels[chId].isOpen = false;
+        channels[chId].buf = NULL;
+        channels[chId].bufSize = 0;
+        channels[chId].head = 0;
+        channels[chId].tail = 0;
+        stats_reset (chId);
+    }
+    lastServed = channels_max - 1;
+
+    chunkLen = 0;
+    chunkBusy = false;
+    chunkCh = 0;
+    chunkData = 0;
+}
+
+/**
+ * @brief begin, enable DMA TX of serial_t and register this Mux.
+ * @return Mux_ns::status_t : failed if serial_t has no DMA TX, or too many Muxes.
+ */
+status_t Mux::begin (void){
+    uint8_t count;
+    int8_t freeSlot = -1;
+
+    for (count = 0; count < muxObjs_max; count++){
+        if (_muxObjs[count] == this)
+            return successful;
+        if ((_muxObjs[count] == NULL) && (freeSlot < 0))
+            freeSlot = count;
+    }
+    if (freeSlot < 0)
+        return failed;
+
+    if (serial_p->DmaTx_enable (dmaDone_handler) != serial_ns::successful)
+        return failed;
+
+    _muxObjs[freeSlot] = this;
+
+    return successful;
+}
+
+/**
+ * @brief channel_open, open a channel.
+ * @param uint8_t chId : 0 to channels_max - 1.
+ * @param uint8_t *buf : ring buffer of this channel, one byte is kept free.
+ * @param uint16_t bufSize : >= 2.
+ * @param uint8_t priority : 0 is the highest.
+ * @return Mux_ns::status_t
+ */
+status_t Mux::channel_open (uint8_t chId, uint8_t *buf, uint16_t bufSize, uint8_t priority){
+    uint32_t primask;
+
+    if ((chId >= channels_max) || (buf == NULL) || (bufSize < 2))
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (channels[chId].isOpen){
+        __set_PRIMASK(primask);
+        return busy;
+    }
+
+    channels[chId].buf = buf;
+    channels[chId].bufSize = bufSize;
+    channels[chId].head = 0;
+    channels[chId].tail = 0;
+    channels[chId].priority = priority;
+    channels[chId].isOpen = true;
+
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+ * @brief channel_close, close a channel, data not sent yet is discarded.
+ * @param uint8_t chId
+ * @return Mux_ns::status_t
+ */
+status_t Mux::channel_close (uint8_t chId){
+    uint32_t primask;
+
+    if (chId >= channels_max)
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    channels[chId].isOpen = false;
+    channels[chId].head = channels[chId].tail;
+
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+ * @brief write, put data to a channel, non-blocking.
+ * @param uint8_t chId
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return uint16_t : number of bytes accepted, the rest is counted in bytesDropped.
+ */
+uint16_t Mux::write (uint8_t chId, const uint8_t *buf, uint16_t len){
+    channel_t *ch_p;
+    uint16_t head, next, count;
+
+    if ((chId >= channels_max) || !channels[chId].isOpen)
+        return 0;
+
+    ch_p = &channels[chId];
+    head = ch_p->head;
+
+    for (count = 0; count < len; count++){
+        next = (head + 1 == ch_p->bufSize) ? 0 : head + 1;
+        if (next == ch_p->tail)
+            break;
+        ch_p->buf[head] = buf[count];
+        head = next;
+    }
+    ch_p->head = head;
+
+    ch_p->stats.bytesWritten += count;
+    ch_p->stats.bytesDropped += len - count;
+
+    pump ();
+
+    return count;
+}
+
+/**
+ * @brief pending, number of bytes waiting in a channel.
+ * @param uint8_t chId
+ * @return uint16_t
+ */
+uint16_t Mux::pending (uint8_t chId){
+    uint16_t head, tail;
+
+    if (chId >= channels_max)
+        return 0;
+
+    head = channels[chId].head;
+    tail = channels[chId].tail;
+
+    return (head >= tail) ? (head - tail) : (channels[chId].bufSize - tail + head);
+}
+
+/**
+ * @brief stats_get, get counters of a channel.
+ * @param uint8_t chId
+ * @param Mux_ns::stats_t *stats_p
+ * @return None
+ */
+void Mux::stats_get (uint8_t chId, stats_t *stats_p){
+    uint32_t primask;
+
+    if (chId >= channels_max)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *stats_p = channels[chId].stats;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief stats_reset, reset counters of a channel.
+ * @param uint8_t chId
+ * @return None
+ */
+void Mux::stats_reset (uint8_t chId){
+    uint32_t primask;
+
+    if (chId >= channels_max)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    channels[chId].stats.bytesWritten = 0;
+    channels[chId].stats.bytesDropped = 0;
+    channels[chId].stats.bytesSent = 0;
+    channels[chId].stats.chunksSent = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief sinkCtx_get, context for Out_sink to write to a channel.
+ * @param uint8_t chId
+ * @return void * : NULL if chId is out of range.
+ */
+void *Mux::sinkCtx_get (uint8_t chId){
+    if (chId >= channels_max)
+        return NULL;
+
+    return &channels[chId];
+}
+
+/**
+ * @brief Out_sink, write to the channel given by sinkCtx (from sinkCtx_get).
+ * Bytes which don't fit are dropped.
+ * @param void *sinkCtx
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void Mux::Out_sink (void *sinkCtx, const uint8_t *buf, uint16_t len){
+    channel_t *ch_p = (channel_t *) sinkCtx;
+
+    ch_p->mux_p->write (ch_p->chId, buf, len);
+}
+
+/**
+ * @brief channel_pick, highest-priority channel with pending data, round-robin between
+ * channels of the same priority.
+ * @return int8_t : chId, -1 if nothing is pending.
+ */
+int8_t Mux::channel_pick (void){
+    int8_t picked = -1;
+    uint8_t count, chId;
+
+    chId = lastServed;
+    for (count = 0; count < channels_max; count++){
+        chId = (chId + 1 == channels_max) ? 0 : chId + 1;
+
+        if (!channels[chId].isOpen || (channels[chId].head == channels[chId].tail))
+            continue;
+        if ((picked < 0) || (channels[chId].priority < channels[picked].priority))
+            picked = chId;
+    }
+
+    return picked;
+}
+
+/**
+ * @brief pump, send next chunk if no chunk is on the way.
+ * Called from write and from DMA TX done (ISR).
+ * @return None
+ */
+void Mux::pump (void){
+    uint32_t primask;
+    int8_t picked;
+    channel_t *ch_p;
+    uint16_t tail, avail, count;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (chunkBusy){
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    picked = channel_pick ();
+    if (picked < 0){
+        __set_PRIMASK(primask);
+        return;
+    }
+    ch_p = &channels[picked];
+
+    /* build chunk, tail is only moved after chunk has been queued */
+    chunkLen = 0;
+    encoder.frame_begin ();
+    encoder.data_put ((uint8_t) picked);
+
+    tail = ch_p->tail;
+    for (count = 0; (count < chunk_max) && (tail != ch_p->head); count += avail){
+        avail = ((ch_p->head > tail) ? ch_p->head : ch_p->bufSize) - tail;
+        if (avail > chunk_max - count)
+            avail = chunk_max - count;
+
+        encoder.data_put (&ch_p->buf[tail], avail);
+        tail += avail;
+        if (tail == ch_p->bufSize)
+            tail = 0;
+    }
+    encoder.frame_end ();
+
+    /* serial_t DMA queue can be full with buffers of other users, retry on next DMA done */
+    if (serial_p->OutDMA (chunkBuf, chunkLen) == serial_ns::successful){
+        ch_p->tail = tail;
+        chunkBusy = true;
+        chunkCh = picked;
+        chunkData = count;
+        lastServed = picked;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief chunk_done, update counters of the chunk which has just been sent.
+ * @return None
+ */
+void Mux::chunk_done (void){
+    channels[chunkCh].stats.bytesSent += chunkData;
+    channels[chunkCh].stats.chunksSent++;
+    chunkBusy = false;
+}
+
+/**
+ * @brief chunk_sink, output of encoder, to chunkBuf.
+ * @param void *muxObj : Mux.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void Mux::chunk_sink (void *muxObj, const uint8_t *buf, uint16_t len){
+    Mux *mux_p = (Mux *) muxObj;
+    uint16_t count;
+
+    for (count = 0; (count < len) && (mux_p->chunkLen < sizeof (mux_p->chunkBuf)); count++)
+        mux_p->chunkBuf[mux_p->chunkLen++] = buf[count];
+}
+
+/**
+ * @brief dmaDone_handler, DMA TX done of serial_t (ISR context).
+ * Buffers of other users of serial_t also come here, every Mux gets a chance to send.
+ * @param const uint8_t *buf
+ * @param uint16_t : length of buf, not used.
+ * @return None
+ */
+void Mux::dmaDone_handler (const uint8_t *buf, uint16_t){
+    uint8_t count;
+    Mux *mux_p;
+
+    for (count = 0; count < muxObjs_max; count++){
+        mux_p = _muxObjs[count];
+        if (mux_p == NULL)
+            continue;
+
+        if (mux_p->chunkBusy && (buf == mux_p->chunkBuf))
+            mux_p->chunk_done ();
+        mux_p->pump ();
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file MB1_Mux.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for prioritised virtual channels multiplexed over one serial_t.
+ * Each channel has its own ring buffer (given by user) and priority (0 is the highest).
+ * Channel data is sent by DMA in chunks of at most Mux_ns::chunk_max bytes, only one chunk
+ * is on the way at a time, so a high-priority write waits at most one chunk time.
+ * Channels of the same priority are served round-robin.
+ * Chunk on the wire (no CRC) : COBS (chId, data...) 0x00, see MB1_Cobs.h.
+ * How to use this lib:
+ * - Declare a Mux with a serial_t (USART1 to UART4, DMA TX is used).
+ * - begin, it takes DMA TX of the serial_t (txDmaDone_p of serial_t is used by Mux).
+ * - channel_open for each channel.
+ * - write to a channel from tasks (non-blocking), or use Out_sink with sinkCtx_get (e.g. for Logger).
+ * - stats_get for per-channel throughput counters.
+ */
+
+#ifndef __MB1_MUX_H
+#define __MB1_MUX_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_Serial_t.h"
+#include "MB1_Cobs.h"
+
+namespace Mux_ns {
+
+/**< config (compile-time) */
+const uint8_t channels_max = 4;
+const uint8_t chunk_max = 32;       // data bytes per chunk, <= 253
+const uint8_t muxObjs_max = 2;      // max number of Mux (one per serial_t)
+
+typedef enum {
+    successful,
+    failed,
+    busy
+} status_t;
+
+/**< per-channel counters */
+typedef struct {
+    uint32_t bytesWritten;  // accepted by write
+    uint32_t bytesDropped;  // not accepted, ring buffer full
+    uint32_t bytesSent;     // data bytes of sent chunks
+    uint32_t chunksSent;
+} stats_t;
+
+}
+
+class Mux {
+public:
+    Mux (serial_t *serial_p);
+
+    Mux_ns::status_t begin (void);
+    Mux_ns::status_t channel_open (uint8_t chId, uint8_t *buf, uint16_t bufSize, uint8_t priority);
+    Mux_ns::status_t channel_close (uint8_t chId);
+
+    uint16_t write (uint8_t chId, const uint8_t *buf, uint16_t len);
+    uint16_t pending (uint8_t chId);
+
+    void stats_get (uint8_t chId, Mux_ns::stats_t *stats_p);
+    void stats_reset (uint8_t chId);
+
+    /**< sink for stream layers (e.g. Logger), sinkCtx from sinkCtx_get */
+    void *sinkCtx_get (uint8_t chId);
+    static void Out_sink (void *sinkCtx, const uint8_t *buf, uint16_t len);
+
+private:
+    typedef struct {
+        Mux *mux_p;
+        uint8_t chId;
+        bool isOpen;
+        uint8_t priority;
+        uint8_t *buf;
+        uint16_t bufSize;
+        volatile uint16_t head;     // written by write
+        volatile uint16_t tail;     // written by pump
+        Mux_ns::stats_t stats;
+    } channel_t;
+
+    serial_t *serial_p;
+    channel_t channels [Mux_ns::channels_max];
+    uint8_t lastServed;
+
+    /* chunk on the way */
+    CobsEncoder encoder;
+    uint8_t chunkBuf [Mux_ns::chunk_max + 3];   // code + chId + data + 0x00
+    uint16_t chunkLen;
+    volatile bool chunkBusy;
+    uint8_t chunkCh;
+    uint8_t chunkData;
+
+    int8_t channel_pick (void);
+    void pump (void);
+    void chunk_done (void);
+    static void chunk_sink (void *muxObj, const uint8_t *buf, uint16_t len);
+    static void dmaDone_handler (const uint8_t *buf, uint16_t len);
+};
+
+#endif // __MB1_MUX_H
@@ -0,0 +1,110 @@
+/**
+ * @file MB1_Rpc.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for binary RPC over serial : client.
+ */
+
+/* Includes */
+#include "MB1_Rpc.h"
+using namespace Rpc_ns;
+
+/**<----------------------------- class RpcClient -------------------------------*/
+
+/**
+ * @brief RpcClient.
+ * @param Cobs_ns::sink_t sink_p : output to the link (not NULL).
+ * @param void *sinkCtx : passed to sink_p.
+ * @param uint8_t *frameBuf : for received frames, >= respHeader_len + max response data + Cobs_ns::crcLen.
+ * @param uint16_t frameBufSize
+ * @param Cobs_ns::crcWord_t crcWord_p : same CRC as the server, e.g. cobs_crcWord_sw.
+ * @param Rpc_ns::response_t response_p : called for each response (not NULL).
+ * @param void *responseCtx : passed to response_p.
+ */
+RpcClient::RpcClient (Cobs_ns::sink_t sink_p, void *sinkCtx, uint8_t *frameBuf, uint16_t frameBufSize,
+                      Cobs_ns::crcWord_t crcWord_p, response_t response_p, void *responseCtx)
+    : encoder (sink_p, sinkCtx, crcWord_p),
+      decoder (frameBuf, frameBufSize, crcWord_p){
+    this->response_p = response_p;
+    this->responseCtx = responseCtx;
+
+    nextReqId = 0;
+    requests = 0;
+    responses = 0;
+    badResponses = 0;
+}
+
+/**
+ * @brief request, send a request, don't wait for response.
+ * @param uint8_t methodId
+ * @param const uint8_t *data : can be NULL if len = 0.
+ * @param uint16_t len
+ * @return uint8_t : reqId, given back with the response.
+ */
+uint8_t RpcClient::request (uint8_t methodId, const uint8_t *data, uint16_t len){
+    uint8_t header [reqHeader_len];
+    uint8_t reqId = nextReqId++;
+
+    header[0] = reqId;
+    header[1] = methodId;
+    header[2] = (uint8_t) len;
+    header[3] = (uint8_t) (len >> 8);
+
+    encoder.frame_begin ();
+    encoder.data_put (header, reqHeader_len);
+    if (len > 0)
+        encoder.data_put (data, len);
+    encoder.frame_end ();
+
+    requests++;
+
+    return reqId;
+}
+
+/**
+ * @brief data_put, bytes received from the link, response_p is called for each response.
+ * @param const uint8_t *buf
+ * @param uint16_t len
+ * @return None
+ */
+void RpcClient::data_put (const uint8_t *buf, uint16_t len){
+    const uint8_t *frame;
+    uint16_t count, frameLen, dataLen;
+
+    for (count = 0; count < len; count++){
+        if (decoder.data_put (buf[count]) != Cobs_ns::frameReady)
+            continue;
+
+        frameLen = decoder.frame_get (&frame);
+        if (frameLen < respHeader_len){
+            badResponses++;
+            continue;
+        }
+
+        dataLen = frame[3] | (frame[4] << 8);
+        if (dataLen != frameLen - respHeader_len){
+            badResponses++;
+            continue;
+        }
+
+        responses++;
+        response_p (responseCtx, frame[0], frame[1], (result_t) frame[2], &frame[respHeader_len], dataLen);
+    }
+}
+
+/**
+ * @brief inFlight_get, requests which have no response yet.
+ * @return uint32_t
+ */
+uint32_t RpcClient::inFlight_get (void){
+    return requests - responses;
+}
+
+/**
+ * @brief errors_get, responses dropped (CRC, framing or length errors).
+ * @return uint32_t
+ */
+uint32_t RpcClient::errors_get (void){
+    return badResponses + decoder.crcErrors_get () + decoder.otherErrors_get ();
+}
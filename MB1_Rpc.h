@@ -0,0 +1,82 @@
+/**
+ * @file MB1_Rpc.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for binary RPC over serial : wire format and client.
+ * Each message is one COBS frame with CRC-32 (see MB1_Cobs.h), little-endian :
+ *      request  : | reqId (1) | methodId (1) | len (2) | data (len) |
+ *      response : | reqId (1) | methodId (1) | result (1) | len (2) | data (len) |
+ * reqId is chosen by the client, so several requests can be in flight, responses can come
+ * back out of order (deferred handlers on the server, see MB1_RpcServer.h).
+ * This file only depends on stdint.h, so host tools build the same client.
+ * How to use this lib (client):
+ * - Declare a RpcClient with a sink to the link, a frame buffer and a response callback.
+ * - request (methodId, data, len) returns reqId, any number of requests can be sent.
+ * - data_put every byte received from the link, response_p is called for each response.
+ */
+
+#ifndef __MB1_RPC_H
+#define __MB1_RPC_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+#include "MB1_Cobs.h"
+
+namespace Rpc_ns {
+
+/**< config (compile-time) */
+const uint8_t methods_max = 32;
+const uint8_t reqHeader_len = 4;
+const uint8_t respHeader_len = 5;
+const uint8_t version = 1;
+
+/**< built-in methods */
+const uint8_t method_ping = 0;  // response data : version
+
+typedef enum {
+    successful,
+    failed,
+    busy
+} status_t;
+
+/**< result of a request, on the wire */
+typedef enum {
+    result_ok,
+    result_unknownMethod,
+    result_badRequest,
+    result_failed,
+    result_pending      // handler will respond later, never on the wire
+} result_t;
+
+/**< called for each response */
+typedef void (* response_t) (void *ctx, uint8_t reqId, uint8_t methodId, result_t result,
+                             const uint8_t *data, uint16_t len);
+
+}
+
+class RpcClient {
+public:
+    RpcClient (Cobs_ns::sink_t sink_p, void *sinkCtx, uint8_t *frameBuf, uint16_t frameBufSize,
+               Cobs_ns::crcWord_t crcWord_p, Rpc_ns::response_t response_p, void *responseCtx);
+
+    uint8_t request (uint8_t methodId, const uint8_t *data, uint16_t len);
+    void data_put (const uint8_t *buf, uint16_t len);
+
+    uint32_t inFlight_get (void);
+    uint32_t errors_get (void);
+
+private:
+    CobsEncoder encoder;
+    CobsDecoder decoder;
+    Rpc_ns::response_t response_p;
+    void *responseCtx;
+
+    uint8_t nextReqId;
+    uint32_t requests;
+    uint32_t responses;
+    uint32_t badResponses;
+};
+
+#endif // __MB1_RPC_H
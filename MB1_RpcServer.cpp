@@ -0,0 +1,192 @@
+/**
+ * @file MB1_RpcServer.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is source file for binary RPC server over serial_t.
+ */
+
+/* Includes */
+#include "MB1_RpcServer.h"
+using namespace Rpc_ns;
+
+/**<----------------------------- class RpcServer -------------------------------*/
+
+/**
+ * @brief RpcServer, method_ping is registered.
+ * @param serial_t *serial_p : with an RX buffer.
+ * @param uint8_t *frameBuf : for received frames, >= reqHeader_len + max request data + Cobs_ns::crcLen.
+ * @param uint16_t frameBufSize
+ * @param Cobs_ns::crcWord_t crcWord_p : CRC of requests, e.g. CRC_hwWord or cobs_crcWord_sw, not NULL.
+ * Responses always use cobs_crcWord_sw : a pending response can be encoded while the decoder
+ * is in the middle of the next request, they must not share the CRC unit.
+ */
+RpcServer::RpcServer (serial_t *serial_p, uint8_t *frameBuf, uint16_t frameBufSize, Cobs_ns::crcWord_t crcWord_p)
+    : decoder (frameBuf, frameBufSize, crcWord_p),
+      encoder (serial_t::Out_sink, serial_p, cobs_crcWord_sw){
+    uint8_t count;
+
+    this->serial_p = serial_p;
+
+    for (count = 0; count < methods_max; count++){
+        methods[count].handler_p = NULL;
+        methods[count].arg = NULL;
+    }
+    methods[method_ping].handler_p = ping_handler;
+
+    requests = 0;
+    badRequests = 0;
+}
+
+/**
+ * @brief method_register
+ * @param uint8_t methodId : < methods_max.
+ * @param Rpc_ns::handler_t handler_p
+ * @param void *arg : passed to handler_p.
+ * @return Rpc_ns::status_t : busy if methodId has been registered.
+ */
+status_t RpcServer::method_register (uint8_t methodId, handler_t handler_p, void *arg){
+    if ((methodId >= methods_max) || (handler_p == NULL))
+        return failed;
+    if (methods[methodId].handler_p != NULL)
+        return busy;
+
+    methods[methodId].arg = arg;
+    methods[methodId].handler_p = handler_p;
+
+    return successful;
+}
+
+/**
+ * @brief method_unregister
+ * @param uint8_t methodId
+ * @return Rpc_ns::status_t
+ */
+status_t RpcServer::method_unregister (uint8_t methodId){
+    if (methodId >= methods_max)
+        return failed;
+
+    methods[methodId].handler_p = NULL;
+    methods[methodId].arg = NULL;
+
+    return successful;
+}
+
+/**
+ * @brief process, handle all requests received so far.
+ * @return None
+ */
+void RpcServer::process (void){
+    uint8_t chunk [rxChunk_size];
+    const uint8_t *frame;
+    uint16_t len, count, frameLen;
+
+    while ((len = serial_p->Read (chunk, rxChunk_size)) > 0){
+        for (count = 0; count < len; count++){
+            if (decoder.data_put (chunk[count]) != Cobs_ns::frameReady)
+                continue;
+
+            frameLen = decoder.frame_get (&frame);
+            dispatch (frame, frameLen);
+        }
+    }
+}
+
+/**
+ * @brief respond, send a response (also used by handlers which have returned result_pending).
+ * @param uint8_t reqId
+ * @param uint8_t methodId
+ * @param Rpc_ns::result_t result : not result_pending.
+ * @param const uint8_t *buf : response data, sent without copy.
+ * @param uint16_t len
+ * @return Rpc_ns::status_t
+ */
+status_t RpcServer::respond (uint8_t reqId, uint8_t methodId, result_t result, const uint8_t *buf, uint16_t len){
+    uint8_t header [respHeader_len];
+
+    if ((result == result_pending) || ((buf == NULL) && (len > 0)))
+        return failed;
+
+    header[0] = reqId;
+    header[1] = methodId;
+    header[2] = (uint8_t) result;
+    header[3] = (uint8_t) len;
+    header[4] = (uint8_t) (len >> 8);
+
+    encoder.frame_begin ();
+    encoder.data_put (header, respHeader_len);
+    if (len > 0)
+        encoder.data_put (buf, len);
+    encoder.frame_end ();
+
+    return successful;
+}
+
+/**
+ * @brief requests_get, number of requests handled.
+ * @return uint32_t
+ */
+uint32_t RpcServer::requests_get (void){
+    return requests;
+}
+
+/**
+ * @brief errors_get, requests dropped (CRC or framing) or answered with result_badRequest.
+ * @return uint32_t
+ */
+uint32_t RpcServer::errors_get (void){
+    return badRequests + decoder.crcErrors_get () + decoder.otherErrors_get ();
+}
+
+/**
+ * @brief dispatch, check a request and call its handler.
+ * @param const uint8_t *frame
+ * @param uint16_t frameLen
+ * @return None
+ */
+void RpcServer::dispatch (const uint8_t *frame, uint16_t frameLen){
+    response_s resp;
+    result_t result;
+    uint8_t methodId;
+    uint16_t dataLen;
+
+    if (frameLen < reqHeader_len){
+        badRequests++;
+        return;
+    }
+
+    requests++;
+    methodId = frame[1];
+    dataLen = frame[2] | (frame[3] << 8);
+
+    resp.reqId = frame[0];
+    resp.buf = NULL;
+    resp.len = 0;
+
+    if (dataLen != frameLen - reqHeader_len){
+        badRequests++;
+        result = result_badRequest;
+    }
+    else if ((methodId >= methods_max) || (methods[methodId].handler_p == NULL))
+        result = result_unknownMethod;
+    else
+        result = methods[methodId].handler_p (methods[methodId].arg, &frame[reqHeader_len], dataLen, &resp);
+
+    if (result == result_pending)
+        return;
+    if (result != result_ok)
+        resp.len = 0;
+
+    respond (resp.reqId, methodId, result, resp.buf, resp.len);
+}
+
+/**
+ * @brief ping_handler, method_ping, gives back Rpc_ns::version.
+ * @return Rpc_ns::result_t
+ */
+result_t RpcServer::ping_handler (void *, const uint8_t *, uint16_t, response_s *resp_p){
+    resp_p->buf = &version;
+    resp_p->len = 1;
+
+    return result_ok;
+}
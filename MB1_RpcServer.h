@@ -0,0 +1,76 @@
+/**
+ * @file MB1_RpcServer.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 16-10-2026
+ * @brief This is header file for binary RPC server over serial_t (wire format in MB1_Rpc.h).
+ * Handlers are kept in a table indexed by methodId. A handler gets the request data in place
+ * (in the frame buffer) and gives back a pointer to its own response buffer, which is encoded
+ * straight to serial_t, nothing is copied in between.
+ * Requests wait in the RX buffer of serial_t, so the host can pipeline them, they are handled
+ * in order by process. A handler can return Rpc_ns::result_pending and call respond later, from
+ * main-loop context (e.g. when the main loop sees the job has ended), so responses can come back
+ * out of order. Pending responses are sent from main-loop context, never from ISRs.
+ * How to use this lib:
+ * - serial_t must have an RX buffer (RxBuffer_set or DmaRx_enable).
+ * - Declare a RpcServer with the serial_t and a frame buffer, method_register handlers.
+ * - Call process in main loop. Not reentrant, respond must be called from the same context.
+ */
+
+#ifndef __MB1_RPCSERVER_H
+#define __MB1_RPCSERVER_H
+
+/* Includes */
+#include "MB1_Glb.h"
+#include "MB1_Serial_t.h"
+#include "MB1_Rpc.h"
+
+namespace Rpc_ns {
+
+/**< response of a handler */
+typedef struct {
+    uint8_t reqId;          // for respond, if result_pending is returned
+    const uint8_t *buf;     // handler-owned, must stay valid until handler returns (or respond returns)
+    uint16_t len;
+} response_s;
+
+/**< handler, data points into frame buffer and is valid until handler returns */
+typedef result_t (* handler_t) (void *arg, const uint8_t *data, uint16_t len, response_s *resp_p);
+
+const uint8_t rxChunk_size = 32;    // bytes taken from serial_t at a time
+
+}
+
+class RpcServer {
+public:
+    RpcServer (serial_t *serial_p, uint8_t *frameBuf, uint16_t frameBufSize, Cobs_ns::crcWord_t crcWord_p);
+
+    Rpc_ns::status_t method_register (uint8_t methodId, Rpc_ns::handler_t handler_p, void *arg);
+    Rpc_ns::status_t method_unregister (uint8_t methodId);
+
+    void process (void);
+    Rpc_ns::status_t respond (uint8_t reqId, uint8_t methodId, Rpc_ns::result_t result,
+                              const uint8_t *buf, uint16_t len);
+
+    uint32_t requests_get (void);
+    uint32_t errors_get (void);
+
+private:
+    typedef struct {
+        Rpc_ns::handler_t handler_p;
+        void *arg;
+    } method_s;
+
+    serial_t *serial_p;
+    CobsDecoder decoder;
+    CobsEncoder encoder;
+    method_s methods [Rpc_ns::methods_max];
+
+    uint32_t requests;
+    uint32_t badRequests;
+
+    void dispatch (const uint8_t *frame, uint16_t frameLen);
+    static Rpc_ns::result_t ping_handler (void *arg, const uint8_t *data, uint16_t len, Rpc_ns::response_s *resp_p);
+};
+
+#endif // __MB1_RPCSERVER_H
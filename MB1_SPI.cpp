@@ -50,6 +50,10 @@ const uint16_t hard_NSS_pins [numOfSPIs][2] = {   {GPIO_Pin_4, GPIO_Pin_15},  //
                                                         {GPIO_Pin_12, 0} };            //SPI2
 uint32_t hard_NSS_RCCs [numOfSPIs][2] = {         {RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOA},   //SPI1
                                                         {RCC_APB2Periph_GPIOB, 0} };                        //SPI2
+
+const DMA_ns::channel_t SPI_RXDMAs [numOfSPIs] = {DMA_ns::DMA1_ch2, DMA_ns::DMA1_ch4};
+const DMA_ns::channel_t SPI_TXDMAs [numOfSPIs] = {DMA_ns::DMA1_ch3, DMA_ns::DMA1_ch5};
+static const uint16_t SPI_dmaTxDummy = 0xFFFF; // TX source when txBuf is NULL
 /**< end sys_conf */
 
 /* Functions implementation for class SPI */
@@ -61,6 +65,40 @@ SPI::SPI (uint16_t usedSPI){
     SM_numOfNSSLines = 0;
     SM_numOfDevices = 0x01 << SM_numOfNSSLines;
     SM_deviceInUse = allFree;
+
+    uint8_t a_count;
+    for (a_count = 0; a_count < numOfSMDevices; a_count++){
+        SM_deviceToDecode[a_count] = decodeValue_none;
+        SM_profiles[a_count].isSet = false;
+        SM_crcModes[a_count] = false;
+    }
+    SM_profileActive = numOfSMDevices;
+    for (a_count = 0; a_count < SSDevices_max; a_count++)
+        SM_deviceToDecoder_table[a_count] = numOfSMDevices;
+    SM_numOfPorts = 0;
+
+    dmaBusy = false;
+    dmaStatus = successful;
+    dmaDone_p = NULL;
+    dmaDoneArg = NULL;
+    dmaDummy = 0;
+    dmaCRC = false;
+    crcErrors = 0;
+
+    queueHead = 0;
+    queueCount = 0;
+    queueActive = NULL;
+    queueAttached = false;
+    queueSelected = false;
+    queueInCallback = false;
+    queueCutDevice = allFree;
+
+    S2F_running = false;
+    S2F_done_p = NULL;
+    S2F_doneArg = NULL;
+    S2F_halfOwned[0] = false;
+    S2F_halfOwned[1] = false;
+    S2F_overruns = 0;
 }
 
 /**
@@ -94,10 +132,49 @@ void SPI::M2F_GPIOs_Init (void) {
     return;
 }
 
+/**
+  * @brief init GPIOs for slave mode : MISO is driven, MOSI, SCK (and NSS) are inputs.
+  * @param bool isHardNSS : NSS pin is used.
+  * @return None
+  * @attention set remap value for SPI properly.
+  */
+void SPI::S2F_GPIOs_Init (bool isHardNSS) {
+    bool remap_value = GPIO_isRemap [usedSPI];
+
+    /**< Init RCC */
+    RCC_APB2PeriphClockCmd (MOSI_RCCs[usedSPI][remap_value], ENABLE);
+    RCC_APB2PeriphClockCmd (MISO_RCCs[usedSPI][remap_value], ENABLE);
+    RCC_APB2PeriphClockCmd (SCK_RCCs[usedSPI][remap_value], ENABLE);
+
+    /**< Init MOSI, MISO, SCK, NSS */
+    GPIO_InitTypeDef GPIO_InitStruct;
+
+    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_AF_PP;
+    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStruct.GPIO_Pin = MISO_pins[usedSPI][remap_value];
+    GPIO_Init (MISO_ports[usedSPI][remap_value], &GPIO_InitStruct);
+
+    GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_InitStruct.GPIO_Pin = MOSI_pins[usedSPI][remap_value];
+    GPIO_Init (MOSI_ports[usedSPI][remap_value], &GPIO_InitStruct);
+
+    GPIO_InitStruct.GPIO_Pin = SCK_pins[usedSPI][remap_value];
+    GPIO_Init (SCK_ports[usedSPI][remap_value], &GPIO_InitStruct);
+
+    if (isHardNSS){
+        RCC_APB2PeriphClockCmd (hard_NSS_RCCs[usedSPI][remap_value], ENABLE);
+        GPIO_InitStruct.GPIO_Pin = hard_NSS_pins[usedSPI][remap_value];
+        GPIO_Init (hard_NSS_ports[usedSPI][remap_value], &GPIO_InitStruct);
+        SS_pins_set |= 0x01;
+    }
+
+    return;
+}
+
 /**
   * @brief Init SPI, base on parameters.
   * @return SPI_ns::status_t.
-  * @attention I have implemented this function only for master mode, 2 lines, full duplex.
+  * @attention I have implemented this function for master mode and slave mode, 2 lines, full duplex.
   */
 status_t SPI::init (SPI_params_t *params_struct){
 
@@ -116,6 +193,7 @@ status_t SPI::init (SPI_params_t *params_struct){
     SPI_InitStruct.SPI_NSS = params_struct->nss;
 
     SPI_Init (SPIs[usedSPI], &SPI_InitStruct);
+    SM_profileActive = numOfSMDevices;
 
     /* Enable SPI */
     SPI_Cmd (SPIs[usedSPI], ENABLE);
@@ -139,6 +217,20 @@ status_t SPI::init (SPI_params_t *params_struct){
         }/* end switch-case */
     }
 
+    /**< Slave mode init */
+    if ( params_struct->mode == SPI_Mode_Slave ){
+        switch (params_struct->direction){
+
+        case SPI_Direction_2Lines_FullDuplex :
+            S2F_GPIOs_Init (params_struct->nss == SPI_NSS_Hard);
+            break;
+
+        default :
+            break;
+
+        }/* end switch-case */
+    }
+
     return successful;
 }
 
@@ -160,6 +252,8 @@ status_t SPI::SM_numOfSSLines_set (uint8_t numOfSSLines){
     SM_numOfNSSLines = numOfSSLines;
     SM_numOfDevices = 0x01 << SM_numOfNSSLines;
 
+    SM_BSRRs_update ();
+
     return successful;
 }
 
@@ -193,6 +287,8 @@ status_t SPI::SM_GPIO_set (SM_GPIOParams_s *params_struct){
     /**< update SS_pins_set */
     SS_pins_set |= (0x01 << (line + 1) );
 
+    SM_BSRRs_update ();
+
     return successful;
 }
 
@@ -206,10 +302,18 @@ status_t SPI::SM_GPIO_set (SM_GPIOParams_s *params_struct){
   * and init decoder to all_free value ( call SM_device_deselect () ).
   */
 status_t SPI::SM_deviceToDecoder_set (SM_device_t device, uint8_t decode_value){
-    if (decode_value >= SM_numOfDevices)
+    SM_device_t old_device;
+
+    if ((decode_value >= SM_numOfDevices) || (device >= numOfSMDevices))
         return failed;
 
+    /**< unmap device which had this decode value */
+    old_device = SM_deviceToDecoder_table [decode_value];
+    if ((old_device < numOfSMDevices) && (SM_deviceToDecode[old_device] == decode_value))
+        SM_deviceToDecode[old_device] = decodeValue_none;
+
     SM_deviceToDecoder_table [decode_value] = device;
+    SM_deviceToDecode [device] = decode_value;
 
     if (device == allFree){
         SM_decode_all_free = decode_value;
@@ -220,6 +324,73 @@ status_t SPI::SM_deviceToDecoder_set (SM_device_t device, uint8_t decode_value){
     return successful;
 }
 
+/**
+  * @brief SM_devices_set, map devices to decoder values from a table.
+  * @param const SPI_ns::SM_deviceDesc_s descs[] : can be a const table, allFree should be in it.
+  * @param uint8_t numOfDescs
+  * @return SPI_ns::status_t : failed at the first wrong descriptor.
+  */
+status_t SPI::SM_devices_set (const SM_deviceDesc_s descs[], uint8_t numOfDescs){
+    uint8_t a_count;
+
+    for (a_count = 0; a_count < numOfDescs; a_count++){
+        if (SM_deviceToDecoder_set (descs[a_count].device, descs[a_count].decodeValue) != successful)
+            return failed;
+    }
+
+    return successful;
+}
+
+/**
+  * @brief SM_deviceProfile_set, keep SPI parameters of a device, they are applied by SM_device_attach.
+  * @param SPI_ns::SM_device_t device : a device id.
+  * @param const SPI_ns::SPI_params_t *params_struct : same fields as init, NULL to remove the profile.
+  * @return SPI_ns::status_t
+  * @attention : SPI must have been init-ed once (clock, GPIOs), profiles only change SPI registers.
+  */
+status_t SPI::SM_deviceProfile_set (SM_device_t device, const SPI_params_t *params_struct){
+    SM_profile_s *profile_p;
+
+    if ((device == allFree) || (device >= numOfSMDevices))
+        return failed;
+
+    profile_p = &SM_profiles[device];
+    if (params_struct == NULL){
+        profile_p->isSet = false;
+        return successful;
+    }
+
+    /* same bits as SPI_Init */
+    profile_p->CR1 = params_struct->direction | params_struct->mode | params_struct->dataSize |
+                     params_struct->CPOL | params_struct->CPHA | params_struct->nss |
+                     params_struct->baudRatePrescaler | params_struct->firstBit;
+    profile_p->CR2 = ((params_struct->mode == SPI_Mode_Master) && (params_struct->nss == SPI_NSS_Hard)) ?
+                     SPI_CR2_SSOE : 0;
+    profile_p->CRCPR = params_struct->crcPoly;
+    profile_p->isSet = true;
+
+    if (SM_profileActive == device)
+        SM_profileActive = numOfSMDevices; // changed, write it again on next attach
+
+    return successful;
+}
+
+/**
+  * @brief SM_deviceCRC_set, integrity mode of a device, CRC is computed and checked by SPI.
+  * @param SPI_ns::SM_device_t device : a device id.
+  * @param bool isEnabled : true, DMA transfers of this device end with a CRC frame.
+  * @return SPI_ns::status_t
+  * @attention : CRC polynomial is crcPoly of init or of the device profile.
+  */
+status_t SPI::SM_deviceCRC_set (SM_device_t device, bool isEnabled){
+    if ((device == allFree) || (device >= numOfSMDevices))
+        return failed;
+
+    SM_crcModes[device] = isEnabled;
+
+    return successful;
+}
+
 /**
   * @brief SM_device_attach, attach SPI to a device if SPI is free.
   * @param SPI_ns::SM_device_t device : a device id.
@@ -227,12 +398,27 @@ status_t SPI::SM_deviceToDecoder_set (SM_device_t device, uint8_t decode_value){
   * @attention SM_deviceToDecoder_table have been set up.
   */
 status_t SPI::SM_device_attach (SM_device_t device){
-    if (this->SM_deviceInUse != allFree)
+    uint32_t primask;
+
+    /**< check and take SPI with IRQs masked, queue_submit attaches devices from ISRs */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (this->SM_deviceInUse != allFree){
+        __set_PRIMASK(primask);
         return busy;
+    }
 
     this->SM_deviceInUse = device;
-    if ( SM_decodeValueInUse_update () != successful)
+    if ( SM_decodeValueInUse_update () != successful){
+        this->SM_deviceInUse = allFree;
+        __set_PRIMASK(primask);
         return decodeValueNotFound;
+    }
+
+    __set_PRIMASK(primask);
+
+    SM_profile_apply ();
 
     return successful;
 }
@@ -244,23 +430,97 @@ status_t SPI::SM_device_attach (SM_device_t device){
   * This function will update SS_decode_value_in_use using SM_deviceInUse value;
   */
 status_t SPI::SM_decodeValueInUse_update (void){
-    uint8_t a_count;
-    bool found;
+    uint8_t decode_value;
 
-    found = false;
-    for (a_count = 0; a_count < SSDevices_max; a_count++){
-        if (SM_deviceToDecoder_table[a_count] == SM_deviceInUse){
-            found = true;
-            break;
+    if (SM_deviceInUse >= numOfSMDevices)
+        return decodeValueNotFound;
+
+    decode_value = SM_deviceToDecode[SM_deviceInUse];
+    if (decode_value == decodeValue_none)
+        return decodeValueNotFound;
+
+    SM_decodeValueInUse = decode_value;
+    return successful;
+}
+
+/**
+  * @brief SM_profile_apply, write profile of SM_deviceInUse if it isn't active yet.
+  * @return None
+  * Sequence : wait BSY = 0, disable SPI, write CRCPR, CR2, CR1, enable SPI.
+  */
+void SPI::SM_profile_apply (void){
+    SPI_TypeDef *SPIx = SPIs[usedSPI];
+    SM_profile_s *profile_p;
+
+    if ((SM_deviceInUse >= numOfSMDevices) || (SM_deviceInUse == SM_profileActive))
+        return;
+
+    profile_p = &SM_profiles[SM_deviceInUse];
+    if (!profile_p->isSet)
+        return;
+
+    while ((SPIx->SR & SPI_I2S_FLAG_BSY) != 0);
+
+    SPIx->CR1 &= (uint16_t) ~SPI_CR1_SPE;
+    SPIx->CRCPR = profile_p->CRCPR;
+    SPIx->CR2 = (SPIx->CR2 & (uint16_t) ~SPI_CR2_SSOE) | profile_p->CR2;
+    SPIx->CR1 = profile_p->CR1;
+    SPIx->CR1 = profile_p->CR1 | SPI_CR1_SPE;
+
+    SM_profileActive = SM_deviceInUse;
+}
+
+/**
+  * @brief SM_BSRRs_update, precompute one BSRR word per port for each decode value.
+  * @return None
+  * This function is called when SS lines change, so select/deselect only write BSRRs.
+  */
+void SPI::SM_BSRRs_update (void){
+    uint8_t line, port, decode_value;
+    uint32_t word;
+
+    /**< distinct ports of SS lines which have been set */
+    SM_numOfPorts = 0;
+    for (line = 0; line < SM_numOfNSSLines; line++){
+        if ((SS_pins_set & (0x01 << (line + 1))) == 0)
+            continue;
+
+        for (port = 0; port < SM_numOfPorts; port++){
+            if (SM_ports[port] == softNSS_ports[line])
+                break;
         }
+        if (port == SM_numOfPorts)
+            SM_ports[SM_numOfPorts++] = softNSS_ports[line];
     }
 
-    if (found) {
-        SM_decodeValueInUse = a_count;
-        return successful;
+    /**< set bits in low half, reset bits in high half */
+    for (decode_value = 0; decode_value < SM_numOfDevices; decode_value++){
+        for (port = 0; port < SM_numOfPorts; port++){
+            word = 0;
+            for (line = 0; line < SM_numOfNSSLines; line++){
+                if (((SS_pins_set & (0x01 << (line + 1))) == 0) || (softNSS_ports[line] != SM_ports[port]))
+                    continue;
+
+                if ((decode_value >> line) & 0x01)
+                    word |= softNSS_pins[line];
+                else
+                    word |= (uint32_t) softNSS_pins[line] << 16;
+            }
+            SM_BSRRs[decode_value][port] = word;
+        }
     }
+}
 
-    return decodeValueNotFound;
+/**
+  * @brief SM_decode_write, put a decode value on SS lines, one BSRR store per port.
+  * @param uint8_t decode_value
+  * @return None
+  */
+void SPI::SM_decode_write (uint8_t decode_value){
+    uint8_t port;
+
+    for (port = 0; port < SM_numOfPorts; port++)
+        SM_ports[port]->BSRR = SM_BSRRs[decode_value][port];
 }
 
 /**
@@ -270,11 +530,21 @@ status_t SPI::SM_decodeValueInUse_update (void){
   * This function will deslect device and set SM_deviceInUse = allFree, also set allFree value for decoder.
   */
 status_t SPI::SM_device_release (SM_device_t device){
+    uint32_t primask;
+
     if (device != SM_deviceInUse)
         return failed;
 
     SM_device_deselect(SPI::SM_deviceInUse);
     this->SM_deviceInUse = allFree;
+
+    /**< queued transactions may wait for this device */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if ((queueCount != 0) && (queueActive == NULL))
+        queue_startNext ();
+    __set_PRIMASK(primask);
+
     return successful;
 }
 
@@ -296,17 +566,7 @@ status_t SPI::SM_device_select (SM_device_t device){
     }
 
     /**< okay, all ss_lines have been set, set decode value to select device*/
-    uint8_t temp_value, i;
-    temp_value = SM_decodeValueInUse;
-
-    for (i = 0; i < SM_numOfNSSLines; i++){
-        if ((temp_value & 0x01) == 0)
-            GPIO_ResetBits (softNSS_ports[i], softNSS_pins[i]);
-        else
-            GPIO_SetBits (softNSS_ports[i], softNSS_pins[i]);
-
-        temp_value = temp_value >> 1;
-    }
+    SM_decode_write (SM_decodeValueInUse);
 
     return successful;
 }
@@ -329,17 +589,7 @@ status_t SPI::SM_device_deselect (SM_device_t device){
     }
 
     /**< okay, set decoder's value to all_free */
-    uint8_t temp_value, i;
-    temp_value = SM_decode_all_free;
-
-    for (i = 0; i < SM_numOfNSSLines; i++){
-        if ((temp_value & 0x01) == 0)
-            GPIO_ResetBits (softNSS_ports[i], softNSS_pins[i]);
-        else
-            GPIO_SetBits (softNSS_ports[i], softNSS_pins[i]);
-
-        temp_value = temp_value >> 1;
-    }
+    SM_decode_write (SM_decode_all_free);
 
     return successful;
 }
@@ -375,8 +625,541 @@ uint16_t SPI::M2F_sendAndGet_blocking (SM_device_t device, uint16_t data){
 
 /**< master 2 lines, full duplex interface */
 
+/**< DMA bulk transfer */
+
+/**
+  * @brief transfer, DMA bulk transfer, blocking.
+  * @param SPI_ns::SM_device_t device : a device id.
+  * @param const uint8_t *txBuf : data to send, NULL to send 0xFF (RX only).
+  * @param uint8_t *rxBuf : received data, NULL to drop them (TX only).
+  * @param uint16_t len : number of data frames (bytes, or words with 16-bit data size).
+  * @return SPI_ns::status_t : busy if DMA channels are used by another driver, crcError in integrity mode.
+  * @attention : don't call it from an ISR with priority higher than or equal to DMA IRQs.
+  * - The device called this function has attached successfully before. Otherwise, there will be an infinite loop.
+  */
+status_t SPI::transfer (SM_device_t device, const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len){
+    status_t retval;
+
+    retval = transfer (device, txBuf, rxBuf, len, NULL, NULL);
+    if (retval != successful)
+        return retval;
+
+    while (dmaBusy);
+
+    return dmaStatus;
+}
+
+/**
+  * @brief transfer, DMA bulk transfer, done_p is called when it's finished.
+  * @param SPI_ns::SM_device_t device : a device id.
+  * @param const uint8_t *txBuf : data to send, NULL to send 0xFF (RX only).
+  * @param uint8_t *rxBuf : received data, NULL to drop them (TX only).
+  * @param uint16_t len : number of data frames (bytes, or words with 16-bit data size).
+  * @param SPI_ns::transferDone_t done_p : called in DMA ISR context, can be NULL.
+  * @param void *doneArg : passed to done_p.
+  * @return SPI_ns::status_t : busy if a transfer is running or DMA channels are used by another driver.
+  * @attention : buffers must stay valid until transfer is finished.
+  * - The device called this function has attached successfully before. Otherwise, there will be an infinite loop.
+  */
+status_t SPI::transfer (SM_device_t device, const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len,
+                        transferDone_t done_p, void *doneArg){
+    DMA_InitTypeDef DMA_InitStruct;
+    DMA_Channel_TypeDef *rxChannel, *txChannel;
+    bool is16b;
+
+    /**< check device */
+    if (device != SM_deviceInUse){
+        while (1);
+    }
+
+    if ((len == 0) || ((txBuf == NULL) && (rxBuf == NULL)))
+        return failed;
+    if (dmaBusy)
+        return busy;
+
+    /**< claim DMA channels, RX channel reports the end of transfer */
+    if (DMA_channel_claim (SPI_RXDMAs[usedSPI], dmaRx_handler, this) != DMA_ns::successful)
+        return busy;
+    if (DMA_channel_claim (SPI_TXDMAs[usedSPI], NULL, this) != DMA_ns::successful){
+        DMA_channel_release (SPI_RXDMAs[usedSPI], this);
+        return busy;
+    }
+    rxChannel = DMA_channel_get (SPI_RXDMAs[usedSPI]);
+    txChannel = DMA_channel_get (SPI_TXDMAs[usedSPI]);
+
+    is16b = ((SPIs[usedSPI]->CR1 & SPI_DataSize_16b) != 0);
+
+    /* CRC is reset for each transfer of a device in integrity mode */
+    dmaCRC = SM_crcModes[device];
+    crc_reset (dmaCRC);
+
+    /* drop stale data */
+    if (SPI_I2S_GetFlagStatus(SPIs[usedSPI], SPI_I2S_FLAG_RXNE) == SET)
+        SPI_I2S_ReceiveData (SPIs[usedSPI]);
+
+    /**< RX channel */
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &SPIs[usedSPI]->DR;
+    DMA_InitStruct.DMA_MemoryBaseAddr = (rxBuf != NULL) ? (uint32_t) rxBuf : (uint32_t) &dmaDummy;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStruct.DMA_BufferSize = len;
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStruct.DMA_MemoryInc = (rxBuf != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStruct.DMA_PeripheralDataSize = is16b ? DMA_PeripheralDataSize_HalfWord : DMA_PeripheralDataSize_Byte;
+    DMA_InitStruct.DMA_MemoryDataSize = is16b ? DMA_MemoryDataSize_HalfWord : DMA_MemoryDataSize_Byte;
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_VeryHigh; // RX before TX, no overrun
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init (rxChannel, &DMA_InitStruct);
+
+    /**< TX channel */
+    DMA_InitStruct.DMA_MemoryBaseAddr = (txBuf != NULL) ? (uint32_t) txBuf : (uint32_t) &SPI_dmaTxDummy;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStruct.DMA_MemoryInc = (txBuf != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_High;
+    DMA_Init (txChannel, &DMA_InitStruct);
+
+    dmaDone_p = done_p;
+    dmaDoneArg = doneArg;
+    dmaStatus = successful;
+    dmaBusy = true;
+
+    DMA_ITConfig (rxChannel, DMA_IT_TC | DMA_IT_TE, ENABLE);
+    DMA_Cmd (rxChannel, ENABLE);
+    DMA_Cmd (txChannel, ENABLE);
+    SPI_I2S_DMACmd (SPIs[usedSPI], SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+    return successful;
+}
+
+/**
+  * @brief transfer_isBusy
+  * @return bool : true if a DMA transfer is running.
+  */
+bool SPI::transfer_isBusy (void){
+    return dmaBusy;
+}
+
+/**
+  * @brief crcErrors_get
+  * @return uint32_t : number of transfers which ended with crcError.
+  */
+uint32_t SPI::crcErrors_get (void){
+    return crcErrors;
+}
+
+/**
+  * @brief crc_reset, CRCEN is toggled (SPI disabled) to clear CRC registers, or cleared.
+  * @param bool isEnabled : CRC for next transfer.
+  * @return None
+  */
+void SPI::crc_reset (bool isEnabled){
+    SPI_TypeDef *SPIx = SPIs[usedSPI];
+
+    if (!isEnabled && ((SPIx->CR1 & SPI_CR1_CRCEN) == 0))
+        return; // nothing to do, most transfers
+
+    while ((SPIx->SR & SPI_I2S_FLAG_BSY) != 0);
+
+    SPIx->CR1 &= (uint16_t) ~SPI_CR1_SPE;
+    SPIx->CR1 &= (uint16_t) ~SPI_CR1_CRCEN;
+    if (isEnabled){
+        SPIx->CR1 |= SPI_CR1_CRCEN;
+        SPIx->SR = (uint16_t) ~SPI_FLAG_CRCERR;
+    }
+    SPIx->CR1 |= SPI_CR1_SPE;
+}
+
+/**
+  * @brief dma_stop, stop DMA requests and give back DMA channels.
+  * @return None
+  */
+void SPI::dma_stop (void){
+    SPI_I2S_DMACmd (SPIs[usedSPI], SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+    DMA_channel_release (SPI_TXDMAs[usedSPI], this);
+    DMA_channel_release (SPI_RXDMAs[usedSPI], this);
+}
+
+/**
+  * @brief dmaRx_handler, end of transfer (DMA ISR context).
+  * @param void *arg : SPI object.
+  * @param uint32_t flags : DMA_ns::flag_xx.
+  * @return None
+  */
+void SPI::dmaRx_handler (void *arg, uint32_t flags){
+    SPI *spi_p = (SPI *) arg;
+
+    if ((flags & (DMA_ns::flag_TC | DMA_ns::flag_TE)) == 0)
+        return;
+
+    spi_p->dma_stop ();
+    spi_p->dmaStatus = ((flags & DMA_ns::flag_TE) != 0) ? failed : successful;
+
+    /* integrity mode : TX CRC is sent by hardware after TX DMA, RX CRC comes after the last data frame */
+    if (spi_p->dmaCRC && (spi_p->dmaStatus == successful)){
+        SPI_TypeDef *SPIx = SPIs[spi_p->usedSPI];
+
+        while ((SPIx->SR & SPI_I2S_FLAG_RXNE) == 0); // one frame time
+        SPI_I2S_ReceiveData (SPIx); // CRC frame of the device
+        if ((SPIx->SR & SPI_FLAG_CRCERR) != 0){
+            SPIx->SR = (uint16_t) ~SPI_FLAG_CRCERR;
+            spi_p->dmaStatus = crcError;
+            spi_p->crcErrors++;
+        }
+    }
+    spi_p->dmaBusy = false;
+
+    if (spi_p->dmaDone_p != NULL)
+        spi_p->dmaDone_p (spi_p->dmaDoneArg, spi_p->dmaStatus);
+}
+
+/**< end DMA bulk transfer */
+
+/**< transaction queue */
+
+/**
+  * @brief queue_submit, queue a transaction, it's started at once if SPI is free.
+  * @param SPI_ns::transaction_s *trans_p : must stay valid until trans_p->done_p is called.
+  * @return SPI_ns::status_t : busy if queue is full.
+  * @attention : can be called from tasks or ISRs.
+  * - trans_p->status is busy until the transaction is finished, then it's the result of the transfer
+  * (busy if DMA channels are used by another driver, failed on decoder or DMA error).
+  */
+status_t SPI::queue_submit (transaction_s *trans_p){
+    uint32_t primask;
+    uint8_t index;
+
+    if ((trans_p == NULL) || (trans_p->device == allFree) || (trans_p->len == 0))
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (queueCount >= queue_size){
+        __set_PRIMASK(primask);
+        return busy;
+    }
+
+    index = queueHead + queueCount;
+    if (index >= queue_size)
+        index -= queue_size;
+
+    trans_p->status = busy;
+    queue[index] = trans_p;
+    queueCount++;
+
+    /* from a done_p of the queue, the transaction is started when done_p returns */
+    if ((queueActive == NULL) && !queueInCallback)
+        queue_startNext ();
+
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+  * @brief queue_pending
+  * @return uint8_t : number of transactions queued or running.
+  */
+uint8_t SPI::queue_pending (void){
+    return queueCount;
+}
+
+/**
+  * @brief queue_startNext, start head transaction, or release the device when queue is empty.
+  * @return None
+  * @attention : called with IRQs disabled or from DMA ISR.
+  */
+void SPI::queue_startNext (void){
+    transaction_s *trans_p;
+    status_t retval;
+
+    if (dmaBusy || (queueActive != NULL) || queueInCallback)
+        return;
+
+    while (queueCount != 0){
+        trans_p = queue[queueHead];
+
+        /**< rest of a CS window cut by a failed part, up to its last part */
+        if (trans_p->device == queueCutDevice){
+            if (trans_p->cs != cs_keep)
+                queueCutDevice = allFree;
+            queue_pop ();
+            queue_done (trans_p, failed);
+            continue;
+        }
+
+        if ((SM_deviceInUse != allFree) && !queueAttached)
+            return; // attached by hand, SM_device_release will restart the queue
+
+        /**< switch device */
+        if (SM_deviceInUse != trans_p->device){
+            queue_release ();
+            if (SM_device_attach (trans_p->device) != successful){
+                queue_pop ();
+                queue_done (trans_p, failed);
+                continue;
+            }
+            queueAttached = true;
+        }
+
+        if ((trans_p->cs != cs_none) && !queueSelected){
+            SM_device_select (trans_p->device);
+            queueSelected = true;
+        }
+
+        queueActive = trans_p;
+        retval = transfer (trans_p->device, trans_p->txBuf, trans_p->rxBuf, trans_p->len, queue_transferDone, this);
+        if (retval == successful)
+            return;
+
+        /**< couldn't start, finish it and the rest of its CS window */
+        queueActive = NULL;
+        queue_pop ();
+        if (queueSelected){
+            SM_device_deselect (SM_deviceInUse);
+            queueSelected = false;
+        }
+        if (trans_p->cs == cs_keep)
+            queueCutDevice = trans_p->device;
+        queue_done (trans_p, retval);
+    }
+
+    /**< empty, keep device if last transaction wants CS kept */
+    if (!queueSelected)
+        queue_release ();
+}
+
+/**
+  * @brief queue_pop, remove head transaction.
+  * @return None
+  */
+void SPI::queue_pop (void){
+    queueHead = (queueHead + 1 == queue_size) ? 0 : queueHead + 1;
+    queueCount--;
+}
+
+/**
+  * @brief queue_done, give the result of a transaction to its owner.
+  * Transactions submitted by done_p are only queued, the caller starts them after.
+  * @param SPI_ns::transaction_s *trans_p : removed from the queue.
+  * @param SPI_ns::status_t status
+  * @return None
+  */
+void SPI::queue_done (transaction_s *trans_p, status_t status){
+    bool wasInCallback = queueInCallback;
+
+    trans_p->status = status;
+    if (trans_p->done_p == NULL)
+        return;
+
+    queueInCallback = true;
+    trans_p->done_p (trans_p->doneArg, status);
+    queueInCallback = wasInCallback;
+}
+
+/**
+  * @brief queue_release, deselect and release device attached by the queue.
+  * @return None
+  */
+void SPI::queue_release (void){
+    if (!queueAttached)
+        return;
+
+    SM_device_deselect (SM_deviceInUse);
+    SM_deviceInUse = allFree;
+    queueAttached = false;
+    queueSelected = false;
+}
+
+/**
+  * @brief queue_transferDone, end of a queued transaction (DMA ISR context).
+  * @param void *arg : SPI object.
+  * @param SPI_ns::status_t status : result of transfer.
+  * @return None
+  */
+void SPI::queue_transferDone (void *arg, status_t status){
+    SPI *spi_p = (SPI *) arg;
+    transaction_s *trans_p = spi_p->queueActive;
+
+    if (trans_p == NULL)
+        return;
+
+    spi_p->queueActive = NULL;
+    spi_p->queue_pop ();
+
+    /* a failed transfer ends the CS window, the rest of the command is meaningless */
+    if (((trans_p->cs != cs_keep) || (status != successful)) && spi_p->queueSelected){
+        spi_p->SM_device_deselect (spi_p->SM_deviceInUse);
+        spi_p->queueSelected = false;
+    }
+
+    if ((trans_p->cs == cs_keep) && (status != successful))
+        spi_p->queueCutDevice = trans_p->device;
+
+    spi_p->queue_done (trans_p, status);
+    spi_p->queue_startNext ();
+}
+
+/**< end transaction queue */
+
 /**< -------------- master mode --------------------------------*/
 
+/**< -------------- slave mode ---------------------------------*/
+
+/**
+  * @brief S2F_start, slave 2 lines full duplex, DMA runs ping-pong buffers in circular mode.
+  * @param uint8_t *rxBuf : 2 * halfLen frames, NULL to drop received data.
+  * @param const uint8_t *txBuf : 2 * halfLen frames, NULL to send 0xFF.
+  * @param uint16_t halfLen : frames (bytes, or words with 16-bit data size) of one half.
+  * @param SPI_ns::slaveDone_t done_p : called in DMA ISR context when a half is done, can be NULL.
+  * @param void *doneArg : passed to done_p.
+  * @return SPI_ns::status_t : busy if a transfer is running or DMA channels are used by another driver.
+  * @attention : SPI has been init-ed in slave mode, buffers must stay valid until S2F_stop.
+  */
+status_t SPI::S2F_start (uint8_t *rxBuf, const uint8_t *txBuf, uint16_t halfLen,
+                         slaveDone_t done_p, void *doneArg){
+    DMA_InitTypeDef DMA_InitStruct;
+    DMA_Channel_TypeDef *rxChannel, *txChannel;
+    bool is16b;
+
+    if ((halfLen == 0) || (halfLen > 0x7FFF) || ((SPIs[usedSPI]->CR1 & SPI_CR1_MSTR) != 0))
+        return failed;
+    if (dmaBusy || S2F_running)
+        return busy;
+
+    /**< claim DMA channels, RX channel reports halves */
+    if (DMA_channel_claim (SPI_RXDMAs[usedSPI], S2F_dmaRx_handler, this) != DMA_ns::successful)
+        return busy;
+    if (DMA_channel_claim (SPI_TXDMAs[usedSPI], NULL, this) != DMA_ns::successful){
+        DMA_channel_release (SPI_RXDMAs[usedSPI], this);
+        return busy;
+    }
+    rxChannel = DMA_channel_get (SPI_RXDMAs[usedSPI]);
+    txChannel = DMA_channel_get (SPI_TXDMAs[usedSPI]);
+
+    is16b = ((SPIs[usedSPI]->CR1 & SPI_DataSize_16b) != 0);
+
+    /* drop stale data */
+    if (SPI_I2S_GetFlagStatus(SPIs[usedSPI], SPI_I2S_FLAG_RXNE) == SET)
+        SPI_I2S_ReceiveData (SPIs[usedSPI]);
+
+    /**< RX channel, circular on both halves */
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &SPIs[usedSPI]->DR;
+    DMA_InitStruct.DMA_MemoryBaseAddr = (rxBuf != NULL) ? (uint32_t) rxBuf : (uint32_t) &dmaDummy;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStruct.DMA_BufferSize = 2 * halfLen;
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStruct.DMA_MemoryInc = (rxBuf != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStruct.DMA_PeripheralDataSize = is16b ? DMA_PeripheralDataSize_HalfWord : DMA_PeripheralDataSize_Byte;
+    DMA_InitStruct.DMA_MemoryDataSize = is16b ? DMA_MemoryDataSize_HalfWord : DMA_MemoryDataSize_Byte;
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_VeryHigh; // master sets the pace, no overrun
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init (rxChannel, &DMA_InitStruct);
+
+    /**< TX channel, circular, first frame goes to DR at once */
+    DMA_InitStruct.DMA_MemoryBaseAddr = (txBuf != NULL) ? (uint32_t) txBuf : (uint32_t) &SPI_dmaTxDummy;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStruct.DMA_MemoryInc = (txBuf != NULL) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_High;
+    DMA_Init (txChannel, &DMA_InitStruct);
+
+    S2F_done_p = done_p;
+    S2F_doneArg = doneArg;
+    S2F_halfOwned[0] = false;
+    S2F_halfOwned[1] = false;
+    S2F_running = true;
+    dmaBusy = true; // no master transfer meanwhile
+
+    DMA_ITConfig (rxChannel, DMA_IT_HT | DMA_IT_TC | DMA_IT_TE, ENABLE);
+    DMA_Cmd (rxChannel, ENABLE);
+    DMA_Cmd (txChannel, ENABLE);
+    SPI_I2S_DMACmd (SPIs[usedSPI], SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+    return successful;
+}
+
+/**
+  * @brief S2F_stop, stop DMA ping-pong, data of an unfinished half are dropped.
+  * @return SPI_ns::status_t : failed if slave isn't running.
+  */
+status_t SPI::S2F_stop (void){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!S2F_running){
+        __set_PRIMASK(primask);
+        return failed;
+    }
+
+    dma_stop ();
+    S2F_running = false;
+    dmaBusy = false;
+
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+  * @brief S2F_half_release, application has finished with a half (RX read, TX refilled).
+  * @param uint8_t half : 0 or 1, given by done_p.
+  * @return None
+  */
+void SPI::S2F_half_release (uint8_t half){
+    S2F_halfOwned[half & 0x01] = false;
+}
+
+/**
+  * @brief S2F_isRunning
+  * @return bool
+  */
+bool SPI::S2F_isRunning (void){
+    return S2F_running;
+}
+
+/**
+  * @brief S2F_overruns_get
+  * @return uint32_t : halves which were done again before the application released them.
+  */
+uint32_t SPI::S2F_overruns_get (void){
+    return S2F_overruns;
+}
+
+/**
+  * @brief S2F_dmaRx_handler, a half is done (DMA ISR context), HT : half 0, TC : half 1.
+  * @param void *arg : SPI object.
+  * @param uint32_t flags : DMA_ns::flag_xx.
+  * @return None
+  */
+void SPI::S2F_dmaRx_handler (void *arg, uint32_t flags){
+    SPI *spi_p = (SPI *) arg;
+    uint8_t half;
+
+    if ((flags & DMA_ns::flag_TE) != 0){
+        spi_p->S2F_stop ();
+        if (spi_p->S2F_done_p != NULL)
+            spi_p->S2F_done_p (spi_p->S2F_doneArg, 0, failed);
+        return;
+    }
+
+    for (half = 0; half < 2; half++){
+        if ((flags & ((half == 0) ? DMA_ns::flag_HT : DMA_ns::flag_TC)) == 0)
+            continue;
+
+        if (spi_p->S2F_halfOwned[half])
+            spi_p->S2F_overruns++; // application is late, half has been overwritten
+        spi_p->S2F_halfOwned[half] = true;
+
+        if (spi_p->S2F_done_p != NULL)
+            spi_p->S2F_done_p (spi_p->S2F_doneArg, half, successful);
+    }
+}
+
+/**< -------------- slave mode ---------------------------------*/
+
 /**< -------------- misc functions ------------------------------*/
 
 /**
@@ -391,5 +1174,24 @@ uint8_t SPI::misc_MISO_read (void){
 
 	return GPIO_ReadInputDataBit (MISO_ports[usedSPI][remap_value], MISO_pins[usedSPI][remap_value]);
 }
+
+/**
+  * @brief misc_MISO_EXTISource_get, EXTI source of MISO pin of using SPI (for GPIO_EXTILineConfig),
+  * devices which signal "ready" on their SO line use it instead of polling misc_MISO_read.
+  * @param uint8_t *portSource_p : GPIO_PortSourceGPIOx.
+  * @param uint8_t *pinSource_p : GPIO_PinSourcex, EXTI line is (0x01 << pinSource).
+  * @return None
+  */
+void SPI::misc_MISO_EXTISource_get (uint8_t *portSource_p, uint8_t *pinSource_p){
+	bool remap_value = GPIO_isRemap [usedSPI];
+	uint16_t pin = MISO_pins[usedSPI][remap_value];
+	uint8_t pinSource = 0;
+
+	while ((pin >> pinSource) != 0x01)
+		pinSource++;
+
+	*portSource_p = (MISO_ports[usedSPI][remap_value] == GPIOA) ? GPIO_PortSourceGPIOA : GPIO_PortSourceGPIOB;
+	*pinSource_p = pinSource;
+}
 /**< -------------- misc functions ------------------------------*/
 
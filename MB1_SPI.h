@@ -11,12 +11,40 @@
  * ------ master mode ---------
  * - Set up numOfSSLines.
  * - Set up GPIO for NSS lines by calling SM_NSS_GPIOs_set.
- * - Set up device-to-decoder table by calling SM_deviceToDecoder_set (remember to set decode value for allFree).
+ * - Set up device-to-decoder table by calling SM_deviceToDecoder_set (remember to set decode value for allFree),
+ *   or all at once from a const table of SM_deviceDesc_s by SM_devices_set.
+ *   Decoder patterns are kept as one BSRR word per port, select/deselect is one store per port
+ *   (one store when all SS lines are on the same port), attach is a table lookup.
+ * - Devices with different clock/mode on one bus : SM_deviceProfile_set (device, &params) once,
+ *   the profile is kept as CR1/CR2/CRCPR values and written by attach (disable, write, enable),
+ *   nothing is written if the profile is already active.
  * - When using SPI :
  *  + init SPI.
  *  + attach SPI to a device.
  *  + do somethings.
  *  + after finished, release SPI, so other device can use.
+ * - Bulk transfers : transfer (device, txBuf, rxBuf, len) by DMA, blocking, or with a callback
+ *   (done_p is called in DMA ISR context). txBuf = NULL sends 0xFF (RX only), rxBuf = NULL
+ *   drops received data (TX only). With 16-bit data size, buffers are uint16_t arrays and len
+ *   is in words. DMA channels (SPI1 : DMA1 ch2/ch3, SPI2 : DMA1 ch4/ch5) are shared with USARTs,
+ *   they are claimed for each transfer (busy if a USART owns them).
+ * - Transaction queue : queue_submit (&transaction) from tasks or ISRs, transactions run back to back
+ *   by DMA, the queue attaches/selects/deselects/releases devices itself. A device attached by hand
+ *   holds the queue until it's released. SPI1 and SPI2 queues run at the same time.
+ *   Parts of a CS window (cs_keep, then the last part) are submitted with IRQs masked. If a part fails,
+ *   the next parts of its window fail too (even if they are submitted after), they don't run on a new CS.
+ * - Integrity mode : SM_deviceCRC_set (device, true), DMA transfers (transfer, queue) of this device
+ *   are followed by a CRC frame (CRC-8 or CRC-16 with data size, polynomial crcPoly) computed by SPI
+ *   on the fly. The CRC of the device is checked by hardware, a mismatch ends the transfer with crcError.
+ *   Buffers and len don't include the CRC frame. The device must send its CRC after the data too.
+ * ------ slave mode ---------
+ * - init with mode = SPI_Mode_Slave, direction = SPI_Direction_2Lines_FullDuplex, nss = SPI_NSS_Hard
+ *   (NSS pin : PA4 for SPI1, PB12 for SPI2, bus is ignored while NSS is high).
+ * - S2F_start (rxBuf, txBuf, halfLen, done_p, arg) : rxBuf and txBuf hold 2 halves (ping-pong) of halfLen,
+ *   DMA runs them in circular mode, the bus never stops and the CPU does nothing per word.
+ * - done_p (arg, half, status) is called (DMA ISR context) when RX half is full : the half now belongs
+ *   to the application, it reads RX half and refills TX half (sent on next round), then S2F_half_release.
+ *   A half which isn't released when DMA wraps onto it again is counted in S2F_overruns_get.
  */
 
 #ifndef _MB1_SPI_H_
@@ -25,6 +53,7 @@
 /* Includes */
 #include "MB1_Glb.h"
 #include "MB1_Misc.h"
+#include "MB1_DMA.h"
 
 namespace SPI_ns{
 
@@ -40,10 +69,14 @@ typedef enum {
     successful,
     failed,
     busy,
-    decodeValueNotFound
+    decodeValueNotFound,
+    crcError        // integrity mode, CRC received from the device doesn't match
 
 } status_t;
 
+/**< called in DMA ISR context when a DMA transfer is finished (failed on DMA transfer error) */
+typedef void (* transferDone_t) (void *arg, status_t status);
+
 /**< end SPI_global */
 
 
@@ -77,13 +110,60 @@ typedef enum {
     allFree,
     cc2530_1,
     at25Flash_1,
-    at25Flash_2
+    at25Flash_2,
 
+    numOfSMDevices  // not a device, add new devices above
 } SM_device_t;
 
+/**< device descriptor, tables of these can be const (in flash) */
+typedef struct {
+    SM_device_t device;
+    uint8_t decodeValue;
+} SM_deviceDesc_s;
+
+const uint8_t decodeValue_none = 0xFF;
+
+/**< SPI_params_t precompiled to register values */
+typedef struct {
+    uint16_t CR1;   // without SPE
+    uint16_t CR2;   // SSOE only, other bits (DMA, IRQ) are kept
+    uint16_t CRCPR;
+    bool isSet;
+} SM_profile_s;
+
 /**< end slave_mgr */
 
+/**< transaction queue */
+/**< chip select of a queued transaction */
+typedef enum {
+    cs_auto,    // select before, deselect after
+    cs_keep,    // select before (if not yet), keep selected after, for next transaction of same device
+    cs_none     // CS is not touched (e.g. device drives its own CS)
+} cs_t;
+
+/**< queued transaction, owned by caller, must stay valid until done_p is called */
+typedef struct {
+    SM_device_t device;
+    const uint8_t *txBuf;       // NULL : send 0xFF
+    uint8_t *rxBuf;             // NULL : drop received data
+    uint16_t len;
+    cs_t cs;
+    transferDone_t done_p;      // DMA ISR context, can be NULL
+    void *doneArg;
+    volatile status_t status;   // busy while queued or running
+} transaction_s;
+
+const uint8_t queue_size = 8;
+/**< end transaction queue */
+
 /**< -------------- master mode --------------------------------*/
+
+/**< -------------- slave mode ---------------------------------*/
+
+/**< half (0 or 1) of ping-pong buffers is done, DMA ISR context, failed on DMA error (slave is stopped) */
+typedef void (* slaveDone_t) (void *arg, uint8_t half, status_t status);
+
+/**< -------------- slave mode ---------------------------------*/
 }
 
 class SPI {
@@ -104,6 +184,9 @@ public:
     SPI_ns::status_t SM_numOfSSLines_set (uint8_t numOfSSLines);
     SPI_ns::status_t SM_GPIO_set (SPI_ns::SM_GPIOParams_s *params_struct);
     SPI_ns::status_t SM_deviceToDecoder_set (SPI_ns::SM_device_t device, uint8_t decode_value);
+    SPI_ns::status_t SM_devices_set (const SPI_ns::SM_deviceDesc_s descs[], uint8_t numOfDescs);
+    SPI_ns::status_t SM_deviceProfile_set (SPI_ns::SM_device_t device, const SPI_ns::SPI_params_t *params_struct);
+    SPI_ns::status_t SM_deviceCRC_set (SPI_ns::SM_device_t device, bool isEnabled);
     /**< conf (run-time) */
 
     SPI_ns::status_t SM_device_attach (SPI_ns::SM_device_t device);
@@ -119,12 +202,38 @@ public:
 
     /**< master 2 lines, full duplex interface */
 
+    /**< DMA bulk transfer */
+    SPI_ns::status_t transfer (SPI_ns::SM_device_t device, const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len);
+    SPI_ns::status_t transfer (SPI_ns::SM_device_t device, const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len,
+                               SPI_ns::transferDone_t done_p, void *doneArg);
+    bool transfer_isBusy (void);
+    uint32_t crcErrors_get (void);
+    /**< end DMA bulk transfer */
+
+    /**< transaction queue */
+    SPI_ns::status_t queue_submit (SPI_ns::transaction_s *trans_p);
+    uint8_t queue_pending (void);
+    /**< end transaction queue */
+
     /**< misc functions */
     uint8_t misc_MISO_read (void);
+    void misc_MISO_EXTISource_get (uint8_t *portSource_p, uint8_t *pinSource_p);
     /**< misc functions */
 
     /**< -------------- master mode --------------------------------*/
 
+    /**< -------------- slave mode ---------------------------------*/
+
+    /**< slave 2 lines, full duplex, DMA ping-pong */
+    SPI_ns::status_t S2F_start (uint8_t *rxBuf, const uint8_t *txBuf, uint16_t halfLen,
+                                SPI_ns::slaveDone_t done_p, void *doneArg);
+    SPI_ns::status_t S2F_stop (void);
+    void S2F_half_release (uint8_t half);
+    bool S2F_isRunning (void);
+    uint32_t S2F_overruns_get (void);
+
+    /**< -------------- slave mode ---------------------------------*/
+
 private:
     uint16_t usedSPI;
 
@@ -134,6 +243,7 @@ private:
     uint32_t softNSS_RCCs [SPI_ns::SSLines_max];
 
     void M2F_GPIOs_Init (void);
+    void S2F_GPIOs_Init (bool isHardNSS);
     /**< end app_conf */
 
     /**< -------------- master mode --------------------------------*/
@@ -148,11 +258,68 @@ private:
     uint8_t SM_decodeValueInUse; // use to select a device, only change when device_in_use change in attach fucntion.
     uint8_t SM_decode_all_free; // use when deselect a device, it set only after set decode value for SPI_allFree.
 
+    /* precomputed decoder patterns */
+    uint8_t SM_deviceToDecode [SPI_ns::numOfSMDevices]; // decodeValue_none if not mapped
+    GPIO_TypeDef * SM_ports [SPI_ns::SSLines_max];     // distinct ports of SS lines
+    uint8_t SM_numOfPorts;
+    uint32_t SM_BSRRs [SPI_ns::SSDevices_max][SPI_ns::SSLines_max]; // [decode value][port]
+
+    /* per-device profiles */
+    SPI_ns::SM_profile_s SM_profiles [SPI_ns::numOfSMDevices];
+    SPI_ns::SM_device_t SM_profileActive; // numOfSMDevices : registers don't hold a profile
+
+    /* integrity mode (hardware CRC) of devices */
+    bool SM_crcModes [SPI_ns::numOfSMDevices];
+
     SPI_ns::status_t SM_decodeValueInUse_update (void);
+    void SM_profile_apply (void);
+    void SM_BSRRs_update (void);
+    void SM_decode_write (uint8_t decode_value);
 
     /**< end slave_mgr */
 
+    /**< DMA bulk transfer */
+    volatile bool dmaBusy;
+    volatile SPI_ns::status_t dmaStatus;
+    SPI_ns::transferDone_t dmaDone_p;
+    void *dmaDoneArg;
+    uint16_t dmaDummy; // RX sink when rxBuf is NULL
+    bool dmaCRC;        // running transfer is followed by a CRC frame
+    uint32_t crcErrors;
+
+    void dma_stop (void);
+    void crc_reset (bool isEnabled);
+    static void dmaRx_handler (void *arg, uint32_t flags);
+    /**< end DMA bulk transfer */
+
+    /**< transaction queue */
+    SPI_ns::transaction_s *queue [SPI_ns::queue_size];
+    uint8_t queueHead;
+    volatile uint8_t queueCount;
+    SPI_ns::transaction_s *queueActive;
+    bool queueAttached;     // device in use has been attached by the queue
+    bool queueSelected;     // CS of device in use is asserted by the queue
+    bool queueInCallback;   // a done_p of the queue is running, queue_submit only queues
+    SPI_ns::SM_device_t queueCutDevice;  // CS window cut by a failed part, its next parts fail
+
+    void queue_startNext (void);
+    void queue_pop (void);
+    void queue_done (SPI_ns::transaction_s *trans_p, SPI_ns::status_t status);
+    void queue_release (void);
+    static void queue_transferDone (void *arg, SPI_ns::status_t status);
+    /**< end transaction queue */
+
     /**< -------------- master mode --------------------------------*/
+
+    /**< -------------- slave mode ---------------------------------*/
+    bool S2F_running;
+    SPI_ns::slaveDone_t S2F_done_p;
+    void *S2F_doneArg;
+    volatile bool S2F_halfOwned [2];   // half is used by the application
+    volatile uint32_t S2F_overruns;
+
+    static void S2F_dmaRx_handler (void *arg, uint32_t flags);
+    /**< -------------- slave mode ---------------------------------*/
 };
 
 
@@ -14,12 +14,19 @@
  * @brief
  * Implement USART's functions for STM32 \n
  * The supported UARTs are form USART1 to UART5. \n
- * The communication are fixed : 8 bit data, 1 stop bit, no parity, no flow control  \n
+ * The communication is 8 bit data, 1 stop bit, no parity, no flow control by default  \n
+ * word length, parity, stop bits and RTS/CTS (USART1 to USART3) can be set by Restart(lineConf). \n
+ * TX is polling by default, or interrupt-driven through a ring buffer set by TxBuffer_set. \n
+ * Bulk buffers can be queued to DMA TX by OutDMA (USART1 to UART4, UART5 has no DMA). \n
+ * RX can be circular DMA (DmaRx_enable), frames are delimited by IDLE line. \n
+ * On multi-drop buses (RS-485), Mute_enable keeps RX muted until a matching address mark. \n
  * @attention
  * The USARTs must be initialized first or an infinitive wait will be executed
  */
 
 #include "MB1_Serial_t.h"
+#include "string.h"
+#include "errno.h"
 
 #define NUM_UARTs  5
 const uint16_t       _USART_TXD_PIN[NUM_UARTs]  = {GPIO_Pin_9,  GPIO_Pin_2, GPIO_Pin_10, GPIO_Pin_10, GPIO_Pin_12};
@@ -31,11 +38,39 @@ const uint32_t       _USART_RXD_CLK[NUM_UARTs]  = {RCC_APB2Periph_GPIOA, RCC_APB
 const uint32_t       _USART_CLK[NUM_UARTs]      = {RCC_APB2Periph_USART1, RCC_APB1Periph_USART2, RCC_APB1Periph_USART3, RCC_APB1Periph_UART4, RCC_APB1Periph_UART5};
       USART_TypeDef* _USARTs[NUM_UARTs]         = {USART1, USART2, USART3, UART4, UART5};
 
+/* hardware flow control pins (no remap), UART4 and UART5 have no RTS/CTS */
+const uint16_t       _USART_CTS_PIN[NUM_UARTs]  = {GPIO_Pin_11, GPIO_Pin_0, GPIO_Pin_13, 0, 0};
+const uint16_t       _USART_RTS_PIN[NUM_UARTs]  = {GPIO_Pin_12, GPIO_Pin_1, GPIO_Pin_14, 0, 0};
+      GPIO_TypeDef*  _USART_CTS_PORT[NUM_UARTs] = {GPIOA, GPIOA, GPIOB, NULL, NULL};
+      GPIO_TypeDef*  _USART_RTS_PORT[NUM_UARTs] = {GPIOA, GPIOA, GPIOB, NULL, NULL};
+const uint32_t       _USART_CTS_CLK[NUM_UARTs]  = {RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOB, 0, 0};
+const uint32_t       _USART_RTS_CLK[NUM_UARTs]  = {RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOB, 0, 0};
+const uint8_t        _USART_IRQn[NUM_UARTs]     = {USART1_IRQn, USART2_IRQn, USART3_IRQn, UART4_IRQn, UART5_IRQn};
+const DMA_ns::channel_t _USART_TXDMA[NUM_UARTs] = {DMA_ns::DMA1_ch4, DMA_ns::DMA1_ch7, DMA_ns::DMA1_ch2, DMA_ns::DMA2_ch5, DMA_ns::noChannel};
+const DMA_ns::channel_t _USART_RXDMA[NUM_UARTs] = {DMA_ns::DMA1_ch5, DMA_ns::DMA1_ch6, DMA_ns::DMA1_ch3, DMA_ns::DMA2_ch3, DMA_ns::noChannel};
+
+/* USART IRQ priority, used when a TX/RX buffer is set */
+const uint8_t _USART_IRQ_preemptionPriority = 0x02;
+const uint8_t _USART_IRQ_subPriority = 0x00;
+
+/* objects of used UARTs, for IRQ dispatching */
+static serial_t* _serialObjs[NUM_UARTs] = {NULL, NULL, NULL, NULL, NULL};
+
 /* for retarget */
 static serial_t* USART_stdoutPtr = NULL;
 static serial_t* USART_stderrPtr = NULL;
 static serial_t* USART_stdinPtr = NULL;
 
+typedef struct {
+  uint8_t buf[serial_ns::stdBuf_size];
+  uint16_t len;
+  serial_ns::stdBuf_t mode;
+} USART_stdBuf_s;
+
+static USART_stdBuf_s USART_stdoutBuf = {{0}, 0, serial_ns::stdBuf_none};
+static USART_stdBuf_s USART_stderrBuf = {{0}, 0, serial_ns::stdBuf_none};
+static serial_ns::stdinMode_t USART_stdin_mode = serial_ns::stdin_blocking;
+
 ////////////////////////////////////////////////////////////
 /**
   * @brief Construction function
@@ -44,21 +79,69 @@ static serial_t* USART_stdinPtr = NULL;
   */
 serial_t::serial_t(uint8_t usedUart){
   this->usedUart = usedUart-1;
+
+  txBuf = NULL;
+  txBufSize = 0;
+  txHead = 0;
+  txTail = 0;
+  txOverflow = serial_ns::txOverflow_block;
+  txDropped = 0;
+
+  txDmaUsed = false;
+  txDmaHead = 0;
+  txDmaCount = 0;
+  txDmaActive = false;
+  txDmaDone_p = NULL;
+
+  rxBuf = NULL;
+  rxBufSize = 0;
+  rxDmaUsed = false;
+  rxWrite = 0;
+  rxRead = 0;
+  rxFrameStart = 0;
+  rxFrame_p = NULL;
+
+  if (this->usedUart < NUM_UARTs)
+    _serialObjs[this->usedUart] = this;
 }
 
 
 
 /**
-  * @brief Init one USART
+  * @brief Init one USART, 8 bit data, 1 stop bit, no parity, no flow control
   * @param baudRate USART's baud rate
   * @return None
   * @attention This function have to be called only one time and before other functions
   */
 void  serial_t::Restart(uint32_t baudRate){
+  serial_ns::lineConf_t lineConf;
+
+  lineConf.baudRate    = baudRate;
+  lineConf.wordLength  = USART_WordLength_8b;
+  lineConf.parity      = USART_Parity_No;
+  lineConf.stopBits    = USART_StopBits_1;
+  lineConf.flowControl = USART_HardwareFlowControl_None;
+
+  Restart(&lineConf);
+}
+
+
+
+/**
+  * @brief Init one USART with a full line configuration
+  * @param lineConf baud rate, word length, parity, stop bits and hardware flow control
+  * @return serial_ns::status_t, failed if RTS/CTS is asked on UART4 or UART5
+  * @attention This function have to be called only one time and before other functions
+  * - With parity, the parity bit is the MSB of the word : 8 data bits + parity needs USART_WordLength_9b.
+  */
+serial_ns::status_t  serial_t::Restart(const serial_ns::lineConf_t* lineConf){
   GPIO_InitTypeDef  GPIO_InitStruct;
   USART_InitTypeDef USART_InitStruct;
 
-  if (usedUart > 4) { return;}
+  if (usedUart > 4) { return serial_ns::failed;}
+  if ((lineConf->flowControl != USART_HardwareFlowControl_None) && (_USART_CTS_PORT[usedUart] == NULL)) {
+    return serial_ns::failed;
+  }
 
   /* enable clock */
   RCC_APB2PeriphClockCmd(_USART_TXD_CLK[usedUart], ENABLE);
@@ -76,21 +159,109 @@ void  serial_t::Restart(uint32_t baudRate){
   GPIO_InitStruct.GPIO_Mode  = GPIO_Mode_IN_FLOATING;
   GPIO_Init(_USART_RXD_PORT[usedUart], &GPIO_InitStruct);
 
+  /* RTS : output driven by USART, CTS : input (pulled up, so a missing peer doesn't hold TX) */
+  if ((lineConf->flowControl & USART_HardwareFlowControl_RTS) != 0){
+    RCC_APB2PeriphClockCmd(_USART_RTS_CLK[usedUart], ENABLE);
+    GPIO_InitStruct.GPIO_Pin   = _USART_RTS_PIN[usedUart];
+    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStruct.GPIO_Mode  = GPIO_Mode_AF_PP;
+    GPIO_Init(_USART_RTS_PORT[usedUart], &GPIO_InitStruct);
+  }
+
+  if ((lineConf->flowControl & USART_HardwareFlowControl_CTS) != 0){
+    RCC_APB2PeriphClockCmd(_USART_CTS_CLK[usedUart], ENABLE);
+    GPIO_InitStruct.GPIO_Pin   = _USART_CTS_PIN[usedUart];
+    GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStruct.GPIO_Mode  = GPIO_Mode_IPU;
+    GPIO_Init(_USART_CTS_PORT[usedUart], &GPIO_InitStruct);
+  }
+
   /*config USART */
   USART_InitStruct.USART_Mode       = USART_Mode_Rx | USART_Mode_Tx;
-  USART_InitStruct.USART_Parity     = USART_Parity_No;
-  USART_InitStruct.USART_BaudRate   = baudRate;
-  USART_InitStruct.USART_StopBits   = USART_StopBits_1;
-  USART_InitStruct.USART_WordLength = USART_WordLength_8b;
-  USART_InitStruct.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+  USART_InitStruct.USART_Parity     = lineConf->parity;
+  USART_InitStruct.USART_BaudRate   = lineConf->baudRate;
+  USART_InitStruct.USART_StopBits   = lineConf->stopBits;
+  USART_InitStruct.USART_WordLength = lineConf->wordLength;
+  USART_InitStruct.USART_HardwareFlowControl = lineConf->flowControl;
   USART_Init(_USARTs[usedUart], &USART_InitStruct);
 
   /*enable USART*/
   USART_Cmd(_USARTs[usedUart], ENABLE);
+
+  return serial_ns::successful;
 }
 
 
 
+/**
+  * @brief Clock of this USART (PCLK2 for USART1, PCLK1 for others), for baud rate errors.
+  * @return uint32_t, in Hz (0 for a wrong UART)
+  */
+uint32_t  serial_t::ClockFreq(void){
+  RCC_ClocksTypeDef clocks;
+
+  if (usedUart > 4) { return 0;}
+
+  RCC_GetClocksFreq(&clocks);
+
+  return (usedUart == 0) ? clocks.PCLK2_Frequency : clocks.PCLK1_Frequency;
+}
+
+
+
+/**
+  * @brief Send one byte to serial port, through TX ring buffer if it's set.
+  * @param outByte byte to send
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  * - With txOverflow_block, don't call it from an ISR with higher priority than the USART IRQ.
+  */
+void  serial_t::PutByte(uint8_t outByte){
+  uint16_t nextHead;
+
+  /* polling mode */
+  if (txBuf == NULL){
+    while (txDmaCount != 0)  {  }; // keep order with DMA TX
+    while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
+    USART_SendData(_USARTs[usedUart], outByte);
+    return;
+  }
+
+  /* interrupt-driven mode */
+  nextHead = txHead + 1;
+  if (nextHead == txBufSize)
+    nextHead = 0;
+
+  if (nextHead == txTail){ // full
+    switch (txOverflow){
+    case serial_ns::txOverflow_drop:
+      txDropped++;
+      return;
+
+    case serial_ns::txOverflow_overwrite:
+      /* hold TX ISR while moving its index */
+      USART_ITConfig(_USARTs[usedUart], USART_IT_TXE, DISABLE);
+      if (nextHead == txTail){
+        txTail = (txTail + 1 == txBufSize) ? 0 : txTail + 1;
+        txDropped++;
+      }
+      break;
+
+    default: // txOverflow_block
+      USART_ITConfig(_USARTs[usedUart], USART_IT_TXE, ENABLE);
+      while (nextHead == txTail) {  };
+      break;
+    }
+  }
+
+  txBuf[txHead] = outByte;
+  txHead = nextHead;
+
+  /* kick TX ISR */
+  USART_ITConfig(_USARTs[usedUart], USART_IT_TXE, ENABLE);
+}
+
+
 /**
   * @brief Send one character to serial port
   * @param outChar character to send
@@ -98,9 +269,7 @@ void  serial_t::Restart(uint32_t baudRate){
   * @attention The USARTs must be initialized first or an infinitive wait will be executed
   */
 void  serial_t::Print(uint8_t outChar){
-  /* Wait until output buffer is empty */
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], outChar);
+  PutByte(outChar);
 }
 
 
@@ -111,9 +280,7 @@ void  serial_t::Print(uint8_t outChar){
   * @attention The USARTs must be initialized first or an infinitive wait will be executed
   */
 void  serial_t::Print(char outChar){
-  /* Wait until output buffer is empty */
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) outChar);
+  PutByte((uint8_t) outChar);
 }
 
 
@@ -125,8 +292,7 @@ void  serial_t::Print(char outChar){
   */
 void  serial_t::Print(uint8_t* outStr){
   while (*outStr != '\0'){
-    while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET);
-    USART_SendData(_USARTs[usedUart], *outStr);
+    PutByte(*outStr);
     outStr++;
   }
 }
@@ -140,8 +306,7 @@ void  serial_t::Print(uint8_t* outStr){
   */
 void  serial_t::Print(char* outStr){
   while (*outStr != '\0'){
-    while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET);
-    USART_SendData(_USARTs[usedUart], (uint8_t) (*outStr));
+    PutByte((uint8_t) (*outStr));
     outStr++;
   }
 }
@@ -158,13 +323,26 @@ void  serial_t::Out(uint8_t outBuf[], uint32_t bufLen){
   uint32_t count = 0;
 
   while (count < bufLen){
-    while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET);
-    USART_SendData(_USARTs[usedUart], outBuf[count]);
+    PutByte(outBuf[count]);
     count++;
   }
 }
 
 
+/**
+  * @brief Send formatted bytes to serial port.
+  * @param outStr formatted bytes
+  * @param len number of bytes
+  * @return None
+  */
+void  serial_t::PutStr(const char* outStr, uint8_t len){
+  uint8_t count;
+
+  for (count = 0; count < len; count++)
+    PutByte((uint8_t) outStr[count]);
+}
+
+
 /**
   * @brief Send one signed integer number to serial port
   * @param usedUart choosen USART. Valid values are 1 to 5. Users must ensure used chip has correspond USART.
@@ -173,13 +351,7 @@ void  serial_t::Out(uint8_t outBuf[], uint32_t bufLen){
   * @attention The USARTs must be initialized first or an infinitive wait will be executed
   */
 void  serial_t::Print(int32_t outNum){
-  if (outNum<0){
-    Print('-');
-    Print((uint32_t) (-outNum));
-  }
-  else{
-    Print((uint32_t) outNum);
-  }
+  Print(outNum, 0, Fmt_ns::pad_space);
 }
 
 
@@ -190,49 +362,86 @@ void  serial_t::Print(int32_t outNum){
   * @attention The USARTs must be initialized first or an infinitive wait will be executed
   */
 void  serial_t::Print(uint32_t outNum){
-  uint32_t quotient, remainder;
-  int      count; //must int type, uint is incorrect
-  uint8_t  outStr[12];
-
-  remainder = outNum;
-  count     = 0;
-  do{
-    quotient    = remainder % 10;
-    remainder   = remainder / 10;
-    outStr[count++]  = 0x30 | ((uint8_t) quotient);
-  }while (remainder !=0);
-
-  while (count > 0){
-    while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET);
-    USART_SendData(_USARTs[usedUart], outStr[--count]);
-  }
+  Print(outNum, 0, Fmt_ns::pad_space);
+}
+
+
+/**
+  * @brief Send one unsigned integer number to serial port, padded to width
+  * @param outNum unsigned interger number to send
+  * @param width min number of chars, 0 for no padding
+  * @param pad padding with spaces or zeros
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  */
+void  serial_t::Print(uint32_t outNum, uint8_t width, Fmt_ns::pad_t pad){
+  char outStr[Fmt_ns::bufLen_max];
+
+  PutStr(outStr, fmt_u32(outStr, outNum, width, pad));
+}
+
+
+/**
+  * @brief Send one signed integer number to serial port, padded to width
+  * @param outNum signed interger number to send
+  * @param width min number of chars (sign included), 0 for no padding
+  * @param pad padding with spaces or zeros
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  */
+void  serial_t::Print(int32_t outNum, uint8_t width, Fmt_ns::pad_t pad){
+  char outStr[Fmt_ns::bufLen_max];
+
+  PutStr(outStr, fmt_i32(outStr, outNum, width, pad));
+}
+
+
+/**
+  * @brief Send one number in hexadecimal (upper case, no prefix) to serial port
+  * @param outNum number to send
+  * @param width min number of digits (zero padded), 0 for no padding
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  */
+void  serial_t::PrintHex(uint32_t outNum, uint8_t width){
+  char outStr[Fmt_ns::bufLen_max];
+
+  PutStr(outStr, fmt_hex(outStr, outNum, width, Fmt_ns::pad_zero));
+}
+
+
+/**
+  * @brief Send one fixed-point number (Q format) to serial port
+  * @param outNum fixed-point number, real value = outNum / 2^qBits
+  * @param qBits number of fractional bits (0 - 31)
+  * @param decimals number of digits after '.' (0 - 9), rounded
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  */
+void  serial_t::PrintFixed(int32_t outNum, uint8_t qBits, uint8_t decimals){
+  char outStr[Fmt_ns::bufLen_max];
+
+  PutStr(outStr, fmt_fixed(outStr, outNum, qBits, decimals, 0, Fmt_ns::pad_space));
 }
 
 
 
 void  serial_t::Out(uint8_t outNum){
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) outNum);
+  PutByte(outNum);
 }
 
 
 void  serial_t::Out(uint16_t outNum){
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum));
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum >> 8));
+  PutByte((uint8_t) (outNum));
+  PutByte((uint8_t) (outNum >> 8));
 }
 
 
 void  serial_t::Out(uint32_t outNum){
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum));
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum >> 8));
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum >> 16));
-  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
-  USART_SendData(_USARTs[usedUart], (uint8_t) (outNum >> 24));
+  PutByte((uint8_t) (outNum));
+  PutByte((uint8_t) (outNum >> 8));
+  PutByte((uint8_t) (outNum >> 16));
+  PutByte((uint8_t) (outNum >> 24));
 }
 
 /**
@@ -245,6 +454,14 @@ uint16_t serial_t::Get (void){
     return USART_ReceiveData (_USARTs[usedUart]);
 }
 
+/**
+  * @brief check whether a received byte is waiting in USART data register (polling RX)
+  * @return bool
+  */
+bool serial_t::RxReady (void){
+    return (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_RXNE) == SET);
+}
+
 /**
   * @brief get data from serial port (use in ISR)
   * @return uint16_t
@@ -254,6 +471,622 @@ uint16_t serial_t::Get_ISR (void){
     return USART_ReceiveData (_USARTs[usedUart]);
 }
 
+/**
+  * @brief Switch between polling TX and interrupt-driven TX.
+  * @param buf TX ring buffer, NULL to go back to polling mode.
+  * @param bufSize size of buf in byte (>= 2), bufSize-1 bytes can be pending.
+  * @param overflow what to do when buf is full (block, drop, overwrite).
+  * @return serial_ns::status_t
+  * @attention Pending bytes of the old buffer are flushed before switching.
+  * In interrupt-driven mode, IRQ_handler is called from USARTx_IRQHandler.
+  */
+serial_ns::status_t serial_t::TxBuffer_set (uint8_t* buf, uint16_t bufSize, serial_ns::txOverflow_t overflow){
+  if (usedUart > 4)
+    return serial_ns::failed;
+  if ((buf != NULL) && (bufSize < 2))
+    return serial_ns::failed;
+
+  Flush();
+
+  USART_ITConfig(_USARTs[usedUart], USART_IT_TXE, DISABLE);
+  txHead = 0;
+  txTail = 0;
+  txDropped = 0;
+  txOverflow = overflow;
+  txBufSize = (buf == NULL) ? 0 : bufSize;
+  txBuf = buf;
+
+  if (buf != NULL)
+    IRQ_enable();
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Enable NVIC channel of this USART.
+  * @return None
+  */
+void serial_t::IRQ_enable (void){
+  NVIC_InitTypeDef nvicStruct;
+
+  nvicStruct.NVIC_IRQChannel = _USART_IRQn[usedUart];
+  nvicStruct.NVIC_IRQChannelCmd = ENABLE;
+  nvicStruct.NVIC_IRQChannelPreemptionPriority = _USART_IRQ_preemptionPriority;
+  nvicStruct.NVIC_IRQChannelSubPriority = _USART_IRQ_subPriority;
+  NVIC_Init (&nvicStruct);
+}
+
+
+/**
+  * @brief Number of bytes waiting in TX ring buffer.
+  * @return uint16_t, always 0 in polling mode.
+  */
+uint16_t serial_t::TxPending (void){
+  uint16_t head = txHead;
+  uint16_t tail = txTail;
+
+  if (txBuf == NULL)
+    return 0;
+
+  return (head >= tail) ? (head - tail) : (txBufSize - tail + head);
+}
+
+
+/**
+  * @brief Number of bytes discarded by txOverflow_drop or txOverflow_overwrite since TxBuffer_set.
+  * @return uint32_t
+  */
+uint32_t serial_t::TxDropped (void){
+  return txDropped;
+}
+
+
+/**
+  * @brief Wait until all pending bytes (if any) have been shifted out of the USART,
+  * including bytes held by retarget buffers.
+  * @return None
+  * @attention The USARTs must be initialized first or an infinitive wait will be executed
+  */
+void serial_t::Flush (void){
+  if (usedUart > 4)
+    return;
+
+  if ((USART_stdoutPtr == this) || (USART_stderrPtr == this))
+    USART_stdFlush();
+
+  if (txBuf != NULL){
+    while (txTail != txHead)  {  };
+  }
+  while (txDmaCount != 0)  {  };
+
+  if ((_USARTs[usedUart]->CR1 & USART_CR1_UE) == 0) // not restarted yet
+    return;
+  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TC) == RESET)  {  };
+}
+
+
+/**
+  * @brief IRQ handler of this USART, feeds TX data register from the TX ring buffer,
+  * stores RX bytes to the RX buffer and reports DMA RX frames on IDLE line.
+  * @return None
+  */
+void serial_t::IRQ_handler (void){
+  USART_TypeDef* usart = _USARTs[usedUart];
+  uint16_t tail, pos, len;
+  uint8_t data;
+
+  if (((usart->CR1 & USART_CR1_RXNEIE) != 0) && ((usart->SR & (USART_SR_RXNE | USART_SR_ORE)) != 0)){
+    data = (uint8_t) usart->DR; // clear RXNE and ORE
+    pos = rxWrite + 1;
+    if (pos == rxBufSize)
+      pos = 0;
+    if ((rxBuf != NULL) && (pos != rxRead)){ // drop it if RX buffer is full
+      rxBuf[rxWrite] = data;
+      rxWrite = pos;
+    }
+  }
+
+  if (((usart->CR1 & USART_CR1_IDLEIE) != 0) && ((usart->SR & USART_SR_IDLE) != 0)){
+    /* clear IDLE : read SR then DR (DR is not used, DMA has taken the data) */
+    (void) USART_ReceiveData(usart);
+
+    pos = RxWritePos();
+    len = (pos >= rxFrameStart) ? (pos - rxFrameStart) : (rxBufSize - rxFrameStart + pos);
+    rxFrameStart = pos;
+    if ((len != 0) && (rxFrame_p != NULL))
+      rxFrame_p(len);
+  }
+
+  if (((usart->CR1 & USART_CR1_TXEIE) != 0) && ((usart->SR & USART_SR_TXE) != 0)){
+    tail = txTail;
+    if ((txBuf == NULL) || (tail == txHead) || txDmaActive){
+      /* nothing left or DMA owns DR, stop TXE interrupt until next PutByte or DMA done,
+       * a queued DMA waits for the ring to drain and starts from here */
+      USART_ITConfig(usart, USART_IT_TXE, DISABLE);
+      if ((txDmaCount != 0) && (tail == txHead) && (!txDmaActive))
+        DmaTx_startNext();
+    }
+    else{
+      usart->DR = txBuf[tail];
+      txTail = (tail + 1 == txBufSize) ? 0 : tail + 1;
+    }
+  }
+}
+
+
+/**
+  * @brief Enable DMA TX for this USART, OutDMA can be used after that.
+  * @param done_p called (ISR context) after each queued buffer has been sent, can be NULL (poll DmaTxPending).
+  * @return serial_ns::status_t, busy if the DMA channel is used by another driver.
+  * @attention Restart must be called before.
+  */
+serial_ns::status_t serial_t::DmaTx_enable (serial_ns::txDmaDone_t done_p){
+  DMA_InitTypeDef DMA_InitStruct;
+  DMA_Channel_TypeDef* channel;
+  DMA_ns::status_t retval;
+
+  if (usedUart > 4)
+    return serial_ns::failed;
+  if (_USART_TXDMA[usedUart] == DMA_ns::noChannel)
+    return serial_ns::failed;
+
+  Flush();
+
+  retval = DMA_channel_claim(_USART_TXDMA[usedUart], DmaTx_handler, this);
+  if (retval == DMA_ns::busy)
+    return serial_ns::busy;
+  if (retval != DMA_ns::successful)
+    return serial_ns::failed;
+
+  channel = DMA_channel_get(_USART_TXDMA[usedUart]);
+
+  DMA_DeInit(channel);
+  DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &(_USARTs[usedUart]->DR);
+  DMA_InitStruct.DMA_MemoryBaseAddr     = 0;
+  DMA_InitStruct.DMA_DIR                = DMA_DIR_PeripheralDST;
+  DMA_InitStruct.DMA_BufferSize         = 0;
+  DMA_InitStruct.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+  DMA_InitStruct.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+  DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStruct.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+  DMA_InitStruct.DMA_Mode               = DMA_Mode_Normal;
+  DMA_InitStruct.DMA_Priority           = DMA_Priority_Medium;
+  DMA_InitStruct.DMA_M2M                = DMA_M2M_Disable;
+  DMA_Init(channel, &DMA_InitStruct);
+  DMA_ITConfig(channel, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+  txDmaHead = 0;
+  txDmaCount = 0;
+  txDmaActive = false;
+  txDmaDone_p = done_p;
+  txDmaUsed = true;
+
+  USART_DMACmd(_USARTs[usedUart], USART_DMAReq_Tx, ENABLE);
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Disable DMA TX after all queued buffers have been sent, and give back the DMA channel.
+  * @return serial_ns::status_t
+  */
+serial_ns::status_t serial_t::DmaTx_disable (void){
+  if (!txDmaUsed)
+    return serial_ns::failed;
+
+  while (txDmaCount != 0)  {  };
+
+  USART_DMACmd(_USARTs[usedUart], USART_DMAReq_Tx, DISABLE);
+  txDmaUsed = false;
+  DMA_channel_release(_USART_TXDMA[usedUart], this);
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Queue one buffer for DMA TX and return at once.
+  * @param outBuf Data buffer (RAM or flash), it must stay unchanged until it has been sent.
+  * @param bufLen Number in byte of data buffer (1 - 65535)
+  * @return serial_ns::status_t, busy if the queue is full (txDmaQueue_size buffers).
+  * @attention Bytes written by Print/Out while DMA TX is active are sent before or after a whole
+  * DMA buffer, never in the middle of it. Call Flush between them if order matters.
+  */
+serial_ns::status_t serial_t::OutDMA (const uint8_t outBuf[], uint16_t bufLen){
+  uint32_t primask;
+  uint8_t index;
+
+  if (!txDmaUsed)
+    return serial_ns::failed;
+  if ((outBuf == NULL) || (bufLen == 0))
+    return serial_ns::failed;
+  if (txDmaCount >= serial_ns::txDmaQueue_size)
+    return serial_ns::busy;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  index = txDmaHead + txDmaCount;
+  if (index >= serial_ns::txDmaQueue_size)
+    index -= serial_ns::txDmaQueue_size;
+
+  txDmaQueue[index].buf = outBuf;
+  txDmaQueue[index].len = bufLen;
+  txDmaCount++;
+
+  /* start now if nothing is on the way, otherwise TX ISR or DMA handler will do it */
+  if ((!txDmaActive) && (TxPending() == 0))
+    DmaTx_startNext();
+
+  __set_PRIMASK(primask);
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Send a list of segments (e.g. header, payload table in flash, trailer) in order,
+  * without copying them into one buffer.
+  * @param segs array of segments, empty segments are skipped.
+  * @param numOfSegs number of segments in segs
+  * @return serial_ns::status_t
+  * @attention With DMA TX enabled, each segment is queued as one DMA buffer (waiting for a free
+  * slot if the queue is full) and must stay unchanged until it has been sent, i.e. until
+  * txDmaDone_p reports the last segment or DmaTxPending returns 0.
+  * Otherwise the segments are sent by Print/Out path (polling or TX ring buffer).
+  */
+serial_ns::status_t serial_t::OutSG (const serial_ns::segment_t segs[], uint8_t numOfSegs){
+  serial_ns::status_t retval;
+  uint8_t seg;
+  uint16_t count;
+
+  for (seg = 0; seg < numOfSegs; seg++){
+    if ((segs[seg].buf == NULL) || (segs[seg].len == 0))
+      continue;
+
+    if (txDmaUsed){
+      do{
+        retval = OutDMA(segs[seg].buf, segs[seg].len);
+      }while (retval == serial_ns::busy);
+
+      if (retval != serial_ns::successful)
+        return retval;
+    }
+    else{
+      for (count = 0; count < segs[seg].len; count++)
+        PutByte(segs[seg].buf[count]);
+    }
+  }
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Number of DMA TX buffers which have not been sent completely.
+  * @return uint8_t, 0 means all queued buffers have been sent.
+  */
+uint8_t serial_t::DmaTxPending (void){
+  return txDmaCount;
+}
+
+
+/**
+  * @brief Start DMA TX of the descriptor at txDmaHead.
+  * @return None
+  */
+void serial_t::DmaTx_startNext (void){
+  DMA_Channel_TypeDef* channel = DMA_channel_get(_USART_TXDMA[usedUart]);
+
+  channel->CCR &= ~DMA_CCR1_EN;
+  channel->CMAR = (uint32_t) txDmaQueue[txDmaHead].buf;
+  channel->CNDTR = txDmaQueue[txDmaHead].len;
+  txDmaActive = true;
+  channel->CCR |= DMA_CCR1_EN;
+}
+
+
+/**
+  * @brief DMA TX channel handler, chain the next descriptor and report the finished one.
+  * @param arg serial_t object
+  * @param flags DMA channel event flags
+  * @return None
+  */
+void serial_t::DmaTx_handler (void* arg, uint32_t flags){
+  serial_t* serial = (serial_t*) arg;
+  serial_ns::txDesc_t done;
+
+  if ((flags & (DMA_ns::flag_TC | DMA_ns::flag_TE)) == 0)
+    return;
+  if (serial->txDmaCount == 0)
+    return;
+
+  done = serial->txDmaQueue[serial->txDmaHead];
+  serial->txDmaHead = (serial->txDmaHead + 1 == serial_ns::txDmaQueue_size) ? 0 : serial->txDmaHead + 1;
+  serial->txDmaCount--;
+  serial->txDmaActive = false;
+
+  if (serial->txDmaCount != 0)
+    serial->DmaTx_startNext();
+  else if (serial->TxPending() != 0)
+    USART_ITConfig(_USARTs[serial->usedUart], USART_IT_TXE, ENABLE);
+
+  if (serial->txDmaDone_p != NULL)
+    serial->txDmaDone_p(done.buf, done.len);
+}
+
+
+/**
+  * @brief Enable circular DMA RX for this USART, received bytes are got by Available/Read.
+  * @param buf RX circular buffer, it should hold all bytes received between two Read calls.
+  * @param bufSize size of buf in byte (>= 2), bufSize-1 bytes can be waiting to be read.
+  * @param frame_p called (ISR context) with frame length when RX line goes idle, can be NULL.
+  * @return serial_ns::status_t, busy if the DMA channel is used by another driver.
+  * @attention Restart must be called before. Unread bytes are overwritten if buf is overrun.
+  */
+serial_ns::status_t serial_t::DmaRx_enable (uint8_t* buf, uint16_t bufSize, serial_ns::rxFrame_t frame_p){
+  DMA_InitTypeDef DMA_InitStruct;
+  DMA_Channel_TypeDef* channel;
+  DMA_ns::status_t retval;
+
+  if (usedUart > 4)
+    return serial_ns::failed;
+  if ((_USART_RXDMA[usedUart] == DMA_ns::noChannel) || (buf == NULL) || (bufSize < 2))
+    return serial_ns::failed;
+  if (rxBuf != NULL)
+    return serial_ns::busy;
+
+  retval = DMA_channel_claim(_USART_RXDMA[usedUart], NULL, this);
+  if (retval == DMA_ns::busy)
+    return serial_ns::busy;
+  if (retval != DMA_ns::successful)
+    return serial_ns::failed;
+
+  channel = DMA_channel_get(_USART_RXDMA[usedUart]);
+
+  rxBuf = buf;
+  rxBufSize = bufSize;
+  rxDmaUsed = true;
+  rxRead = 0;
+  rxFrameStart = 0;
+  rxFrame_p = frame_p;
+
+  DMA_DeInit(channel);
+  DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t) &(_USARTs[usedUart]->DR);
+  DMA_InitStruct.DMA_MemoryBaseAddr     = (uint32_t) buf;
+  DMA_InitStruct.DMA_DIR                = DMA_DIR_PeripheralSRC;
+  DMA_InitStruct.DMA_BufferSize         = bufSize;
+  DMA_InitStruct.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+  DMA_InitStruct.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+  DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStruct.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+  DMA_InitStruct.DMA_Mode               = DMA_Mode_Circular;
+  DMA_InitStruct.DMA_Priority           = DMA_Priority_High;
+  DMA_InitStruct.DMA_M2M                = DMA_M2M_Disable;
+  DMA_Init(channel, &DMA_InitStruct);
+  DMA_Cmd(channel, ENABLE);
+
+  USART_DMACmd(_USARTs[usedUart], USART_DMAReq_Rx, ENABLE);
+
+  /* IDLE line */
+  USART_ITConfig(_USARTs[usedUart], USART_IT_IDLE, ENABLE);
+  IRQ_enable();
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Disable DMA RX and give back the DMA channel, unread bytes are lost.
+  * @return serial_ns::status_t
+  */
+serial_ns::status_t serial_t::DmaRx_disable (void){
+  if ((rxBuf == NULL) || (!rxDmaUsed))
+    return serial_ns::failed;
+
+  USART_ITConfig(_USARTs[usedUart], USART_IT_IDLE, DISABLE);
+  USART_DMACmd(_USARTs[usedUart], USART_DMAReq_Rx, DISABLE);
+  DMA_channel_release(_USART_RXDMA[usedUart], this);
+
+  rxBuf = NULL;
+  rxBufSize = 0;
+  rxDmaUsed = false;
+  rxFrame_p = NULL;
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Switch between polling RX (Get) and interrupt-driven RX, received bytes are got by Available/Read.
+  * @param buf RX ring buffer, NULL to go back to polling RX.
+  * @param bufSize size of buf in byte (>= 2), bufSize-1 bytes can be waiting to be read.
+  * @return serial_ns::status_t, busy if DMA RX is enabled.
+  * @attention New bytes are dropped while buf is full. Restart must be called before.
+  */
+serial_ns::status_t serial_t::RxBuffer_set (uint8_t* buf, uint16_t bufSize){
+  if (usedUart > 4)
+    return serial_ns::failed;
+  if ((buf != NULL) && (bufSize < 2))
+    return serial_ns::failed;
+  if (rxDmaUsed)
+    return serial_ns::busy;
+
+  USART_ITConfig(_USARTs[usedUart], USART_IT_RXNE, DISABLE);
+  rxWrite = 0;
+  rxRead = 0;
+  rxBufSize = (buf == NULL) ? 0 : bufSize;
+  rxBuf = buf;
+
+  if (buf != NULL){
+    USART_ITConfig(_USARTs[usedUart], USART_IT_RXNE, ENABLE);
+    IRQ_enable();
+  }
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Position in the RX buffer where DMA or RXNE interrupt will write the next byte.
+  * @return uint16_t
+  */
+uint16_t serial_t::RxWritePos (void){
+  uint16_t remain;
+
+  if (!rxDmaUsed)
+    return rxWrite;
+
+  remain = DMA_GetCurrDataCounter(DMA_channel_get(_USART_RXDMA[usedUart]));
+
+  /* CNDTR reloads to rxBufSize, never reads 0 in circular mode except during reload */
+  return (remain == 0) ? 0 : (rxBufSize - remain);
+}
+
+
+/**
+  * @brief Number of received bytes waiting to be read.
+  * @return uint16_t, always 0 if neither DMA RX nor interrupt-driven RX is enabled.
+  */
+uint16_t serial_t::Available (void){
+  uint16_t pos, read;
+
+  if (rxBuf == NULL)
+    return 0;
+
+  pos = RxWritePos();
+  read = rxRead;
+
+  return (pos >= read) ? (pos - read) : (rxBufSize - read + pos);
+}
+
+
+/**
+  * @brief Check whether DMA RX or interrupt-driven RX is enabled.
+  * @return bool
+  */
+bool serial_t::HasRxBuffer (void){
+  return (rxBuf != NULL);
+}
+
+
+/**
+  * @brief Copy received bytes, without waiting.
+  * @param buf destination buffer
+  * @param maxLen size of buf
+  * @return uint16_t, number of bytes copied (0 if nothing has been received).
+  */
+uint16_t serial_t::Read (uint8_t* buf, uint16_t maxLen){
+  uint16_t len, first, read;
+
+  len = Available();
+  if (len > maxLen)
+    len = maxLen;
+
+  /* at most 2 pieces : to the end of circular buffer, then from its start */
+  read = rxRead;
+  first = rxBufSize - read;
+  if (first > len)
+    first = len;
+
+  memcpy(buf, &rxBuf[read], first);
+  memcpy(&buf[first], rxBuf, len - first);
+
+  read += len;
+  if (read >= rxBufSize)
+    read -= rxBufSize;
+  rxRead = read;
+
+  return len;
+}
+
+
+/**
+  * @brief Multi-drop bus : enter mute mode, wake up on address mark (WAKE = 1, ADD = address).
+  * An address character has its MSB set : bit 8 with USART_WordLength_9b (8 data bits),
+  * bit 7 with USART_WordLength_8b (7 data bits). Its 4 LSBs are compared with address.
+  * In mute mode nothing is received (no RXNE, no DMA request). When an address character
+  * matches, the USART wakes up and this character is the first byte received. An address
+  * character which doesn't match puts the USART back to mute mode by hardware.
+  * @param address node address (0 to 15)
+  * @return serial_ns::status_t
+  */
+serial_ns::status_t serial_t::Mute_enable (uint8_t address){
+  if ((usedUart > 4) || (address > 0x0F))
+    return serial_ns::failed;
+
+  USART_SetAddress(_USARTs[usedUart], address);
+  USART_WakeUpConfig(_USARTs[usedUart], USART_WakeUp_AddressMark);
+  USART_ReceiverWakeUpCmd(_USARTs[usedUart], ENABLE);
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Multi-drop bus : leave mute mode, every byte on the bus is received again.
+  * @return serial_ns::status_t
+  */
+serial_ns::status_t serial_t::Mute_disable (void){
+  if (usedUart > 4)
+    return serial_ns::failed;
+
+  USART_ReceiverWakeUpCmd(_USARTs[usedUart], DISABLE);
+  USART_WakeUpConfig(_USARTs[usedUart], USART_WakeUp_IdleLine);
+
+  return serial_ns::successful;
+}
+
+
+/**
+  * @brief Multi-drop bus : go back to mute mode at the end of a frame addressed to this node
+  * (e.g. from rxFrame_p), without waiting for the next address character.
+  * @return None
+  */
+void serial_t::Mute_enter (void){
+  USART_ReceiverWakeUpCmd(_USARTs[usedUart], ENABLE);
+}
+
+
+/**
+  * @brief Multi-drop bus : whether the USART is in mute mode (RWU).
+  * @return bool
+  */
+bool serial_t::IsMuted (void){
+  return ((_USARTs[usedUart]->CR1 & USART_CR1_RWU) != 0);
+}
+
+
+/**
+  * @brief Multi-drop bus : send an address character, after all pending TX.
+  * @param address node address (0 to 15)
+  * @return None
+  */
+void serial_t::OutAddress (uint8_t address){
+  uint16_t mark;
+
+  mark = ((_USARTs[usedUart]->CR1 & USART_CR1_M) != 0) ? 0x100 : 0x80;
+
+  Flush();
+  while (USART_GetFlagStatus(_USARTs[usedUart], USART_FLAG_TXE) == RESET)  {  };
+  USART_SendData(_USARTs[usedUart], mark | (address & 0x0F));
+}
+
+
+/**
+  * @brief Output function for stream layers (COBS encoder, ...), sends buf by Out.
+  * @param serialObj serial_t object
+  * @param buf Data buffer
+  * @param len Number in byte of data buffer
+  * @return None
+  */
+void serial_t::Out_sink (void* serialObj, const uint8_t* buf, uint16_t len){
+  ((serial_t*) serialObj)->Out((uint8_t*) buf, len);
+}
+
+
 /**
   * @brief Set USART for retarget functions
   * @param uint8_t stdStream, stdStream can be USART_stdStream_stdout,
@@ -264,6 +1097,8 @@ uint16_t serial_t::Get_ISR (void){
   * when stdxxx if off, if USART_stdxxxPtr == this then USART_stdxxxPtr = NULL, otherwise, do nothing.
   */
 void serial_t::Retarget (uint8_t stdStream){
+    USART_stdFlush();
+
     if ((stdStream & 0x01) == 0x01) //stdout bit = 1
         USART_stdoutPtr = this;
     else{ //stdout bit = 0
@@ -288,31 +1123,128 @@ void serial_t::Retarget (uint8_t stdStream){
 
 /********* Retarget ************/
 /**
-  * @brief Write one char to USART pointed by USARTptr.
-  * @param int fd file id = STDOUT_FILENO (fixed).
+  * @brief Send bytes held by a retarget buffer.
+  * @param serial_t* serialPtr : retargeted USART, NULL to discard.
+  * @param USART_stdBuf_s* stdBuf
+  * @return None
+  */
+static void USART_stdBuf_flush (serial_t* serialPtr, USART_stdBuf_s* stdBuf){
+    if ((stdBuf->len != 0) && (serialPtr != NULL))
+        serialPtr->Out (stdBuf->buf, stdBuf->len);
+
+    stdBuf->len = 0;
+}
+
+/**
+  * @brief Write chars to a retargeted USART through its retarget buffer.
+  * @param serial_t* serialPtr : retargeted USART (not NULL).
+  * @param USART_stdBuf_s* stdBuf
   * @param char* ptr : pointer to a array of char.
   * @param int len : number of char to print out.
   * @return None
   */
-int _write (int fd, char *ptr, int len) {
+static void USART_stdBuf_write (serial_t* serialPtr, USART_stdBuf_s* stdBuf, char *ptr, int len){
     int32_t i;
+    bool isNewLine = false;
+
+    if (stdBuf->mode == serial_ns::stdBuf_none){
+        serialPtr->Out ((uint8_t*) ptr, (uint32_t) len);
+        return;
+    }
+
+    for (i = 0; i < len; i++){
+        stdBuf->buf[stdBuf->len++] = (uint8_t) ptr[i];
+        if (ptr[i] == '\n')
+            isNewLine = true;
+
+        if (stdBuf->len == serial_ns::stdBuf_size)
+            USART_stdBuf_flush (serialPtr, stdBuf);
+    }
 
+    if (isNewLine && (stdBuf->mode == serial_ns::stdBuf_line))
+        USART_stdBuf_flush (serialPtr, stdBuf);
+}
+
+/**
+  * @brief Set buffering of retargeted stdout and/or stderr, pending chars are flushed first.
+  * @param uint8_t stdStream : USART_stdStream_stdout, USART_stdStream_stderr or both.
+  * @param serial_ns::stdBuf_t mode : stdBuf_none (default), stdBuf_line, stdBuf_full.
+  * @return None
+  */
+void USART_stdBuffering (uint8_t stdStream, serial_ns::stdBuf_t mode){
+    USART_stdFlush ();
+
+    if ((stdStream & USART_stdStream_stdout) != 0)
+        USART_stdoutBuf.mode = mode;
+    if ((stdStream & USART_stdStream_stderr) != 0)
+        USART_stderrBuf.mode = mode;
+}
+
+/**
+  * @brief Buffering of retargeted stdout or stderr, to restore it after a temporary change.
+  * @param uint8_t stdStream : USART_stdStream_stdout or USART_stdStream_stderr.
+  * @return serial_ns::stdBuf_t
+  */
+serial_ns::stdBuf_t USART_stdBuffering_get (uint8_t stdStream){
+    if ((stdStream & USART_stdStream_stdout) != 0)
+        return USART_stdoutBuf.mode;
+
+    return USART_stderrBuf.mode;
+}
+
+/**
+  * @brief USART of a retargeted stream, to restore it after a temporary Retarget.
+  * @param uint8_t stdStream : USART_stdStream_stdout, USART_stdStream_stdin or USART_stdStream_stderr.
+  * @return serial_t* : NULL if the stream isn't retargeted.
+  */
+serial_t* USART_stdTarget_get (uint8_t stdStream){
+    if ((stdStream & USART_stdStream_stdout) != 0)
+        return USART_stdoutPtr;
+    if ((stdStream & USART_stdStream_stdin) != 0)
+        return USART_stdinPtr;
+
+    return USART_stderrPtr;
+}
+
+/**
+  * @brief Set behaviour of _read when nothing has been received.
+  * @param serial_ns::stdinMode_t mode : stdin_blocking (default), stdin_nonBlocking.
+  * @return None
+  */
+void USART_stdinMode (serial_ns::stdinMode_t mode){
+    USART_stdin_mode = mode;
+}
+
+/**
+  * @brief Send chars held by stdout and stderr buffers.
+  * fflush(stdout) only empties newlib's buffer to _write, call this after it when
+  * stdBuf_full is used.
+  * @return None
+  */
+void USART_stdFlush (void){
+    USART_stdBuf_flush (USART_stdoutPtr, &USART_stdoutBuf);
+    USART_stdBuf_flush (USART_stderrPtr, &USART_stderrBuf);
+}
+
+/**
+  * @brief Write chars to USART pointed by USART_stdoutPtr or USART_stderrPtr.
+  * @param int fd file id = STDOUT_FILENO or STDERR_FILENO.
+  * @param char* ptr : pointer to a array of char.
+  * @param int len : number of char to print out.
+  * @return int : len, or -1 if fd is not retargeted.
+  */
+int _write (int fd, char *ptr, int len) {
     switch (fd){
     case STDOUT_FILENO:
         if (USART_stdoutPtr == NULL)
             return -1;
-        //USART_stdoutPtr != NULL
-        for (i = 0; i < len; i++){
-            USART_stdoutPtr->Print (ptr[i]);
-        }
+        USART_stdBuf_write (USART_stdoutPtr, &USART_stdoutBuf, ptr, len);
         break;
 
     case STDERR_FILENO:
         if (USART_stderrPtr == NULL)
             return -1;
-        for (i = 0; i < len; i++){
-            USART_stderrPtr->Print (ptr[i]);
-        }
+        USART_stdBuf_write (USART_stderrPtr, &USART_stderrBuf, ptr, len);
         break;
 
     default:
@@ -321,3 +1253,76 @@ int _write (int fd, char *ptr, int len) {
 
     return len;
 }
+
+/**
+  * @brief Read chars from USART pointed by USART_stdinPtr.
+  * @param int fd file id = STDIN_FILENO (fixed).
+  * @param char* ptr : pointer to a array of char.
+  * @param int len : size of ptr.
+  * @return int : number of chars read (>= 1 in blocking mode), or -1 (errno = EAGAIN
+  * in non-blocking mode when nothing has been received).
+  * With RX buffer (RxBuffer_set or DmaRx_enable), all received chars (up to len) are returned at once,
+  * otherwise 1 char is read by polling.
+  * stdout and stderr buffers are flushed first, so prompts are shown before waiting.
+  */
+int _read (int fd, char *ptr, int len) {
+    serial_t* serialPtr = USART_stdinPtr;
+    bool hasRxBuf;
+
+    if ((fd != STDIN_FILENO) || (serialPtr == NULL) || (len <= 0))
+        return -1;
+
+    USART_stdFlush ();
+
+    if (len > 0xFFFF)
+        len = 0xFFFF;
+
+    hasRxBuf = serialPtr->HasRxBuffer ();
+
+    if (hasRxBuf){
+        if (serialPtr->Available () == 0){
+            if (USART_stdin_mode == serial_ns::stdin_nonBlocking){
+                errno = EAGAIN;
+                return -1;
+            }
+            while (serialPtr->Available () == 0);
+        }
+        return serialPtr->Read ((uint8_t*) ptr, (uint16_t) len);
+    }
+
+    if ((USART_stdin_mode == serial_ns::stdin_nonBlocking) && (!serialPtr->RxReady ())){
+        errno = EAGAIN;
+        return -1;
+    }
+    ptr[0] = (char) serialPtr->Get ();
+
+    return 1;
+}
+
+/********* ISRs ************/
+/* Don't use UART1 with RIOT
+void USART1_IRQHandler (void){
+  if (_serialObjs[0] != NULL)
+    _serialObjs[0]->IRQ_handler();
+}
+*/
+
+void USART2_IRQHandler (void){
+  if (_serialObjs[1] != NULL)
+    _serialObjs[1]->IRQ_handler();
+}
+
+void USART3_IRQHandler (void){
+  if (_serialObjs[2] != NULL)
+    _serialObjs[2]->IRQ_handler();
+}
+
+void UART4_IRQHandler (void){
+  if (_serialObjs[3] != NULL)
+    _serialObjs[3]->IRQ_handler();
+}
+
+void UART5_IRQHandler (void){
+  if (_serialObjs[4] != NULL)
+    _serialObjs[4]->IRQ_handler();
+}
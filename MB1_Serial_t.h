@@ -17,35 +17,184 @@
 
 #include "MB1_Glb.h"
 #include "unistd.h"
+#include "MB1_DMA.h"
+#include "MB1_Format.h"
 
 /* stdStream */
 #define USART_stdStream_stdout 0x1
 #define USART_stdStream_stdin 0x2
 #define USART_stdStream_stderr 0x4
 
+namespace serial_ns {
+
+/* config (compile-time) */
+const uint8_t txDmaQueue_size = 4; // max number of buffers queued for DMA TX
+const uint16_t stdBuf_size = 64;   // stdout and stderr buffers of retarget
+
+typedef enum {
+  successful,
+  failed,
+  busy
+} status_t;
+
+/* line configuration for Restart */
+typedef struct {
+  uint32_t baudRate;
+  uint16_t wordLength;  // USART_WordLength_8b or USART_WordLength_9b (9b for 8 data bits + parity)
+  uint16_t parity;      // USART_Parity_No, USART_Parity_Even or USART_Parity_Odd
+  uint16_t stopBits;    // USART_StopBits_1, USART_StopBits_0_5, USART_StopBits_2 or USART_StopBits_1_5
+  uint16_t flowControl; // USART_HardwareFlowControl_None, _RTS, _CTS or _RTS_CTS (USART1 to USART3 only)
+} lineConf_t;
+
+/* what to do when the TX ring buffer is full */
+typedef enum {
+  txOverflow_block,     // wait until the TX ISR frees a slot
+  txOverflow_drop,      // discard the new byte
+  txOverflow_overwrite  // discard the oldest pending byte
+} txOverflow_t;
+
+/* DMA TX buffer descriptor */
+typedef struct {
+  const uint8_t* buf;
+  uint16_t len;
+} txDesc_t;
+
+/* one piece of a scatter-gather send, buf can be in RAM or flash */
+typedef struct {
+  const uint8_t* buf;
+  uint16_t len;
+} segment_t;
+
+/* called in ISR context when a DMA TX buffer has been sent, buf can be reused */
+typedef void (* txDmaDone_t) (const uint8_t* buf, uint16_t len);
+
+/* called in ISR context when the RX line goes idle after a frame of len bytes */
+typedef void (* rxFrame_t) (uint16_t len);
+
+/* buffering of retargeted stdout, stderr */
+typedef enum {
+  stdBuf_none,  // every _write goes to the USART at once
+  stdBuf_line,  // flush on '\n' or when buffer is full
+  stdBuf_full   // flush when buffer is full, on USART_stdFlush, or before _read
+} stdBuf_t;
+
+/* retargeted stdin */
+typedef enum {
+  stdin_blocking,   // _read waits for at least 1 byte
+  stdin_nonBlocking // _read returns -1 (errno = EAGAIN) if nothing has been received
+} stdinMode_t;
+
+}
+
 class serial_t {
 private:
   uint8_t usedUart;
+
+  /* TX ring buffer (interrupt-driven TX mode), txBuf == NULL means polling mode */
+  uint8_t* txBuf;
+  uint16_t txBufSize;
+  volatile uint16_t txHead; // written by producer
+  volatile uint16_t txTail; // written by TX ISR
+  serial_ns::txOverflow_t txOverflow;
+  volatile uint32_t txDropped;
+
+  /* DMA TX queue */
+  bool txDmaUsed;
+  serial_ns::txDesc_t txDmaQueue[serial_ns::txDmaQueue_size];
+  volatile uint8_t txDmaHead;  // active descriptor
+  volatile uint8_t txDmaCount; // active + waiting descriptors
+  volatile bool txDmaActive;   // DMA channel is running
+  serial_ns::txDmaDone_t txDmaDone_p;
+
+  /* RX buffer, filled by circular DMA or RXNE interrupt */
+  uint8_t* rxBuf;
+  uint16_t rxBufSize;
+  bool rxDmaUsed;
+  volatile uint16_t rxWrite;      // next byte to be written by RXNE interrupt
+  volatile uint16_t rxRead;       // next byte to be read by Read
+  volatile uint16_t rxFrameStart; // first byte of the current frame
+  serial_ns::rxFrame_t rxFrame_p;
+
+  void  PutByte(uint8_t outByte);
+  void  PutStr(const char* outStr, uint8_t len);
+  void  IRQ_enable(void);
+  uint16_t RxWritePos(void);
+  void  DmaTx_startNext(void);
+  static void DmaTx_handler(void* arg, uint32_t flags);
 public: serial_t(uint8_t usedUart);
 public:
   void  Restart(uint32_t baudRate);
+  serial_ns::status_t Restart(const serial_ns::lineConf_t* lineConf);
+  uint32_t ClockFreq(void);
   void  Print(uint8_t outChar);
   void  Print(char outChar);
   void  Print(uint8_t* outStr);
   void  Print(char* outStr);
   void  Print(uint32_t outNum);
   void  Print(int32_t outNum);
+  void  Print(uint32_t outNum, uint8_t width, Fmt_ns::pad_t pad);
+  void  Print(int32_t outNum, uint8_t width, Fmt_ns::pad_t pad);
+  void  PrintHex(uint32_t outNum, uint8_t width);
+  void  PrintFixed(int32_t outNum, uint8_t qBits, uint8_t decimals);
   void  Out(uint8_t outNum);
   void  Out(uint16_t outNum);
   void  Out(uint32_t outNum);
   void  Out(uint8_t outBuf[], uint32_t bufLen);
   uint16_t Get (void);
   uint16_t Get_ISR (void);
+  bool     RxReady (void);
+
+  //interrupt-driven, non-blocking TX.
+  serial_ns::status_t TxBuffer_set (uint8_t* buf, uint16_t bufSize, serial_ns::txOverflow_t overflow);
+  uint16_t TxPending (void);
+  uint32_t TxDropped (void);
+  void     Flush (void);
+
+  //DMA TX, queued buffers are sent back to back without CPU.
+  serial_ns::status_t DmaTx_enable (serial_ns::txDmaDone_t done_p);
+  serial_ns::status_t DmaTx_disable (void);
+  serial_ns::status_t OutDMA (const uint8_t outBuf[], uint16_t bufLen);
+  uint8_t  DmaTxPending (void);
+
+  //scatter-gather send, segments are sent in order without being copied.
+  serial_ns::status_t OutSG (const serial_ns::segment_t segs[], uint8_t numOfSegs);
+
+  //circular DMA RX, IDLE line marks the end of a frame.
+  serial_ns::status_t DmaRx_enable (uint8_t* buf, uint16_t bufSize, serial_ns::rxFrame_t frame_p);
+  serial_ns::status_t DmaRx_disable (void);
+
+  //interrupt-driven RX (RXNE), for UARTs without DMA or low rates.
+  serial_ns::status_t RxBuffer_set (uint8_t* buf, uint16_t bufSize);
+
+  //received bytes of DMA RX or interrupt-driven RX.
+  bool     HasRxBuffer (void);
+  uint16_t Available (void);
+  uint16_t Read (uint8_t* buf, uint16_t maxLen);
+
+  //multi-drop bus (RS-485) : mute mode, wake up on address mark.
+  serial_ns::status_t Mute_enable (uint8_t address);
+  serial_ns::status_t Mute_disable (void);
+  void     Mute_enter (void);
+  bool     IsMuted (void);
+  void     OutAddress (uint8_t address);
+
+  //must be called from USARTx_IRQHandler.
+  void IRQ_handler (void);
+
+  //sink for stream layers (e.g. CobsEncoder), serialObj is a serial_t*.
+  static void Out_sink (void* serialObj, const uint8_t* buf, uint16_t len);
 
   //enable retarget for printf.
   void Retarget (uint8_t stdStream);
 };
 
+//buffering of retarget functions.
+void USART_stdBuffering (uint8_t stdStream, serial_ns::stdBuf_t mode);
+serial_ns::stdBuf_t USART_stdBuffering_get (uint8_t stdStream);
+serial_t* USART_stdTarget_get (uint8_t stdStream);
+void USART_stdinMode (serial_ns::stdinMode_t mode);
+void USART_stdFlush (void);
+
 //retarget functions to overload functions in stdio.h.
 #ifdef __cplusplus
 extern "C"{
@@ -55,6 +204,13 @@ int _write (int fd, char *ptr, int len);
 int _read (int fd, char *ptr, int len);
 void _ttywrch(int ch);
 
+/* ISRs, USART1 is left to RIOT */
+//void USART1_IRQHandler (void);
+void USART2_IRQHandler (void);
+void USART3_IRQHandler (void);
+void UART4_IRQHandler (void);
+void UART5_IRQHandler (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,7 +19,7 @@
  * baud_rate (9600), retarget (config_interface)
  *
  * (MB1_USART2)
- * baud_rate (9600), retarget (config_interface)
+ * baud_rate (9600), retarget (config_interface), stdout line-buffered when retargeted
  *
  * (Misc functions)
  * ledBeat_period, miscTIM_period (TIM6, 1msec).
@@ -29,8 +29,12 @@
  * | LedBeat_ISR    |           | subISR_ptr    |
  * | delay_ms_ISR   |           | subISR_ptr    |
  * | btn_ISR        |           | subISR_ptr    |
- * | ............   |           | ............  |
- * g_numOfSubISR_max (default = 4)
+ * | ticks_ms_ISR   |           | subISR_ptr    |
+ * | subISR_ptr     |           | subISR_ptr    |
+ * | subISR_ptr     |           | subISR_ptr    |
+ * g_numOfSubISR_max (default = 6)
+ * at25_ISR and cc2530_ISR are off by default (MB1_conf_at25Poll_isUsed, MB1_conf_cc2530Tick_isUsed) :
+ * with both on, TIM6 has no free slot left for the application.
  *
  * (NVIC)
  * 2 bit for preemption priority
@@ -104,12 +108,18 @@ const bool MB1_USART2_isUsed = true;
 const uint32_t MB1_conf_USART2_buadrate = 9600;
 const bool MB1_conf_USART2_retarget_isUsed = false;
 const uint8_t MB1_conf_USART2_retarget = USART_stdStream_stdout;
+const serial_ns::stdBuf_t MB1_conf_USART2_stdBuffering = serial_ns::stdBuf_line;
+const bool MB1_conf_USART2_baudNegotiation_isUsed = false; // host may step the rate up at start (MB1_Baud.h)
+const uint32_t MB1_conf_USART2_baudListen_ms = 500;
 /**< for USART1 */
 
 /**< for ISRs */
 const bool MB1_conf_LedBeat_isUsed = true;
 const bool MB1_conf_delayms_isUsed = true;
 const bool MB1_conf_btnProcessing_isUsed = true;
+const bool MB1_conf_ticksms_isUsed = true;
+const bool MB1_conf_at25Poll_isUsed = false; // BUSY polling of AT25 flashes (MB1_AT25.h)
+const bool MB1_conf_cc2530Tick_isUsed = false; // ready timeout and idle poll of CC2530s (MB1_CC2530.h)
 /**< for ISRs */
 
 /**< others */
@@ -148,8 +158,10 @@ void MB1_system_init (void){
     /**< USART2 */
     if (MB1_USART2_isUsed){
         MB1_USART2.Restart (MB1_conf_USART2_buadrate);
-        if (MB1_conf_USART2_retarget_isUsed)
+        if (MB1_conf_USART2_retarget_isUsed){
             MB1_USART2.Retarget (USART_stdStream_stdout);
+            USART_stdBuffering (USART_stdStream_stdout, MB1_conf_USART2_stdBuffering);
+        }
     }
 
     /**< end USART2 */
@@ -161,8 +173,21 @@ void MB1_system_init (void){
         MB1_ISRs.subISR_assign (MB1_conf_miscTIM_ISRType, delay_ms_miscTIMISR);
     if (MB1_conf_btnProcessing_isUsed)
         MB1_ISRs.subISR_assign (MB1_conf_miscTIM_ISRType, btnProcessing_miscTIMISR);
+    if (MB1_conf_ticksms_isUsed)
+        MB1_ISRs.subISR_assign (MB1_conf_miscTIM_ISRType, ticks_ms_miscTIMISR);
+    if (MB1_conf_at25Poll_isUsed)
+        MB1_ISRs.subISR_assign (MB1_conf_miscTIM_ISRType, at25_miscTIMISR);
+    if (MB1_conf_cc2530Tick_isUsed)
+        MB1_ISRs.subISR_assign (MB1_conf_miscTIM_ISRType, cc2530_miscTIMISR);
     /**< end ISRs */
 
+    /**< USART2 baud-rate negotiation, needs ticks_ms */
+    if (MB1_USART2_isUsed && MB1_conf_USART2_baudNegotiation_isUsed && MB1_conf_ticksms_isUsed){
+        uint32_t baud;
+        baud_negotiate (&MB1_USART2, MB1_conf_USART2_buadrate, MB1_conf_USART2_baudListen_ms, &baud);
+    }
+    /**< end USART2 baud-rate negotiation */
+
     /**< NVIC priority group config */
     NVIC_PriorityGroupConfig (MB1_NVIC_PriorityGroup);
 
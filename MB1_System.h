@@ -16,6 +16,19 @@
 #include "MB1_Misc.h"
 #include "MB1_ISR.h"
 #include "MB1_SPI.h"
+#include "MB1_DMA.h"
+#include "MB1_Format.h"
+#include "MB1_Cobs.h"
+#include "MB1_Log.h"
+#include "MB1_Mux.h"
+#include "MB1_Lz.h"
+#include "MB1_Bench.h"
+#include "MB1_RpcServer.h"
+#include "MB1_BaudTarget.h"
+#include "MB1_AT25.h"
+#include "MB1_CC2530.h"
+#include "MB1_KvTarget.h"
+#include "MB1_Cache.h"
 #include "MB1_Buttons.h"
 #include "hl_crc.h"
 
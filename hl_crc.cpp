@@ -124,3 +124,39 @@ bool CRC_c::Check(uint32_t dataBuffer[], uint16_t bufferSize, uint32_t receivedC
   return (receivedCRC == Calculate(dataBuffer, bufferSize));
 }
 
+
+
+/**
+ @brief Calculate CRC continuously for one more 32-bit word, for streaming users
+ @param crc Running CRC value, 0xFFFFFFFF at the start of a stream
+ @param word Data to calculate CRC
+ @return New running CRC value
+ @attention The peripheral is reset when crc is 0xFFFFFFFF and continues from CRC->DR when it
+ holds crc. When another user has changed CRC->DR in the middle of a stream (streams of Kv, RPC,
+ COBS framing interleaved), the word is computed by cobs_crcWord_sw, the result is the same.
+ The AHB clock of CRC is turned on here when it's off (first call, or after CRC_c::Shutdown),
+ callers don't need CRC_c::Start.
+ The function is not reentrant : IRQs are masked while CRC->DR is checked and written, CRC_c
+ methods must not be called from ISRs while CRC_hwWord is used.
+*/
+uint32_t CRC_hwWord(uint32_t crc, uint32_t word) {
+  static CRC_c crcUnit;
+  uint32_t primask, retval;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  if ((RCC->AHBENR & RCC_AHBPeriph_CRC) == 0)
+    crcUnit.Start();
+
+  if (crc == 0xFFFFFFFF)
+    retval = crcUnit.Calculate(word);
+  else if (CRC->DR == crc)
+    retval = crcUnit.CalculateCont(word);
+  else
+    retval = cobs_crcWord_sw(crc, word);
+
+  __set_PRIMASK(primask);
+
+  return retval;
+}
@@ -22,6 +22,7 @@
 #define __HL_CRC_H
 
 #include "MB1_Glb.h"
+#include "MB1_Cobs.h"
 
 /**
  @class CRC_c
@@ -44,4 +45,8 @@ public:
     bool 		Check(uint32_t dataBuffer[], uint16_t bufferSize, uint32_t receivedCRC);
 }; //end class
 
+/* Streaming CRC for framing layers (see MB1_Cobs.h), crc is the running value, not reentrant.
+   It turns the CRC clock on itself (RCC_AHBPeriph_CRC), callers don't need CRC_c::Start */
+uint32_t CRC_hwWord(uint32_t crc, uint32_t word);
+
 #endif //__HL_CRC_H
@@ -0,0 +1,1512 @@
+/**
+ * @file MB1_Host.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief This is source file for a host model of MBoard-1.
+ */
+
+/* Includes */
+#include "MB1_Host.h"
+#include "MB1_Misc.h"
+#include "stdio.h"
+#include "string.h"
+#include "signal.h"
+#include "unistd.h"
+#include "ucontext.h"
+#include "sys/mman.h"
+#include "sys/time.h"
+using namespace Host_ns;
+
+/**< vectors, weak : drivers which aren't linked have no handler */
+extern "C" {
+void DMA1_Channel1_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel2_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel3_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel4_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel5_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel6_IRQHandler (void) __attribute__ ((weak));
+void DMA1_Channel7_IRQHandler (void) __attribute__ ((weak));
+void EXTI0_IRQHandler (void) __attribute__ ((weak));
+void EXTI1_IRQHandler (void) __attribute__ ((weak));
+void EXTI2_IRQHandler (void) __attribute__ ((weak));
+void EXTI3_IRQHandler (void) __attribute__ ((weak));
+void EXTI4_IRQHandler (void) __attribute__ ((weak));
+void EXTI9_5_IRQHandler (void) __attribute__ ((weak));
+void EXTI15_10_IRQHandler (void) __attribute__ ((weak));
+void USART1_IRQHandler (void) __attribute__ ((weak));
+void USART2_IRQHandler (void) __attribute__ ((weak));
+void USART3_IRQHandler (void) __attribute__ ((weak));
+}
+
+/**< peripherals */
+GPIO_TypeDef host_GPIOA, host_GPIOB, host_GPIOC, host_GPIOD;
+USART_TypeDef host_USART1, host_USART2, host_USART3, host_UART4, host_UART5;
+SPI_TypeDef host_SPI1, host_SPI2;
+TIM_TypeDef host_TIM6, host_TIM7;
+CRC_TypeDef host_CRC;
+RCC_TypeDef host_RCC;
+DMA_TypeDef host_DMA1, host_DMA2;
+DMA_Channel_TypeDef host_DMA1_Channels [7], host_DMA2_Channels [5];
+EXTI_TypeDef host_EXTI;
+CoreDebug_Type host_CoreDebug;
+
+uint32_t SystemCoreClock = cpu_hz;
+
+/**< core */
+volatile uint32_t host_primask = 0;
+volatile uint32_t host_irqPending = 0;
+static volatile sig_atomic_t host_inIsr = 0;
+static bool host_nvicEnabled [host_numOfIRQns];
+
+/**< time */
+static volatile uint64_t host_ns = 0;
+static volatile bool host_isKick = false;  // next tick runs ISRs at the same time (register write)
+static uint64_t host_limit_ns = 0;
+static uint64_t host_devices_ns = 0;   // time given to devices
+
+/**< misc timer */
+uint16_t miscTIM_period = 0;
+static void (* host_miscTIM_isr_p) (void) = NULL;
+static uint64_t host_miscTIM_due_ns = 0;
+
+/**< GPIO */
+const uint8_t host_numOfPorts = 4;
+static GPIO_TypeDef * const host_ports [host_numOfPorts] = {GPIOA, GPIOB, GPIOC, GPIOD};
+static uint8_t host_extiPorts [16];     // GPIO_EXTILineConfig, port source of each line
+
+/**< SPI masters */
+const uint8_t host_numOfSPIs = 2;
+const uint8_t host_spiDecodes_max = 0x01 << ssLines_max;
+const uint8_t host_decode_none = 0xFF;
+
+typedef struct {
+    SPI_TypeDef *SPIx;
+    uint32_t pclk_hz;
+    DMA_Channel_TypeDef *rxChannel;
+    DMA_Channel_TypeDef *txChannel;
+    uint8_t rxChannelNum;               // DMA1 channel number - 1
+    uint8_t txChannelNum;
+    GPIO_TypeDef *misoPort;
+    uint16_t misoPin;
+
+    GPIO_TypeDef *ssPorts [ssLines_max];
+    uint16_t ssPins [ssLines_max];
+    uint8_t numOfSSLines;
+    const spiDevice_s *devices [host_spiDecodes_max];
+    uint8_t selected;                   // decode value on SS lines, host_decode_none before wiring
+    bool misoLevel;
+
+    bool isRunning;
+    uint64_t due_ns;
+} host_spi_s;
+
+static host_spi_s host_spis [host_numOfSPIs] = {
+    {SPI1, 72000000, DMA1_Channel2, DMA1_Channel3, 1, 2, GPIOA, GPIO_Pin_6,
+     {NULL}, {0}, 0, {NULL}, host_decode_none, true, false, 0},
+    {SPI2, 36000000, DMA1_Channel4, DMA1_Channel5, 3, 4, GPIOB, GPIO_Pin_14,
+     {NULL}, {0}, 0, {NULL}, host_decode_none, true, false, 0}
+};
+
+/**< DMA : memory address and count latched when a channel is enabled (internal registers) */
+const uint8_t host_numOfDMAChannels = 7 + 5;
+
+typedef struct {
+    uint32_t mem;
+    uint16_t count;
+} host_dmaStart_s;
+
+static host_dmaStart_s host_dmaStarts [host_numOfDMAChannels];
+
+/**< USARTs on DMA1, UART4 and UART5 aren't modeled */
+const uint8_t host_numOfUSARTs = 3;
+
+typedef struct {
+    USART_TypeDef *USARTx;
+    uint32_t pclk_hz;
+    DMA_Channel_TypeDef *rxChannel;
+    DMA_Channel_TypeDef *txChannel;
+    uint8_t rxChannelNum;               // DMA1 channel number - 1
+    uint8_t txChannelNum;
+    uint8_t IRQn;
+
+    bool isLoopback;
+    void (* sink_p) (void *ctx, uint16_t data);
+    void *sinkCtx;
+    bool (* source_p) (void *ctx, uint16_t *data_p);
+    void *sourceCtx;
+    uint64_t sourceDue_ns;              // source is polled once per frame time
+
+    uint16_t tdr;                       // TX side of DR, full while TXE is reset
+    uint16_t shift;                     // TX shift register
+    uint16_t shiftBRR;                  // BRR when the frame started
+    bool isShifting;
+    uint64_t shiftDue_ns;
+    bool isIdleArmed;                   // IDLE is set one frame after the last received frame
+    uint64_t idleDue_ns;
+} host_usart_s;
+
+static host_usart_s host_usarts [host_numOfUSARTs] = {
+    {USART1, 72000000, DMA1_Channel5, DMA1_Channel4, 4, 3, USART1_IRQn, false, NULL, NULL, NULL, NULL, 0, 0, 0, 0, false, 0, false, 0},
+    {USART2, 36000000, DMA1_Channel6, DMA1_Channel7, 5, 6, USART2_IRQn, false, NULL, NULL, NULL, NULL, 0, 0, 0, 0, false, 0, false, 0},
+    {USART3, 36000000, DMA1_Channel3, DMA1_Channel2, 2, 1, USART3_IRQn, false, NULL, NULL, NULL, NULL, 0, 0, 0, 0, false, 0, false, 0}
+};
+
+/**< test */
+static int (* host_test_p) (void) = NULL;
+static int host_retval = 0;
+
+/* Private functions */
+static void host_init (void);
+static void host_signal (int signum);
+static void host_tick (void);
+static void host_time_advance (void);
+static void host_test_run (void);
+static void host_irq_call (uint8_t IRQn);
+static void host_exti_dispatch (void);
+static void host_exti_edge (GPIO_TypeDef *port, uint16_t pin, bool isRising);
+static void host_gpio_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static void host_w1c_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static void host_ifcr_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static host_spi_s * host_spi_get (SPI_TypeDef *SPIx);
+static void host_spi_cs_update (host_spi_s *spi_p);
+static void host_spi_miso_update (host_spi_s *spi_p);
+static uint16_t host_spi_exchange (host_spi_s *spi_p, uint16_t frame);
+static void host_spi_kick (host_spi_s *spi_p);
+static void host_spi_complete (host_spi_s *spi_p);
+static uint32_t host_crcDR_read (HostReg<uint32_t> *reg_p);
+static void host_crcDR_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static void host_crcCR_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static void host_dmaCCR_write (HostReg<uint32_t> *reg_p, uint32_t word);
+static void host_dma_irq (uint8_t channelNum);
+static host_usart_s * host_usart_get (USART_TypeDef *USARTx);
+static uint16_t host_usartDR_read (HostReg<uint16_t> *reg_p);
+static void host_usartDR_write (HostReg<uint16_t> *reg_p, uint16_t word);
+static uint32_t host_usart_frame_ns (host_usart_s *usart_p);
+static void host_usart_tx (host_usart_s *usart_p, uint16_t data);
+static void host_usart_rx (host_usart_s *usart_p, uint16_t data);
+static void host_usart_dmaTx (host_usart_s *usart_p);
+static void host_usart_update (host_usart_s *usart_p);
+static void host_usart_irq (host_usart_s *usart_p);
+
+/**<----------------------------- run ------------------------------------------*/
+
+/**
+ * @brief host_run, run a test with interrupts of the model.
+ * @param int (* test_p) (void) : runs on a stack below 4GB, its return value is returned.
+ * @param uint32_t timeLimit_ms : simulated time, the process exits (2) when it's over.
+ * @return int : return value of test_p, 2 if the model can't run.
+ */
+int host_run (int (* test_p) (void), uint32_t timeLimit_ms){
+    static ucontext_t mainContext, testContext;
+    struct sigaction action;
+    struct itimerval timer;
+    void *stack;
+
+    if ((uint64_t) (uintptr_t) &host_SPI1 > 0xFFFFFFFF){
+        fprintf (stderr, "host_run : peripherals above 4GB, build with -no-pie\n");
+        return 2;
+    }
+
+    stack = mmap (NULL, stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (stack == MAP_FAILED){
+        fprintf (stderr, "host_run : no stack below 4GB\n");
+        return 2;
+    }
+
+    host_init ();
+    host_limit_ns = (uint64_t) timeLimit_ms * 1000000;
+    host_test_p = test_p;
+
+    getcontext (&testContext);
+    testContext.uc_stack.ss_sp = stack;
+    testContext.uc_stack.ss_size = stack_size;
+    testContext.uc_link = &mainContext;
+    makecontext (&testContext, host_test_run, 0);
+
+    memset (&action, 0, sizeof (action));
+    action.sa_handler = host_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset (&action.sa_mask);
+    sigaction (SIGALRM, &action, NULL);
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = tickPeriod_us;
+    timer.it_value = timer.it_interval;
+    setitimer (ITIMER_REAL, &timer, NULL);
+
+    swapcontext (&mainContext, &testContext);
+
+    memset (&timer, 0, sizeof (timer));
+    setitimer (ITIMER_REAL, &timer, NULL);
+    munmap (stack, stack_size);
+
+    return host_retval;
+}
+
+/**
+ * @brief host_test_run, entry of the test context.
+ * @return None
+ */
+static void host_test_run (void){
+    host_retval = host_test_p ();
+}
+
+/**
+ * @brief host_init, reset values and hooks of registers.
+ * @return None
+ */
+static void host_init (void){
+    uint8_t count;
+
+    for (count = 0; count < host_numOfPorts; count++){
+        host_ports[count]->BSRR.write_p = host_gpio_write;
+        host_ports[count]->BRR.write_p = host_gpio_write;
+    }
+    EXTI->PR.write_p = host_w1c_write;
+    DMA1->IFCR.write_p = host_ifcr_write;
+    DMA2->IFCR.write_p = host_ifcr_write;
+
+    CRC->DR.value = 0xFFFFFFFF;
+    CRC->DR.read_p = host_crcDR_read;
+    CRC->DR.write_p = host_crcDR_write;
+    CRC->CR.write_p = host_crcCR_write;
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        host_spis[count].SPIx->SR.value = SPI_I2S_FLAG_TXE;
+        host_spis[count].misoPort->IDR.value |= host_spis[count].misoPin;
+    }
+
+    for (count = 0; count < 7; count++)
+        host_DMA1_Channels[count].CCR.write_p = host_dmaCCR_write;
+    for (count = 0; count < 5; count++)
+        host_DMA2_Channels[count].CCR.write_p = host_dmaCCR_write;
+
+    for (count = 0; count < host_numOfUSARTs; count++){
+        host_usarts[count].USARTx->SR.value = USART_SR_TXE | USART_SR_TC;
+        host_usarts[count].USARTx->DR.read_p = host_usartDR_read;
+        host_usarts[count].USARTx->DR.write_p = host_usartDR_write;
+    }
+}
+
+/**<----------------------------- interrupts -----------------------------------*/
+
+/**
+ * @brief host_signal, SIGALRM, a tick runs now or when PRIMASK is cleared.
+ * @return None
+ */
+static void host_signal (int signum){
+    (void) signum;
+
+    if ((host_primask != 0) || (host_inIsr != 0)){
+        host_irqPending = 1;
+        return;
+    }
+
+    host_irq_run ();
+}
+
+/**
+ * @brief host_irq_run, run ticks which are pending (ISR context), nothing if already in ISR context.
+ * @return None
+ */
+void host_irq_run (void){
+    if (host_inIsr != 0)
+        return;
+
+    host_inIsr = 1;
+    do {
+        host_irqPending = 0;
+        host_tick ();
+    } while (host_irqPending != 0);
+    host_inIsr = 0;
+}
+
+/**
+ * @brief host_wfi, wait for the next tick.
+ * @return None
+ */
+void host_wfi (void){
+    pause ();
+}
+
+/**
+ * @brief host_tick, one step of the model.
+ * @return None
+ */
+static void host_tick (void){
+    uint8_t count;
+
+    host_exti_dispatch ();
+    if (host_isKick)
+        host_isKick = false;
+    else
+        host_time_advance ();
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        if (host_spis[count].isRunning && (host_spis[count].due_ns <= host_ns))
+            host_spi_complete (&host_spis[count]);
+    }
+
+    for (count = 0; count < host_numOfUSARTs; count++){
+        host_usart_update (&host_usarts[count]);
+        host_dma_irq (host_usarts[count].txChannelNum);
+        host_dma_irq (host_usarts[count].rxChannelNum);
+        host_usart_irq (&host_usarts[count]);
+    }
+
+    while ((host_miscTIM_isr_p != NULL) && (host_miscTIM_due_ns <= host_ns)){
+        host_miscTIM_due_ns += (uint64_t) miscTIM_period * 1000000;
+        host_miscTIM_isr_p ();
+    }
+
+    host_exti_dispatch ();
+
+    if (host_ns > host_limit_ns){
+        static const char message [] = "host : time limit, deadlock ?\n";
+
+        write (2, message, sizeof (message) - 1);
+        _exit (2);
+    }
+}
+
+/**
+ * @brief host_time_advance, step_us or up to the next event, devices run for this time.
+ * @return None
+ */
+static void host_time_advance (void){
+    uint64_t next_ns = host_ns + (uint64_t) step_us * 1000;
+    uint32_t elapsed_us;
+    uint8_t count, decode;
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        if (host_spis[count].isRunning && (host_spis[count].due_ns < next_ns))
+            next_ns = host_spis[count].due_ns;
+    }
+    for (count = 0; count < host_numOfUSARTs; count++){
+        if (host_usarts[count].isShifting && (host_usarts[count].shiftDue_ns < next_ns))
+            next_ns = host_usarts[count].shiftDue_ns;
+        if (host_usarts[count].isIdleArmed && (host_usarts[count].idleDue_ns < next_ns))
+            next_ns = host_usarts[count].idleDue_ns;
+        if ((host_usarts[count].source_p != NULL) && (host_usarts[count].sourceDue_ns < next_ns))
+            next_ns = host_usarts[count].sourceDue_ns;
+    }
+    if ((host_miscTIM_isr_p != NULL) && (host_miscTIM_due_ns < next_ns))
+        next_ns = host_miscTIM_due_ns;
+    if (next_ns < host_ns)
+        next_ns = host_ns;
+    host_ns = next_ns;
+
+    /* devices count whole microseconds */
+    elapsed_us = (uint32_t) ((host_ns - host_devices_ns) / 1000);
+    if (elapsed_us == 0)
+        return;
+    host_devices_ns += (uint64_t) elapsed_us * 1000;
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        for (decode = 0; decode < host_spiDecodes_max; decode++){
+            const spiDevice_s *device_p = host_spis[count].devices[decode];
+
+            if ((device_p != NULL) && (device_p->tick_us != NULL))
+                device_p->tick_us (device_p->ctx, elapsed_us);
+        }
+        host_spi_miso_update (&host_spis[count]);
+    }
+}
+
+/**
+ * @brief host_irq_call, call the handler of an IRQ if it's enabled in NVIC.
+ * @return None
+ */
+static void host_irq_call (uint8_t IRQn){
+    void (* handler_p) (void) = NULL;
+
+    if ((IRQn >= host_numOfIRQns) || !host_nvicEnabled[IRQn])
+        return;
+
+    switch (IRQn){
+    case DMA1_Channel1_IRQn: handler_p = DMA1_Channel1_IRQHandler; break;
+    case DMA1_Channel2_IRQn: handler_p = DMA1_Channel2_IRQHandler; break;
+    case DMA1_Channel3_IRQn: handler_p = DMA1_Channel3_IRQHandler; break;
+    case DMA1_Channel4_IRQn: handler_p = DMA1_Channel4_IRQHandler; break;
+    case DMA1_Channel5_IRQn: handler_p = DMA1_Channel5_IRQHandler; break;
+    case DMA1_Channel6_IRQn: handler_p = DMA1_Channel6_IRQHandler; break;
+    case DMA1_Channel7_IRQn: handler_p = DMA1_Channel7_IRQHandler; break;
+    case EXTI0_IRQn: handler_p = EXTI0_IRQHandler; break;
+    case EXTI1_IRQn: handler_p = EXTI1_IRQHandler; break;
+    case EXTI2_IRQn: handler_p = EXTI2_IRQHandler; break;
+    case EXTI3_IRQn: handler_p = EXTI3_IRQHandler; break;
+    case EXTI4_IRQn: handler_p = EXTI4_IRQHandler; break;
+    case EXTI9_5_IRQn: handler_p = EXTI9_5_IRQHandler; break;
+    case EXTI15_10_IRQn: handler_p = EXTI15_10_IRQHandler; break;
+    case USART1_IRQn: handler_p = USART1_IRQHandler; break;
+    case USART2_IRQn: handler_p = USART2_IRQHandler; break;
+    case USART3_IRQn: handler_p = USART3_IRQHandler; break;
+    default: break;
+    }
+
+    if (handler_p != NULL)
+        handler_p ();
+}
+
+/**
+ * @brief host_exti_dispatch, call EXTI handlers of pending unmasked lines, once per handler.
+ * @return None
+ */
+static void host_exti_dispatch (void){
+    uint32_t lines = EXTI->PR.value & EXTI->IMR.value;
+
+    if (lines == 0)
+        return;
+
+    if (lines & 0x0001) host_irq_call (EXTI0_IRQn);
+    if (lines & 0x0002) host_irq_call (EXTI1_IRQn);
+    if (lines & 0x0004) host_irq_call (EXTI2_IRQn);
+    if (lines & 0x0008) host_irq_call (EXTI3_IRQn);
+    if (lines & 0x0010) host_irq_call (EXTI4_IRQn);
+    if (lines & 0x03E0) host_irq_call (EXTI9_5_IRQn);
+    if (lines & 0xFC00) host_irq_call (EXTI15_10_IRQn);
+}
+
+/**
+ * @brief host_exti_edge, edge of an input pin, sets the pending bit of its EXTI line.
+ * @return None
+ */
+static void host_exti_edge (GPIO_TypeDef *port, uint16_t pin, bool isRising){
+    uint8_t line = 0;
+
+    while ((pin >> line) != 0x01)
+        line++;
+
+    if (host_ports[host_extiPorts[line]] != port)
+        return;
+
+    if ((isRising ? EXTI->RTSR.value : EXTI->FTSR.value) & pin){
+        EXTI->PR.value |= pin;
+        host_irqPending = 1;
+    }
+}
+
+/**<----------------------------- register hooks -------------------------------*/
+
+/**
+ * @brief host_gpio_write, BSRR/BRR store, SS lines of SPIs follow ODR.
+ * @return None
+ */
+static void host_gpio_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    GPIO_TypeDef *port = NULL;
+    uint32_t primask;
+    uint8_t count;
+
+    for (count = 0; count < host_numOfPorts; count++){
+        if ((reg_p == &host_ports[count]->BSRR) || (reg_p == &host_ports[count]->BRR))
+            port = host_ports[count];
+    }
+    if (port == NULL)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (reg_p == &port->BSRR)
+        port->ODR.value = (port->ODR.value & ~(word >> 16) & 0xFFFF) | (word & 0xFFFF);
+    else
+        port->ODR.value &= ~(word & 0xFFFF);
+
+    for (count = 0; count < host_numOfSPIs; count++)
+        host_spi_cs_update (&host_spis[count]);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief host_w1c_write, write 1 to clear (EXTI PR).
+ * @return None
+ */
+static void host_w1c_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    reg_p->value &= ~word;
+}
+
+/**
+ * @brief host_ifcr_write, DMA IFCR clears flags of ISR.
+ * @return None
+ */
+static void host_ifcr_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    DMA_TypeDef *dma = (reg_p == &DMA1->IFCR) ? DMA1 : DMA2;
+
+    dma->ISR.value &= ~word;
+}
+
+/**
+ * @brief host_crcDR_read, CRC unit reads 0 while its clock is off.
+ * @return uint32_t
+ */
+static uint32_t host_crcDR_read (HostReg<uint32_t> *reg_p){
+    return ((RCC->AHBENR.value & RCC_AHBPeriph_CRC) != 0) ? reg_p->value : 0;
+}
+
+/**
+ * @brief host_crcDR_write, one more word of CRC-32 (polynomial 0x04C11DB7, MSB first), ignored
+ * while the clock of CRC is off.
+ * @return None
+ */
+static void host_crcDR_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    uint32_t crc = reg_p->value ^ word;
+    uint8_t bit;
+
+    if ((RCC->AHBENR.value & RCC_AHBPeriph_CRC) == 0)
+        return;
+
+    for (bit = 0; bit < 32; bit++)
+        crc = ((crc & 0x80000000) != 0) ? (crc << 1) ^ 0x04C11DB7 : crc << 1;
+    reg_p->value = crc;
+}
+
+/**
+ * @brief host_crcCR_write, RESET loads 0xFFFFFFFF in DR.
+ * @return None
+ */
+static void host_crcCR_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    (void) reg_p;
+
+    if (((RCC->AHBENR.value & RCC_AHBPeriph_CRC) != 0) && ((word & CRC_CR_RESET) != 0))
+        CRC->DR.value = 0xFFFFFFFF;
+}
+
+/**
+ * @brief host_dmaCCR_write, a channel latches its memory address and count when it's enabled,
+ * a USART TX channel starts at once.
+ * @return None
+ */
+static void host_dmaCCR_write (HostReg<uint32_t> *reg_p, uint32_t word){
+    DMA_Channel_TypeDef *channel = (DMA_Channel_TypeDef *) reg_p;   // CCR is the first register
+    bool isStarted = ((reg_p->value & DMA_CCR1_EN) == 0) && ((word & DMA_CCR1_EN) != 0);
+    uint32_t primask;
+    uint8_t num;
+
+    if (isStarted){
+        if ((channel >= DMA1_Channel1) && (channel <= DMA1_Channel7))
+            num = channel - DMA1_Channel1;
+        else
+            num = 7 + (channel - DMA2_Channel1);
+        host_dmaStarts[num].mem = channel->CMAR.value;
+        host_dmaStarts[num].count = (uint16_t) channel->CNDTR.value;
+    }
+    reg_p->value = word;
+
+    if (!isStarted)
+        return;
+    for (num = 0; num < host_numOfUSARTs; num++){
+        if (host_usarts[num].txChannel == channel){
+            primask = __get_PRIMASK();
+            __disable_irq();
+            host_usart_dmaTx (&host_usarts[num]);
+            __set_PRIMASK(primask);
+        }
+    }
+}
+
+/**
+ * @brief host_dma_irq, call the IRQ of a DMA1 channel while it has enabled flags (ISR context).
+ * @param uint8_t channelNum : DMA1 channel number - 1.
+ * @return None
+ */
+static void host_dma_irq (uint8_t channelNum){
+    DMA_Channel_TypeDef *channel = &host_DMA1_Channels[channelNum];
+    uint8_t count;
+
+    /* TCIE, HTIE, TEIE have the bits of TC, HT, TE */
+    for (count = 0; count < 4; count++){
+        if ((((DMA1->ISR.value >> (channelNum * 4)) & channel->CCR.value & 0x0E) == 0) ||
+            !host_nvicEnabled[DMA1_Channel1_IRQn + channelNum])
+            return;
+        host_irq_call (DMA1_Channel1_IRQn + channelNum);
+    }
+}
+
+/**<----------------------------- SPI masters ----------------------------------*/
+
+/**
+ * @brief host_spiSSLine_set, wire a GPIO to an SS line of the decoder of an SPI.
+ * @param SPI_TypeDef *SPIx
+ * @param uint8_t ssLine : bit of the decode value, < ssLines_max.
+ * @param GPIO_TypeDef *port
+ * @param uint16_t pin
+ * @return Host_ns::status_t
+ */
+status_t host_spiSSLine_set (SPI_TypeDef *SPIx, uint8_t ssLine, GPIO_TypeDef *port, uint16_t pin){
+    host_spi_s *spi_p = host_spi_get (SPIx);
+
+    if ((spi_p == NULL) || (ssLine >= ssLines_max) || (port == NULL))
+        return failed;
+
+    spi_p->ssPorts[ssLine] = port;
+    spi_p->ssPins[ssLine] = pin;
+    if (ssLine >= spi_p->numOfSSLines)
+        spi_p->numOfSSLines = ssLine + 1;
+
+    return successful;
+}
+
+/**
+ * @brief host_spiDevice_set, put a device on an output of the decoder of an SPI.
+ * @param SPI_TypeDef *SPIx
+ * @param uint8_t decodeValue
+ * @param const Host_ns::spiDevice_s *device_p : must stay valid, NULL to remove.
+ * @return Host_ns::status_t
+ */
+status_t host_spiDevice_set (SPI_TypeDef *SPIx, uint8_t decodeValue, const spiDevice_s *device_p){
+    host_spi_s *spi_p = host_spi_get (SPIx);
+
+    if ((spi_p == NULL) || (decodeValue >= host_spiDecodes_max))
+        return failed;
+
+    spi_p->devices[decodeValue] = device_p;
+
+    return successful;
+}
+
+/**
+ * @brief host_spi_get
+ * @return host_spi_s * : NULL if SPIx isn't modeled.
+ */
+static host_spi_s * host_spi_get (SPI_TypeDef *SPIx){
+    uint8_t count;
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        if (host_spis[count].SPIx == SPIx)
+            return &host_spis[count];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief host_spi_cs_update, decode SS lines, CS of the old device goes high, CS of the new one low.
+ * @return None
+ */
+static void host_spi_cs_update (host_spi_s *spi_p){
+    uint8_t line, decode = 0;
+
+    if (spi_p->numOfSSLines == 0)
+        return;
+
+    for (line = 0; line < spi_p->numOfSSLines; line++){
+        if ((spi_p->ssPorts[line] != NULL) && ((spi_p->ssPorts[line]->ODR.value & spi_p->ssPins[line]) != 0))
+            decode |= 0x01 << line;
+    }
+    if (decode == spi_p->selected)
+        return;
+
+    if ((spi_p->selected != host_decode_none) && (spi_p->devices[spi_p->selected] != NULL))
+        spi_p->devices[spi_p->selected]->cs_set (spi_p->devices[spi_p->selected]->ctx, false);
+    spi_p->selected = decode;
+    if (spi_p->devices[decode] != NULL)
+        spi_p->devices[decode]->cs_set (spi_p->devices[decode]->ctx, true);
+
+    host_spi_miso_update (spi_p);
+}
+
+/**
+ * @brief host_spi_miso_update, MISO follows SO of the selected device, high otherwise.
+ * @return None
+ */
+static void host_spi_miso_update (host_spi_s *spi_p){
+    const spiDevice_s *device_p = NULL;
+    bool level = true;
+
+    if (spi_p->selected != host_decode_none)
+        device_p = spi_p->devices[spi_p->selected];
+    if ((device_p != NULL) && (device_p->so_get != NULL))
+        level = device_p->so_get (device_p->ctx);
+
+    if (level == spi_p->misoLevel)
+        return;
+
+    spi_p->misoLevel = level;
+    if (level)
+        spi_p->misoPort->IDR.value |= spi_p->misoPin;
+    else
+        spi_p->misoPort->IDR.value &= ~(uint32_t) spi_p->misoPin;
+
+    host_exti_edge (spi_p->misoPort, spi_p->misoPin, level);
+}
+
+/**
+ * @brief host_spi_exchange, one frame with the selected device (MSB first), 0xFF(FF) if none.
+ * @return uint16_t : frame from the device.
+ */
+static uint16_t host_spi_exchange (host_spi_s *spi_p, uint16_t frame){
+    const spiDevice_s *device_p = NULL;
+    uint16_t retval;
+
+    if (spi_p->selected != host_decode_none)
+        device_p = spi_p->devices[spi_p->selected];
+
+    if ((spi_p->SPIx->CR1.value & SPI_CR1_DFF) == 0){
+        retval = (device_p != NULL) ? device_p->transfer (device_p->ctx, (uint8_t) frame) : 0xFF;
+    }
+    else if (device_p != NULL){
+        retval = (uint16_t) device_p->transfer (device_p->ctx, (uint8_t) (frame >> 8)) << 8;
+        retval |= device_p->transfer (device_p->ctx, (uint8_t) frame);
+    }
+    else
+        retval = 0xFFFF;
+
+    host_spi_miso_update (spi_p);
+
+    return retval;
+}
+
+/**
+ * @brief host_spi_kick, start a DMA transfer of a master when its channels and requests are enabled.
+ * @return None
+ */
+static void host_spi_kick (host_spi_s *spi_p){
+    uint16_t CR1 = spi_p->SPIx->CR1.value;
+    uint32_t frame_ns;
+
+    if (spi_p->isRunning || ((CR1 & SPI_CR1_MSTR) == 0) || ((CR1 & SPI_CR1_SPE) == 0))
+        return;
+    if ((spi_p->SPIx->CR2.value & (SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN)) != (SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN))
+        return;
+    if (((spi_p->rxChannel->CCR.value & DMA_CCR1_EN) == 0) || ((spi_p->txChannel->CCR.value & DMA_CCR1_EN) == 0))
+        return;
+    if (spi_p->rxChannel->CNDTR.value == 0)
+        return;
+
+    /* fPCLK / 2^(BR + 1) */
+    frame_ns = (uint32_t) (((uint64_t) ((CR1 & SPI_CR1_DFF) ? 16 : 8) * (2 << ((CR1 & SPI_CR1_BR) >> 3)) * 1000000000)
+                           / spi_p->pclk_hz);
+    spi_p->isRunning = true;
+    spi_p->due_ns = host_ns + (uint64_t) frame_ns * spi_p->rxChannel->CNDTR.value;
+}
+
+/**
+ * @brief host_spi_complete, end of a DMA transfer (ISR context) : frames are exchanged, TC of both
+ * channels is set, DMA IRQ of channels with TCIE is called.
+ * @return None
+ */
+static void host_spi_complete (host_spi_s *spi_p){
+    DMA_Channel_TypeDef *rxChannel = spi_p->rxChannel;
+    DMA_Channel_TypeDef *txChannel = spi_p->txChannel;
+    uint32_t count, frames = rxChannel->CNDTR.value;
+    bool is16b = ((spi_p->SPIx->CR1.value & SPI_CR1_DFF) != 0);
+    uint8_t size = is16b ? 2 : 1;
+    uint8_t *txMem = (uint8_t *) (uintptr_t) txChannel->CMAR.value;
+    uint8_t *rxMem = (uint8_t *) (uintptr_t) rxChannel->CMAR.value;
+    uint16_t frame;
+
+    spi_p->isRunning = false;
+    if (((rxChannel->CCR.value & DMA_CCR1_EN) == 0) || ((txChannel->CCR.value & DMA_CCR1_EN) == 0))
+        return; // stopped meanwhile
+
+    for (count = 0; count < frames; count++){
+        if (is16b)
+            memcpy (&frame, txMem, 2);
+        else
+            frame = *txMem;
+        if (txChannel->CCR.value & DMA_CCR1_MINC)
+            txMem += size;
+
+        frame = host_spi_exchange (spi_p, frame);
+
+        if (is16b)
+            memcpy (rxMem, &frame, 2);
+        else
+            *rxMem = (uint8_t) frame;
+        if (rxChannel->CCR.value & DMA_CCR1_MINC)
+            rxMem += size;
+    }
+
+    rxChannel->CNDTR.value = 0;
+    txChannel->CNDTR.value = 0;
+    DMA1->ISR.value |= ((uint32_t) 0x03 << (spi_p->rxChannelNum * 4)) | ((uint32_t) 0x03 << (spi_p->txChannelNum * 4));
+
+    if (txChannel->CCR.value & DMA_CCR1_TCIE)
+        host_irq_call (DMA1_Channel1_IRQn + spi_p->txChannelNum);
+    if (rxChannel->CCR.value & DMA_CCR1_TCIE)
+        host_irq_call (DMA1_Channel1_IRQn + spi_p->rxChannelNum);
+}
+
+/**<----------------------------- USARTs ---------------------------------------*/
+
+/**
+ * @brief host_usartLoopback_set, TX of a USART wired to its RX.
+ * @param USART_TypeDef *USARTx
+ * @param bool isOn
+ * @return Host_ns::status_t
+ */
+status_t host_usartLoopback_set (USART_TypeDef *USARTx, bool isOn){
+    host_usart_s *usart_p = host_usart_get (USARTx);
+
+    if (usart_p == NULL)
+        return failed;
+
+    usart_p->isLoopback = isOn;
+
+    return successful;
+}
+
+/**
+ * @brief host_usartSink_set, frames sent by a USART go to sink_p (ISR context), at the end of their stop bit.
+ * @param USART_TypeDef *USARTx
+ * @param void (* sink_p) (void *ctx, uint16_t data) : NULL to remove.
+ * @param void *ctx
+ * @return Host_ns::status_t
+ */
+status_t host_usartSink_set (USART_TypeDef *USARTx, void (* sink_p) (void *ctx, uint16_t data), void *ctx){
+    host_usart_s *usart_p = host_usart_get (USARTx);
+    uint32_t primask;
+
+    if (usart_p == NULL)
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    usart_p->sink_p = sink_p;
+    usart_p->sinkCtx = ctx;
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+ * @brief host_usartSource_set, frames received by a USART are taken from source_p (ISR context), polled
+ * once per frame time at the rate of BRR. source_p returns false when it has no frame to send.
+ * @param USART_TypeDef *USARTx
+ * @param bool (* source_p) (void *ctx, uint16_t *data_p) : NULL to remove.
+ * @param void *ctx
+ * @return Host_ns::status_t
+ */
+status_t host_usartSource_set (USART_TypeDef *USARTx, bool (* source_p) (void *ctx, uint16_t *data_p), void *ctx){
+    host_usart_s *usart_p = host_usart_get (USARTx);
+    uint32_t primask;
+
+    if (usart_p == NULL)
+        return failed;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    usart_p->source_p = source_p;
+    usart_p->sourceCtx = ctx;
+    usart_p->sourceDue_ns = host_ns;
+    __set_PRIMASK(primask);
+
+    return successful;
+}
+
+/**
+ * @brief host_usart_get
+ * @return host_usart_s * : NULL if USARTx isn't modeled.
+ */
+static host_usart_s * host_usart_get (USART_TypeDef *USARTx){
+    uint8_t count;
+
+    for (count = 0; count < host_numOfUSARTs; count++){
+        if (host_usarts[count].USARTx == USARTx)
+            return &host_usarts[count];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief host_usartDR_read, RX side of DR, clears RXNE, ORE and IDLE (SR has been read before).
+ * @return uint16_t
+ */
+static uint16_t host_usartDR_read (HostReg<uint16_t> *reg_p){
+    USART_TypeDef *USARTx = NULL;
+    uint32_t primask;
+    uint16_t data;
+    uint8_t count;
+
+    for (count = 0; count < host_numOfUSARTs; count++){
+        if (reg_p == &host_usarts[count].USARTx->DR)
+            USARTx = host_usarts[count].USARTx;
+    }
+    if (USARTx == NULL)
+        return reg_p->value;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    data = reg_p->value;
+    USARTx->SR.value &= (uint16_t) ~(USART_SR_RXNE | USART_SR_ORE | USART_SR_IDLE);
+    __set_PRIMASK(primask);
+
+    return data;
+}
+
+/**
+ * @brief host_usartDR_write, TX side of DR.
+ * @return None
+ */
+static void host_usartDR_write (HostReg<uint16_t> *reg_p, uint16_t word){
+    uint32_t primask;
+    uint8_t count;
+
+    for (count = 0; count < host_numOfUSARTs; count++){
+        if (reg_p == &host_usarts[count].USARTx->DR){
+            primask = __get_PRIMASK();
+            __disable_irq();
+            host_usart_tx (&host_usarts[count], word);
+            __set_PRIMASK(primask);
+        }
+    }
+}
+
+/**
+ * @brief host_usart_frame_ns, start bit, data bits (M), stop bits at the rate of BRR.
+ * @return uint32_t : 0 if BRR isn't set.
+ */
+static uint32_t host_usart_frame_ns (host_usart_s *usart_p){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+    uint32_t bits;
+
+    if (USARTx->BRR.value == 0)
+        return 0;
+
+    bits = 1 + (((USARTx->CR1.value & USART_CR1_M) != 0) ? 9 : 8) +
+           (((USARTx->CR2.value & USART_StopBits_2) != 0) ? 2 : 1);
+
+    return (uint32_t) ((uint64_t) bits * USARTx->BRR.value * 1000000000 / usart_p->pclk_hz);
+}
+
+/**
+ * @brief host_usart_tx, a frame is written to DR : to the shift register if it's empty, TDR otherwise.
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+static void host_usart_tx (host_usart_s *usart_p, uint16_t data){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+
+    if ((USARTx->CR1.value & (USART_CR1_UE | USART_CR1_TE)) != (USART_CR1_UE | USART_CR1_TE))
+        return;
+
+    data &= 0x01FF;
+    USARTx->SR.value &= (uint16_t) ~USART_SR_TC;
+
+    if (!usart_p->isShifting){
+        usart_p->shift = data;
+        usart_p->shiftBRR = USARTx->BRR.value;
+        usart_p->isShifting = true;
+        usart_p->shiftDue_ns = host_ns + host_usart_frame_ns (usart_p);
+        USARTx->SR.value |= USART_SR_TXE;
+        return;
+    }
+
+    usart_p->tdr = data;
+    USARTx->SR.value &= (uint16_t) ~USART_SR_TXE;
+}
+
+/**
+ * @brief host_usart_rx, a frame is received : to memory by DMA, or to DR (ORE if RXNE is still set).
+ * Mute mode (RWU) drops every frame, address marks aren't modeled.
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+static void host_usart_rx (host_usart_s *usart_p, uint16_t data){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+    DMA_Channel_TypeDef *channel = usart_p->rxChannel;
+    host_dmaStart_s *start_p = &host_dmaStarts[usart_p->rxChannelNum];
+    uint32_t offset;
+
+    if (((USARTx->CR1.value & (USART_CR1_UE | USART_CR1_RE)) != (USART_CR1_UE | USART_CR1_RE)) ||
+        ((USARTx->CR1.value & USART_CR1_RWU) != 0))
+        return;
+
+    usart_p->isIdleArmed = true;
+    usart_p->idleDue_ns = host_ns + host_usart_frame_ns (usart_p);
+
+    if (((USARTx->CR3.value & USART_CR3_DMAR) != 0) && ((channel->CCR.value & DMA_CCR1_EN) != 0) &&
+        (channel->CNDTR.value != 0)){
+        offset = ((channel->CCR.value & DMA_CCR1_MINC) != 0) ? start_p->count - channel->CNDTR.value : 0;
+        *(uint8_t *) (uintptr_t) (start_p->mem + offset) = (uint8_t) data;
+
+        channel->CNDTR.value--;
+        if (channel->CNDTR.value == (uint32_t) start_p->count / 2)
+            DMA1->ISR.value |= (uint32_t) 0x05 << (usart_p->rxChannelNum * 4);
+        if (channel->CNDTR.value == 0){
+            DMA1->ISR.value |= (uint32_t) 0x03 << (usart_p->rxChannelNum * 4);
+            if ((channel->CCR.value & DMA_CCR1_CIRC) != 0)
+                channel->CNDTR.value = start_p->count;
+        }
+        return;
+    }
+
+    if ((USARTx->SR.value & USART_SR_RXNE) != 0){
+        USARTx->SR.value |= USART_SR_ORE;
+        return;
+    }
+    USARTx->DR.value = data;
+    USARTx->SR.value |= USART_SR_RXNE;
+}
+
+/**
+ * @brief host_usart_dmaTx, DMA TX requests are served while TXE is set.
+ * @return None
+ * @attention : called with IRQs disabled.
+ */
+static void host_usart_dmaTx (host_usart_s *usart_p){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+    DMA_Channel_TypeDef *channel = usart_p->txChannel;
+    host_dmaStart_s *start_p = &host_dmaStarts[usart_p->txChannelNum];
+    uint32_t offset;
+    uint16_t data;
+
+    while (((USARTx->CR3.value & USART_CR3_DMAT) != 0) && ((channel->CCR.value & DMA_CCR1_EN) != 0) &&
+           (channel->CNDTR.value != 0) && ((USARTx->SR.value & USART_SR_TXE) != 0)){
+        offset = ((channel->CCR.value & DMA_CCR1_MINC) != 0) ? start_p->count - channel->CNDTR.value : 0;
+        data = *(uint8_t *) (uintptr_t) (start_p->mem + offset);
+
+        channel->CNDTR.value--;
+        if (channel->CNDTR.value == (uint32_t) start_p->count / 2)
+            DMA1->ISR.value |= (uint32_t) 0x05 << (usart_p->txChannelNum * 4);
+        if (channel->CNDTR.value == 0){
+            DMA1->ISR.value |= (uint32_t) 0x03 << (usart_p->txChannelNum * 4);
+            host_isKick = true;
+            host_irqPending = 1;
+        }
+
+        host_usart_tx (usart_p, data);
+    }
+}
+
+/**
+ * @brief host_usart_update, end of the frame in the shift register, frames of the source, IDLE line, DMA requests (ISR context).
+ * @return None
+ */
+static void host_usart_update (host_usart_s *usart_p){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+    uint16_t data;
+    uint32_t frame_ns;
+    bool isLost;
+
+    if (usart_p->isShifting && (usart_p->shiftDue_ns <= host_ns)){
+        data = usart_p->shift;
+        isLost = (usart_p->shiftBRR != USARTx->BRR.value);
+
+        if ((USARTx->SR.value & USART_SR_TXE) == 0){
+            usart_p->shift = usart_p->tdr;
+            usart_p->shiftBRR = USARTx->BRR.value;
+            usart_p->shiftDue_ns += host_usart_frame_ns (usart_p);
+            USARTx->SR.value |= USART_SR_TXE;
+        }
+        else {
+            usart_p->isShifting = false;
+            USARTx->SR.value |= USART_SR_TC;
+        }
+
+        /* a frame cut by a new BRR is lost (framing error at the other end) */
+        if (!isLost && (usart_p->sink_p != NULL))
+            usart_p->sink_p (usart_p->sinkCtx, data);
+        if (!isLost && usart_p->isLoopback)
+            host_usart_rx (usart_p, data);
+    }
+
+    if ((usart_p->source_p != NULL) && (usart_p->sourceDue_ns <= host_ns)){
+        frame_ns = host_usart_frame_ns (usart_p);
+        usart_p->sourceDue_ns = host_ns + ((frame_ns != 0) ? frame_ns : (uint64_t) step_us * 1000);
+        if (usart_p->source_p (usart_p->sourceCtx, &data))
+            host_usart_rx (usart_p, data);
+    }
+
+    if (usart_p->isIdleArmed && (usart_p->idleDue_ns <= host_ns)){
+        usart_p->isIdleArmed = false;
+        USARTx->SR.value |= USART_SR_IDLE;
+    }
+
+    host_usart_dmaTx (usart_p);
+}
+
+/**
+ * @brief host_usart_irq, call the IRQ of a USART while it has enabled flags (ISR context).
+ * @return None
+ */
+static void host_usart_irq (host_usart_s *usart_p){
+    USART_TypeDef *USARTx = usart_p->USARTx;
+    uint16_t SR, CR1;
+    uint8_t count;
+
+    for (count = 0; count < 4; count++){
+        SR = USARTx->SR.value;
+        CR1 = USARTx->CR1.value;
+        if (!(((CR1 & USART_CR1_RXNEIE) && (SR & (USART_SR_RXNE | USART_SR_ORE))) ||
+              ((CR1 & USART_CR1_IDLEIE) && (SR & USART_SR_IDLE)) ||
+              ((CR1 & USART_CR1_TXEIE) && (SR & USART_SR_TXE)) ||
+              ((CR1 & USART_CR1_TCIE) && (SR & USART_SR_TC))))
+            return;
+        if (!host_nvicEnabled[usart_p->IRQn])
+            return;
+
+        host_irq_call (usart_p->IRQn);
+        host_usart_dmaTx (usart_p);
+    }
+}
+
+/**<----------------------------- misc timer -----------------------------------*/
+
+/**
+ * @brief host_miscTIM_set, call an ISR every period, it sets miscTIM_period.
+ * @param void (* isr_p) (void) : ISR of the misc timer, NULL to stop it.
+ * @param uint16_t period_ms : > 0.
+ * @return None
+ */
+void host_miscTIM_set (void (* isr_p) (void), uint16_t period_ms){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    miscTIM_period = period_ms;
+    host_miscTIM_due_ns = host_ns + (uint64_t) period_ms * 1000000;
+    host_miscTIM_isr_p = (period_ms != 0) ? isr_p : NULL;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief host_ns_get
+ * @return uint64_t : simulated time since host_run.
+ */
+uint64_t host_ns_get (void){
+    return host_ns;
+}
+
+/**<----------------------------- MB1_Misc.h -----------------------------------*/
+
+void delay_ms (uint32_t msec){
+    uint64_t end_ns = host_ns + (uint64_t) msec * 1000000;
+
+    while (host_ns < end_ns);
+}
+
+uint32_t ticks_ms_get (void){
+    return (uint32_t) (host_ns / 1000000);
+}
+
+void ticks_ms_miscTIMISR (void){
+}
+
+void cycles_enable (void){
+}
+
+uint32_t cycles_get (void){
+    return (uint32_t) (host_ns * (cpu_hz / 1000000) / 1000);
+}
+
+/**<----------------------------- StdPeriph ------------------------------------*/
+
+/**< GPIO */
+void GPIO_Init (GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct){
+    (void) GPIOx;
+    (void) GPIO_InitStruct;
+}
+
+void GPIO_SetBits (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    GPIOx->BSRR = GPIO_Pin;
+}
+
+void GPIO_ResetBits (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    GPIOx->BRR = GPIO_Pin;
+}
+
+uint8_t GPIO_ReadInputDataBit (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    return ((GPIOx->IDR & GPIO_Pin) != 0) ? 1 : 0;
+}
+
+uint8_t GPIO_ReadOutputDataBit (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    return ((GPIOx->ODR & GPIO_Pin) != 0) ? 1 : 0;
+}
+
+void GPIO_PinRemapConfig (uint32_t GPIO_Remap, FunctionalState NewState){
+    (void) GPIO_Remap;
+    (void) NewState;
+}
+
+void GPIO_EXTILineConfig (uint8_t GPIO_PortSource, uint8_t GPIO_PinSource){
+    if (GPIO_PinSource < 16)
+        host_extiPorts[GPIO_PinSource] = GPIO_PortSource;
+}
+
+/**< RCC */
+void RCC_APB2PeriphClockCmd (uint32_t RCC_APB2Periph, FunctionalState NewState){
+    if (NewState != DISABLE)
+        RCC->APB2ENR |= RCC_APB2Periph;
+    else
+        RCC->APB2ENR &= ~RCC_APB2Periph;
+}
+
+void RCC_APB1PeriphClockCmd (uint32_t RCC_APB1Periph, FunctionalState NewState){
+    if (NewState != DISABLE)
+        RCC->APB1ENR |= RCC_APB1Periph;
+    else
+        RCC->APB1ENR &= ~RCC_APB1Periph;
+}
+
+void RCC_AHBPeriphClockCmd (uint32_t RCC_AHBPeriph, FunctionalState NewState){
+    if (NewState != DISABLE)
+        RCC->AHBENR |= RCC_AHBPeriph;
+    else
+        RCC->AHBENR &= ~RCC_AHBPeriph;
+}
+
+void RCC_GetClocksFreq (RCC_ClocksTypeDef *RCC_Clocks){
+    RCC_Clocks->SYSCLK_Frequency = cpu_hz;
+    RCC_Clocks->HCLK_Frequency = cpu_hz;
+    RCC_Clocks->PCLK1_Frequency = cpu_hz / 2;
+    RCC_Clocks->PCLK2_Frequency = cpu_hz;
+    RCC_Clocks->ADCCLK_Frequency = cpu_hz / 6;
+}
+
+/**< SPI */
+void SPI_Init (SPI_TypeDef *SPIx, SPI_InitTypeDef *SPI_InitStruct){
+    SPIx->CR1 = (uint16_t) ((SPIx->CR1 & SPI_CR1_SPE) | SPI_InitStruct->SPI_Direction | SPI_InitStruct->SPI_Mode |
+                            SPI_InitStruct->SPI_DataSize | SPI_InitStruct->SPI_CPOL | SPI_InitStruct->SPI_CPHA |
+                            SPI_InitStruct->SPI_NSS | SPI_InitStruct->SPI_BaudRatePrescaler |
+                            SPI_InitStruct->SPI_FirstBit);
+    SPIx->CRCPR = SPI_InitStruct->SPI_CRCPolynomial;
+}
+
+void SPI_Cmd (SPI_TypeDef *SPIx, FunctionalState NewState){
+    if (NewState != DISABLE)
+        SPIx->CR1 |= SPI_CR1_SPE;
+    else
+        SPIx->CR1 &= (uint16_t) ~SPI_CR1_SPE;
+}
+
+FlagStatus SPI_I2S_GetFlagStatus (SPI_TypeDef *SPIx, uint16_t SPI_I2S_FLAG){
+    return ((SPIx->SR & SPI_I2S_FLAG) != 0) ? SET : RESET;
+}
+
+void SPI_I2S_SendData (SPI_TypeDef *SPIx, uint16_t Data){
+    host_spi_s *spi_p = host_spi_get (SPIx);
+    uint32_t primask;
+
+    if (spi_p == NULL)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    SPIx->DR.value = host_spi_exchange (spi_p, Data);
+    SPIx->SR.value |= SPI_I2S_FLAG_RXNE;
+    __set_PRIMASK(primask);
+}
+
+uint16_t SPI_I2S_ReceiveData (SPI_TypeDef *SPIx){
+    SPIx->SR.value &= (uint16_t) ~SPI_I2S_FLAG_RXNE;
+
+    return SPIx->DR.value;
+}
+
+void SPI_I2S_DMACmd (SPI_TypeDef *SPIx, uint16_t SPI_I2S_DMAReq, FunctionalState NewState){
+    host_spi_s *spi_p = host_spi_get (SPIx);
+
+    if (NewState != DISABLE)
+        SPIx->CR2 |= SPI_I2S_DMAReq;
+    else
+        SPIx->CR2 &= (uint16_t) ~SPI_I2S_DMAReq;
+
+    if (spi_p != NULL)
+        host_spi_kick (spi_p);
+}
+
+/**< DMA */
+void DMA_DeInit (DMA_Channel_TypeDef *DMAy_Channelx){
+    DMA_TypeDef *dma = DMA1;
+    uint32_t num;
+
+    DMAy_Channelx->CCR = 0;
+    DMAy_Channelx->CNDTR = 0;
+    DMAy_Channelx->CPAR = 0;
+    DMAy_Channelx->CMAR = 0;
+
+    if ((DMAy_Channelx >= DMA1_Channel1) && (DMAy_Channelx <= DMA1_Channel7))
+        num = DMAy_Channelx - DMA1_Channel1;
+    else {
+        dma = DMA2;
+        num = DMAy_Channelx - DMA2_Channel1;
+    }
+    dma->ISR.value &= ~((uint32_t) 0x0F << (num * 4));
+}
+
+void DMA_Init (DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct){
+    DMAy_Channelx->CCR = (DMAy_Channelx->CCR & (DMA_CCR1_EN | DMA_CCR1_TCIE | DMA_CCR1_HTIE | DMA_CCR1_TEIE)) |
+                         DMA_InitStruct->DMA_DIR | DMA_InitStruct->DMA_Mode | DMA_InitStruct->DMA_PeripheralInc |
+                         DMA_InitStruct->DMA_MemoryInc | DMA_InitStruct->DMA_PeripheralDataSize |
+                         DMA_InitStruct->DMA_MemoryDataSize | DMA_InitStruct->DMA_Priority | DMA_InitStruct->DMA_M2M;
+    DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize;
+    DMAy_Channelx->CPAR = DMA_InitStruct->DMA_PeripheralBaseAddr;
+    DMAy_Channelx->CMAR = DMA_InitStruct->DMA_MemoryBaseAddr;
+}
+
+void DMA_Cmd (DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState){
+    uint8_t count;
+
+    if (NewState != DISABLE)
+        DMAy_Channelx->CCR |= DMA_CCR1_EN;
+    else
+        DMAy_Channelx->CCR &= ~DMA_CCR1_EN;
+
+    for (count = 0; count < host_numOfSPIs; count++){
+        if ((host_spis[count].rxChannel == DMAy_Channelx) || (host_spis[count].txChannel == DMAy_Channelx))
+            host_spi_kick (&host_spis[count]);
+    }
+}
+
+void DMA_ITConfig (DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState){
+    if (NewState != DISABLE)
+        DMAy_Channelx->CCR |= DMA_IT;
+    else
+        DMAy_Channelx->CCR &= ~DMA_IT;
+}
+
+uint16_t DMA_GetCurrDataCounter (DMA_Channel_TypeDef *DMAy_Channelx){
+    return (uint16_t) DMAy_Channelx->CNDTR;
+}
+
+void DMA_SetCurrDataCounter (DMA_Channel_TypeDef *DMAy_Channelx, uint16_t DataNumber){
+    DMAy_Channelx->CNDTR = DataNumber;
+}
+
+/**< USART */
+void USART_Init (USART_TypeDef *USARTx, USART_InitTypeDef *USART_InitStruct){
+    host_usart_s *usart_p = host_usart_get (USARTx);
+    uint32_t pclk_hz = (usart_p != NULL) ? usart_p->pclk_hz : cpu_hz / 2;
+    uint32_t baud = USART_InitStruct->USART_BaudRate;
+
+    USARTx->CR1 = (uint16_t) ((USARTx->CR1 & ~(USART_CR1_M | USART_Parity_Odd | USART_CR1_TE | USART_CR1_RE)) |
+                              USART_InitStruct->USART_WordLength | USART_InitStruct->USART_Parity |
+                              USART_InitStruct->USART_Mode);
+    USARTx->CR2 = (uint16_t) ((USARTx->CR2 & ~USART_StopBits_1_5) | USART_InitStruct->USART_StopBits);
+    USARTx->CR3 = (uint16_t) ((USARTx->CR3 & ~USART_HardwareFlowControl_RTS_CTS) |
+                              USART_InitStruct->USART_HardwareFlowControl);
+    USARTx->BRR = (uint16_t) ((baud == 0) ? 0 : (pclk_hz + baud / 2) / baud);
+}
+
+void USART_Cmd (USART_TypeDef *USARTx, FunctionalState NewState){
+    if (NewState != DISABLE)
+        USARTx->CR1 |= USART_CR1_UE;
+    else
+        USARTx->CR1 &= (uint16_t) ~USART_CR1_UE;
+}
+
+FlagStatus USART_GetFlagStatus (USART_TypeDef *USARTx, uint16_t USART_FLAG){
+    return ((USARTx->SR & USART_FLAG) != 0) ? SET : RESET;
+}
+
+void USART_ClearFlag (USART_TypeDef *USARTx, uint16_t USART_FLAG){
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    USARTx->SR.value &= (uint16_t) ~USART_FLAG;
+    __set_PRIMASK(primask);
+}
+
+/**< USART_IT : flag bit (15:8), register (7:5, CR1 = 1), enable bit (4:0) */
+ITStatus USART_GetITStatus (USART_TypeDef *USARTx, uint16_t USART_IT){
+    HostReg<uint16_t> *CRx = (((USART_IT >> 5) & 0x07) == 1) ? &USARTx->CR1 :
+                             (((USART_IT >> 5) & 0x07) == 2) ? &USARTx->CR2 : &USARTx->CR3;
+
+    return (((*CRx & (0x01 << (USART_IT & 0x1F))) != 0) && ((USARTx->SR & (0x01 << (USART_IT >> 8))) != 0)) ?
+           SET : RESET;
+}
+
+void USART_ClearITPendingBit (USART_TypeDef *USARTx, uint16_t USART_IT){
+    USART_ClearFlag (USARTx, (uint16_t) (0x01 << (USART_IT >> 8)));
+}
+
+void USART_SendData (USART_TypeDef *USARTx, uint16_t Data){
+    USARTx->DR = (uint16_t) (Data & 0x01FF);
+}
+
+uint16_t USART_ReceiveData (USART_TypeDef *USARTx){
+    return (uint16_t) (USARTx->DR & 0x01FF);
+}
+
+void USART_ITConfig (USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState){
+    HostReg<uint16_t> *CRx = (((USART_IT >> 5) & 0x07) == 1) ? &USARTx->CR1 :
+                             (((USART_IT >> 5) & 0x07) == 2) ? &USARTx->CR2 : &USARTx->CR3;
+    uint16_t bit = (uint16_t) (0x01 << (USART_IT & 0x1F));
+
+    if (NewState != DISABLE){
+        *CRx |= bit;
+        host_isKick = true;     // a flag may be set already
+        host_irqPending = 1;
+    }
+    else
+        *CRx &= (uint16_t) ~bit;
+}
+
+void USART_DMACmd (USART_TypeDef *USARTx, uint16_t USART_DMAReq, FunctionalState NewState){
+    host_usart_s *usart_p = host_usart_get (USARTx);
+    uint32_t primask;
+
+    if (NewState != DISABLE)
+        USARTx->CR3 |= USART_DMAReq;
+    else
+        USARTx->CR3 &= (uint16_t) ~USART_DMAReq;
+
+    if (usart_p != NULL){
+        primask = __get_PRIMASK();
+        __disable_irq();
+        host_usart_dmaTx (usart_p);
+        __set_PRIMASK(primask);
+    }
+}
+
+void USART_SetAddress (USART_TypeDef *USARTx, uint8_t USART_Address){
+    USARTx->CR2 = (uint16_t) ((USARTx->CR2 & ~0x000F) | (USART_Address & 0x0F));
+}
+
+void USART_WakeUpConfig (USART_TypeDef *USARTx, uint16_t USART_WakeUp){
+    USARTx->CR1 = (uint16_t) ((USARTx->CR1 & ~USART_CR1_WAKE) | USART_WakeUp);
+}
+
+void USART_ReceiverWakeUpCmd (USART_TypeDef *USARTx, FunctionalState NewState){
+    if (NewState != DISABLE)
+        USARTx->CR1 |= USART_CR1_RWU;
+    else
+        USARTx->CR1 &= (uint16_t) ~USART_CR1_RWU;
+}
+
+/**< NVIC */
+void NVIC_Init (NVIC_InitTypeDef *NVIC_InitStruct){
+    if (NVIC_InitStruct->NVIC_IRQChannel < host_numOfIRQns)
+        host_nvicEnabled[NVIC_InitStruct->NVIC_IRQChannel] = (NVIC_InitStruct->NVIC_IRQChannelCmd != DISABLE);
+}
+
+void NVIC_PriorityGroupConfig (uint32_t NVIC_PriorityGroup){
+    (void) NVIC_PriorityGroup;
+}
+
+/**< EXTI */
+void EXTI_Init (EXTI_InitTypeDef *EXTI_InitStruct){
+    uint32_t line = EXTI_InitStruct->EXTI_Line;
+
+    EXTI->IMR &= ~line;
+    EXTI->EMR &= ~line;
+    EXTI->RTSR &= ~line;
+    EXTI->FTSR &= ~line;
+    if (EXTI_InitStruct->EXTI_LineCmd == DISABLE)
+        return;
+
+    if (EXTI_InitStruct->EXTI_Mode == EXTI_Mode_Interrupt)
+        EXTI->IMR |= line;
+    else
+        EXTI->EMR |= line;
+
+    if (EXTI_InitStruct->EXTI_Trigger != EXTI_Trigger_Falling)
+        EXTI->RTSR |= line;
+    if (EXTI_InitStruct->EXTI_Trigger != EXTI_Trigger_Rising)
+        EXTI->FTSR |= line;
+}
+
+ITStatus EXTI_GetITStatus (uint32_t EXTI_Line){
+    return (((EXTI->PR & EXTI_Line) != 0) && ((EXTI->IMR & EXTI_Line) != 0)) ? SET : RESET;
+}
+
+void EXTI_ClearITPendingBit (uint32_t EXTI_Line){
+    EXTI->PR = EXTI_Line;
+}
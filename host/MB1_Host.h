@@ -0,0 +1,83 @@
+/**
+ * @file MB1_Host.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief This is header file for a host model of MBoard-1, drivers run unchanged on Linux against it.
+ * The model works at transaction level, time is simulated :
+ * - SPI master : a DMA transfer (both channels enabled, SPI DMA requests on) takes frames * frame time
+ *   of the prescaler, then its frames are exchanged with the device selected by the SS lines in one
+ *   step, DMA flags are set and the DMA IRQ handler is called. Blocking SendData exchanges at once.
+ *   Slave mode and integrity mode (hardware CRC) aren't modeled.
+ * - SS lines (BSRR/BRR stores) go through a decoder : the device of the decode value is selected.
+ * - MISO follows so_get of the selected device (high otherwise), its edges set EXTI pending bits.
+ * - USART1..3 : a frame takes (start + data + stop bits) * BRR cycles of PCLK, DR and TXE/TC work as a
+ *   TX buffer and a shift register, DMA TX/RX (normal or circular) move a byte per frame, RXNE/ORE, IDLE
+ *   one frame after the last received frame. Sent frames go to a sink and to RX if loopback is on.
+ *   Parity, noise, mute mode and UART4/5 aren't modeled.
+ * - The misc timer calls one ISR every period, MB1_Misc.h is implemented here (not MB1_Misc.cpp),
+ *   cycles_get counts 72 MHz cycles of simulated time.
+ * - Interrupts are ticks of SIGALRM : each tick advances time (up to step_us, or to the next event),
+ *   runs devices, DMA completions, misc timer and EXTI. While PRIMASK is set, the tick waits.
+ * - Drivers put 32-bit addresses in DMA registers : build with -no-pie, host_run runs the test on
+ *   a stack below 4GB, buffers given to DMA must be static or on this stack. -fpermissive accepts
+ *   the pointer casts of the drivers (with a warning each, -w hides them).
+ * How to use this lib:
+ * - Build with -Ihost (host/stm32f10x.h instead of StdPeriph), -fpermissive -no-pie, MB1_Host.cpp and
+ *   the drivers under test, e.g. :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -I. -Ihost host/mb1_at25check.cpp host/MB1_Host.cpp \
+ *          MB1_AT25.cpp MB1_AT25Model.cpp MB1_SPI.cpp MB1_DMA.cpp -o mb1_at25check
+ * - Wire devices : host_spiSSLine_set (same GPIOs as SM_GPIO_set), host_spiDevice_set (decode value).
+ * - host_miscTIM_set for drivers which need miscTIM ISRs.
+ * - host_usartLoopback_set, host_usartSink_set, host_usartSource_set to talk to USARTs.
+ * - RCC keeps the enable bits of clocks, the CRC unit computes only while its AHB clock is on.
+ * - host_run (test, timeLimit_ms) : test runs with interrupts, the process exits if simulated time
+ *   goes over the limit (deadlock).
+ */
+
+#ifndef __MB1_HOST_H
+#define __MB1_HOST_H
+
+/* Includes */
+#include "stm32f10x.h"
+
+namespace Host_ns {
+
+/**< config (compile-time) */
+const uint32_t step_us = 20;                // simulated time of a tick, at most
+const uint32_t tickPeriod_us = 20;          // real time between ticks
+const uint32_t stack_size = 0x100000;       // stack of the test, below 4GB
+const uint32_t cpu_hz = 72000000;
+const uint8_t ssLines_max = 3;
+
+typedef enum {
+    successful,
+    failed
+} status_t;
+
+/**< device on an SPI bus, called with interrupts masked (ISR context or hooks of registers) */
+typedef struct {
+    void (* cs_set) (void *ctx, bool isLow);
+    uint8_t (* transfer) (void *ctx, uint8_t mosi);
+    void (* tick_us) (void *ctx, uint32_t us);      // can be NULL
+    bool (* so_get) (void *ctx);                    // level of SO while selected, NULL : high
+    void *ctx;
+} spiDevice_s;
+
+}
+
+/* Prototypes */
+int host_run (int (* test_p) (void), uint32_t timeLimit_ms);
+
+Host_ns::status_t host_spiSSLine_set (SPI_TypeDef *SPIx, uint8_t ssLine, GPIO_TypeDef *port, uint16_t pin);
+Host_ns::status_t host_spiDevice_set (SPI_TypeDef *SPIx, uint8_t decodeValue, const Host_ns::spiDevice_s *device_p);
+
+Host_ns::status_t host_usartLoopback_set (USART_TypeDef *USARTx, bool isOn);
+Host_ns::status_t host_usartSink_set (USART_TypeDef *USARTx, void (* sink_p) (void *ctx, uint16_t data), void *ctx);
+Host_ns::status_t host_usartSource_set (USART_TypeDef *USARTx, bool (* source_p) (void *ctx, uint16_t *data_p), void *ctx);
+
+void host_miscTIM_set (void (* isr_p) (void), uint16_t period_ms);
+
+uint64_t host_ns_get (void);
+
+#endif // __MB1_HOST_H
@@ -0,0 +1,281 @@
+/**
+ * @file mb1_at25check.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux check of MB1_AT25 over the SPI transaction queue and DMA, against MB1_AT25Model
+ * on the host model of MBoard-1 (MB1_Host.h) :
+ * - multi-block erase (4KB, 64KB, 64KB, 32KB), blocks around are kept.
+ * - multi-page program from an unaligned address, more than 64KB.
+ * - reads of more than 64KB (several DMA chunks), also while a second flash on the same bus programs :
+ *   its transactions go between the chunks of the read.
+ * - a part of a command which fails cancels the rest of its CS window.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -I. -Ihost host/mb1_at25check.cpp host/MB1_Host.cpp \
+ *          MB1_AT25.cpp MB1_AT25Model.cpp MB1_SPI.cpp MB1_DMA.cpp -o mb1_at25check
+ */
+
+/* Includes */
+#include "MB1_AT25.h"
+#include "MB1_AT25Model.h"
+#include "MB1_DMA.h"
+#include "MB1_Host.h"
+#include "stdio.h"
+
+/**< flash of 1MB and flash of 256KB on SPI1, SS lines 0 on PA4 and 1 on PB0 : decode values 0 and 1 */
+static uint8_t flashMem [0x100000];
+static AT25Model flashModel (flashMem, sizeof (flashMem));
+static uint8_t flash2Mem [0x40000];
+static AT25Model flash2Model (flash2Mem, sizeof (flash2Mem));
+static SPI spi1 (1);
+static AT25 flash (&spi1, SPI_ns::at25Flash_1);
+static AT25 flash2 (&spi1, SPI_ns::at25Flash_2);
+
+static uint8_t data [0x20000];
+static uint8_t readBuf [0x20000];
+
+static volatile bool isDone;
+static volatile AT25_ns::status_t doneStatus;
+static volatile bool isDone2;
+static volatile AT25_ns::status_t doneStatus2;
+static uint8_t failures = 0;
+
+/* Private functions */
+static void flash_cs_set (void *ctx, bool isLow);
+static uint8_t flash_transfer (void *ctx, uint8_t mosi);
+static void flash_tick_us (void *ctx, uint32_t us);
+static void check_done (void *arg, AT25_ns::status_t status);
+static void check_done2 (void *arg, AT25_ns::status_t status);
+static void check_wait (void);
+static void check (bool isOk, const char *name);
+static bool mem_isFilled (const uint8_t *mem, uint32_t len, uint8_t value);
+static int check_run (void);
+
+static const Host_ns::spiDevice_s flashDevice = {flash_cs_set, flash_transfer, flash_tick_us, NULL, &flashModel};
+static const Host_ns::spiDevice_s flash2Device = {flash_cs_set, flash_transfer, flash_tick_us, NULL, &flash2Model};
+
+int main (void){
+    return host_run (check_run, 10000);
+}
+
+/**
+ * @brief check_run, checks of AT25 (test context of host_run).
+ * @return int : 0 if all checks pass.
+ */
+static int check_run (void){
+    SPI_ns::SPI_params_t params;
+    SPI_ns::SM_GPIOParams_s ssLine;
+    SPI_ns::transaction_s window [3];
+    uint8_t windowTx [4] = {AT25_ns::cmd_readStatus, 0, 0, 0};
+    AT25Model_ns::stats_t stats;
+    uint32_t count, seed;
+
+    /**< SPI1 master, 18 MHz, mode 0, one SS line */
+    params.baudRatePrescaler = SPI_BaudRatePrescaler_4;
+    params.CPHA = SPI_CPHA_1Edge;
+    params.CPOL = SPI_CPOL_Low;
+    params.crcPoly = 7;
+    params.dataSize = SPI_DataSize_8b;
+    params.direction = SPI_Direction_2Lines_FullDuplex;
+    params.firstBit = SPI_FirstBit_MSB;
+    params.mode = SPI_Mode_Master;
+    params.nss = SPI_NSS_Soft;
+
+    ssLine.GPIO_port = GPIOA;
+    ssLine.GPIO_pin = GPIO_Pin_4;
+    ssLine.GPIO_clk = RCC_APB2Periph_GPIOA;
+    ssLine.ssLine = 0;
+
+    host_spiSSLine_set (SPI1, 0, GPIOA, GPIO_Pin_4);
+    host_spiSSLine_set (SPI1, 1, GPIOB, GPIO_Pin_0);
+    host_spiDevice_set (SPI1, 0, &flashDevice);
+    host_spiDevice_set (SPI1, 1, &flash2Device);
+
+    spi1.init (&params);
+    spi1.SM_numOfSSLines_set (2);
+    spi1.SM_GPIO_set (&ssLine);
+    ssLine.GPIO_port = GPIOB;
+    ssLine.GPIO_pin = GPIO_Pin_0;
+    ssLine.GPIO_clk = RCC_APB2Periph_GPIOB;
+    ssLine.ssLine = 1;
+    spi1.SM_GPIO_set (&ssLine);
+    spi1.SM_deviceToDecoder_set (SPI_ns::allFree, 3);
+    spi1.SM_deviceToDecoder_set (SPI_ns::at25Flash_1, 0);
+    spi1.SM_deviceToDecoder_set (SPI_ns::at25Flash_2, 1);
+
+    host_miscTIM_set (at25_miscTIMISR, 1);
+
+    check (flash.begin () == AT25_ns::successful, "begin");
+    check (flash.id_get () == AT25Model_ns::jedecID, "JEDEC ID");
+    check (flash2.begin () == AT25_ns::successful, "begin flash 2");
+
+    /**< erase 0x0F000 - 0x38000 : 4KB, 64KB, 64KB, 32KB */
+    memset (flashMem + 0x0E000, 0x00, 0x2B000);
+    flashModel.stats_reset ();
+    isDone = false;
+    check (flash.erase_start (0x0F000, 0x29000, check_done, NULL) == AT25_ns::successful, "erase start");
+    check_wait ();
+    flashModel.stats_get (&stats);
+    check (doneStatus == AT25_ns::successful, "erase done");
+    check ((stats.erases == 4) && (stats.bytesErased == 0x29000), "erase blocks");
+    check (mem_isFilled (flashMem + 0x0F000, 0x29000, 0xFF), "erase range is 0xFF");
+    check (mem_isFilled (flashMem + 0x0E000, 0x1000, 0x00) && mem_isFilled (flashMem + 0x38000, 0x1000, 0x00),
+           "erase keeps blocks around");
+
+    /**< program 0x12345 bytes from 0x0F080 : 292 pages */
+    seed = 1;
+    for (count = 0; count < sizeof (data); count++){
+        seed = seed * 1103515245 + 12345;
+        data[count] = (uint8_t) (seed >> 16);
+    }
+    flashModel.stats_reset ();
+    isDone = false;
+    check (flash.program_start (0x0F080, data, 0x12345, check_done, NULL) == AT25_ns::successful, "program start");
+    check_wait ();
+    flashModel.stats_get (&stats);
+    check (doneStatus == AT25_ns::successful, "program done");
+    check ((stats.pagePrograms == 292) && (stats.bytesProgrammed == 0x12345), "program pages");
+    check (memcmp (flashMem + 0x0F080, data, 0x12345) == 0, "program data");
+    check (mem_isFilled (flashMem + 0x0F000, 0x80, 0xFF) && mem_isFilled (flashMem + 0x0F080 + 0x12345, 0x100, 0xFF),
+           "program keeps bytes around");
+
+    /**< reads over 64KB : 2 and 3 DMA chunks */
+    memset (readBuf, 0, sizeof (readBuf));
+    check (flash.read (0x0F000, readBuf, 0x1A000) == AT25_ns::successful, "read 104KB");
+    check (memcmp (readBuf, flashMem + 0x0F000, 0x1A000) == 0, "read 104KB data");
+
+    memset (readBuf, 0, sizeof (readBuf));
+    isDone = false;
+    check (flash.read_start (0x0E000, readBuf, 0x20000, check_done, NULL) == AT25_ns::successful, "read start 128KB");
+    check_wait ();
+    check (doneStatus == AT25_ns::successful, "read done 128KB");
+    check (memcmp (readBuf, flashMem + 0x0E000, 0x20000) == 0, "read 128KB data");
+
+    /**< 96KB read of flash 1 while flash 2 programs : each chunk has its own command */
+    memset (flash2Mem, 0xFF, sizeof (flash2Mem));
+    memset (readBuf, 0, sizeof (readBuf));
+    isDone = false;
+    isDone2 = false;
+    check (flash2.program_start (0x100, data, 0x2000, check_done2, NULL) == AT25_ns::successful,
+           "flash 2 program start");
+    check (flash.read_start (0, readBuf, 0x18000, check_done, NULL) == AT25_ns::successful, "read start 96KB");
+    check_wait ();
+    while (!isDone2);
+    check ((doneStatus == AT25_ns::successful) && (memcmp (readBuf, flashMem, 0x18000) == 0),
+           "read 96KB next to flash 2");
+    check ((doneStatus2 == AT25_ns::successful) && (memcmp (flash2Mem + 0x100, data, 0x2000) == 0) &&
+           mem_isFilled (flash2Mem, 0x100, 0xFF) && mem_isFilled (flash2Mem + 0x2100, 0x100, 0xFF),
+           "flash 2 program next to read");
+
+    /**< a CS window whose first part can't start (DMA channels owned by another driver, e.g. USART3) :
+     * its other parts don't run */
+    DMA_channel_claim (DMA_ns::DMA1_ch2, NULL, window);
+    for (count = 0; count < 3; count++){
+        window[count].device = SPI_ns::at25Flash_1;
+        window[count].txBuf = windowTx;
+        window[count].rxBuf = NULL;
+        window[count].len = 2;
+        window[count].cs = SPI_ns::cs_auto;
+        window[count].done_p = NULL;
+        window[count].doneArg = NULL;
+    }
+    window[0].cs = SPI_ns::cs_keep;
+    flashModel.stats_reset ();
+    __disable_irq();
+    spi1.queue_submit (&window[0]);
+    spi1.queue_submit (&window[1]);
+    __enable_irq();
+    delay_ms (1);
+    check ((window[0].status == SPI_ns::busy) && (window[1].status == SPI_ns::failed),
+           "failed part cancels window");
+
+    /**< program while DMA channels are taken : WREN and command fail, page data isn't sent */
+    memcpy (readBuf, flashMem, 0x1000);
+    isDone = false;
+    check (flash.program_start (0x0, data, 0x200, check_done, NULL) == AT25_ns::successful,
+           "program start, DMA taken");
+    check_wait ();
+    flashModel.stats_get (&stats);
+    check ((doneStatus == AT25_ns::failed) && (memcmp (readBuf, flashMem, 0x1000) == 0) &&
+           (stats.pagePrograms == 0) && (stats.erases == 0), "program fails, flash kept");
+    DMA_channel_release (DMA_ns::DMA1_ch2, window);
+    check ((spi1.queue_submit (&window[2]) == SPI_ns::successful), "next window submit");
+    while (window[2].status == SPI_ns::busy);
+    check (window[2].status == SPI_ns::successful, "next window runs");
+
+    check (spi1.queue_pending () == 0, "SPI queue is empty");
+
+    printf ("%s, %u failure(s), %lu ms simulated\n", (failures == 0) ? "PASS" : "FAIL", failures,
+            (unsigned long) (host_ns_get () / 1000000));
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief check_done, done_p of AT25 operations (ISR context).
+ * @return None
+ */
+static void check_done (void *arg, AT25_ns::status_t status){
+    (void) arg;
+
+    doneStatus = status;
+    isDone = true;
+}
+
+/**
+ * @brief check_done2, done_p of flash 2 operations (ISR context).
+ * @return None
+ */
+static void check_done2 (void *arg, AT25_ns::status_t status){
+    (void) arg;
+
+    doneStatus2 = status;
+    isDone2 = true;
+}
+
+/**
+ * @brief check_wait, wait for check_done.
+ * @return None
+ */
+static void check_wait (void){
+    while (!isDone);
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
+
+/**
+ * @brief mem_isFilled
+ * @return bool : true if all bytes are value.
+ */
+static bool mem_isFilled (const uint8_t *mem, uint32_t len, uint8_t value){
+    uint32_t count;
+
+    for (count = 0; count < len; count++){
+        if (mem[count] != value)
+            return false;
+    }
+
+    return true;
+}
+
+/**< flash device on the model of SPI1 */
+static void flash_cs_set (void *ctx, bool isLow){
+    ((AT25Model *) ctx)->cs_set (isLow);
+}
+
+static uint8_t flash_transfer (void *ctx, uint8_t mosi){
+    return ((AT25Model *) ctx)->transfer (mosi);
+}
+
+static void flash_tick_us (void *ctx, uint32_t us){
+    ((AT25Model *) ctx)->tick_us (us);
+}
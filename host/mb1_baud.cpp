@@ -0,0 +1,162 @@
+/**
+ * @file mb1_baud.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux tool, host side of baud-rate negotiation (MB1_Baud.h) on a tty.
+ * The board runs baud_negotiate (MB1_BaudTarget.h), rates are tried in the given order,
+ * the last confirmed rate is printed and the tty is left at this rate.
+ * Usage :
+ *      mb1_baud /dev/ttyUSB0 115200 460800 921600 2000000      first rate is the current one
+ * Rates must be ones of termios (B115200 ... B4000000).
+ * Build (from the root of the libs) :
+ *      g++ -I. host/mb1_baud.cpp MB1_Baud.cpp MB1_Cobs.cpp -o mb1_baud
+ */
+
+/* Includes */
+#include "MB1_Baud.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "fcntl.h"
+#include "poll.h"
+#include "termios.h"
+#include "unistd.h"
+
+/**< termios rates */
+typedef struct {
+    uint32_t baud;
+    speed_t speed;
+} baud_speed_s;
+
+static const baud_speed_s baud_speeds [] = {
+    {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600}, {115200, B115200},
+    {230400, B230400}, {460800, B460800}, {500000, B500000}, {576000, B576000},
+    {921600, B921600}, {1000000, B1000000}, {1152000, B1152000}, {1500000, B1500000},
+    {2000000, B2000000}, {2500000, B2500000}, {3000000, B3000000}, {3500000, B3500000},
+    {4000000, B4000000}
+};
+
+/* Private functions */
+static bool baud_speed_get (uint32_t baud, speed_t *speed_p);
+static void baud_tty_send (void *ctx, const uint8_t *buf, uint16_t len);
+static int16_t baud_tty_get (void *ctx, uint32_t timeout_ms);
+static void baud_tty_set (void *ctx, uint32_t baud);
+
+int main (int argc, char *argv[]){
+    uint32_t rates [16];
+    uint8_t numOfRates = 0;
+    uint32_t baud;
+    speed_t speed;
+    struct termios tio;
+    int count;
+    int fd;
+
+    if ((argc < 3) || (argc - 2 > 16)){
+        fprintf (stderr, "usage : %s tty startBaud [baud ...]\n", argv[0]);
+        return 2;
+    }
+    for (count = 2; count < argc; count++){
+        rates[numOfRates] = strtoul (argv[count], NULL, 10);
+        if (!baud_speed_get (rates[numOfRates], &speed)){
+            fprintf (stderr, "%s : not a termios rate\n", argv[count]);
+            return 2;
+        }
+        numOfRates++;
+    }
+
+    fd = open (argv[1], O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (tcgetattr (fd, &tio) != 0)){
+        perror (argv[1]);
+        return 1;
+    }
+    cfmakeraw (&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr (fd, TCSANOW, &tio);
+    baud_tty_set (&fd, rates[0]);
+    tcflush (fd, TCIOFLUSH);
+
+    Baud_ns::io_s io = {&fd, baud_tty_send, baud_tty_get, baud_tty_set};
+    BaudLink link (&io, cobs_crcWord_sw);
+
+    if (link.host_negotiate (&rates[1], numOfRates - 1, rates[0], &baud) != Baud_ns::successful){
+        fprintf (stderr, "no answer at %u\n", (unsigned) rates[0]);
+        return 1;
+    }
+    printf ("%u\n", (unsigned) baud);
+    close (fd);
+
+    return 0;
+}
+
+/**
+ * @brief baud_speed_get, termios speed of a rate.
+ * @return bool : false if not a termios rate.
+ */
+static bool baud_speed_get (uint32_t baud, speed_t *speed_p){
+    uint8_t count;
+
+    for (count = 0; count < sizeof (baud_speeds) / sizeof (baud_speeds[0]); count++){
+        if (baud_speeds[count].baud == baud){
+            *speed_p = baud_speeds[count].speed;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief baud_tty_send, Baud_ns::io_s::send_p.
+ * @param void *ctx : int *fd.
+ */
+static void baud_tty_send (void *ctx, const uint8_t *buf, uint16_t len){
+    int fd = *(int *) ctx;
+    ssize_t done;
+
+    while (len > 0){
+        done = write (fd, buf, len);
+        if (done <= 0)
+            return;
+        buf += done;
+        len -= done;
+    }
+}
+
+/**
+ * @brief baud_tty_get, Baud_ns::io_s::get_p.
+ * @param void *ctx : int *fd.
+ */
+static int16_t baud_tty_get (void *ctx, uint32_t timeout_ms){
+    struct pollfd pfd;
+    uint8_t data;
+
+    pfd.fd = *(int *) ctx;
+    pfd.events = POLLIN;
+    if (poll (&pfd, 1, timeout_ms) <= 0)
+        return -1;
+    if (read (pfd.fd, &data, 1) != 1)
+        return -1;
+
+    return data;
+}
+
+/**
+ * @brief baud_tty_set, Baud_ns::io_s::baudSet_p, pending bytes are sent first.
+ * @param void *ctx : int *fd.
+ */
+static void baud_tty_set (void *ctx, uint32_t baud){
+    int fd = *(int *) ctx;
+    struct termios tio;
+    speed_t speed;
+
+    if (!baud_speed_get (baud, &speed) || (tcgetattr (fd, &tio) != 0))
+        return;
+
+    tcdrain (fd);
+    cfsetispeed (&tio, speed);
+    cfsetospeed (&tio, speed);
+    tcsetattr (fd, TCSANOW, &tio);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file mb1_baudcheck.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Checks of baud-rate negotiation (MB1_Baud.h) on the model of MBoard-1 (MB1_Host.h) :
+ * target side is baud_negotiate (MB1_BaudTarget.h) on USART2 with CRC_hwWord (hl_crc.h), host side
+ * is the one of host/mb1_baud.cpp (BaudLink with cobs_crcWord_sw), running on a thread, wired to
+ * USART2 (RX buffer) by the sink and source of the model. Bytes are lost when both rates differ by more than 2 %.
+ * Timeouts of the host side count simulated time.
+ * Checks :
+ * - CRC_hwWord turns the CRC clock on and matches cobs_crcWord_sw.
+ * - both sides negotiate from 9600 and end at 2000000 (4000000 is refused : BRR < 16), USART2 runs
+ *   at this rate.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -pthread -I. -Ihost host/mb1_baudcheck.cpp \
+ *          host/MB1_Host.cpp MB1_BaudTarget.cpp MB1_Baud.cpp MB1_Cobs.cpp hl_crc.cpp \
+ *          MB1_Serial_t.cpp MB1_SPI.cpp MB1_DMA.cpp MB1_Format.cpp -o mb1_baudcheck
+ */
+
+/* Includes */
+#include "MB1_BaudTarget.h"
+#include "MB1_Host.h"
+#include "hl_crc.h"
+#include "stdio.h"
+#include "pthread.h"
+#include "signal.h"
+#include "unistd.h"
+
+const uint32_t startBaud = 9600;
+const uint32_t usart2_hz = 36000000;
+const uint16_t ring_size = 1024;
+
+/**< bytes on the line, in one direction (single producer, single consumer) */
+typedef struct {
+    uint8_t buf [ring_size];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+} ring_s;
+
+static ring_s toPeer;                   // TX of USART2
+static ring_s fromPeer;                 // RX of USART2
+static volatile uint32_t peerBaud = startBaud;
+
+static const uint32_t peerRates [] = {115200, 460800, 921600, 2000000, 4000000};
+static Baud_ns::status_t peerStatus = Baud_ns::failed;
+static uint32_t peerResult = 0;
+static uint8_t failures = 0;
+
+/* Private functions */
+static bool ring_put (ring_s *ring_p, uint8_t data);
+static bool ring_get (ring_s *ring_p, uint8_t *data_p);
+static bool line_isSynced (void);
+static void line_sink (void *ctx, uint16_t data);
+static bool line_source (void *ctx, uint16_t *data_p);
+static void peer_send (void *ctx, const uint8_t *buf, uint16_t len);
+static int16_t peer_get (void *ctx, uint32_t timeout_ms);
+static void peer_baudSet (void *ctx, uint32_t baud);
+static void * peer_run (void *arg);
+static void check (bool isOk, const char *name);
+static int check_run (void);
+
+int main (void){
+    return host_run (check_run, 20000);
+}
+
+/**
+ * @brief check_run, checks (test context of host_run).
+ * @return int : 0 if all checks pass.
+ */
+static int check_run (void){
+    static serial_t serial2 (2);
+    static uint8_t rxBuf [256];
+    sigset_t alarm;
+    pthread_t peer;
+    uint32_t baud = 0;
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t crcSw = 0xFFFFFFFF;
+    uint32_t word;
+
+    /* CRC unit, without CRC_c::Start */
+    for (word = 0x01234567; word < 0x01234567 + 16; word++){
+        crc = CRC_hwWord (crc, word);
+        crcSw = cobs_crcWord_sw (crcSw, word);
+    }
+    check ((RCC->AHBENR & RCC_AHBPeriph_CRC) != 0, "CRC clock on");
+    check (crc == crcSw, "CRC_hwWord = cobs_crcWord_sw");
+
+    /* RX buffer (RXNE interrupt) : a polling loop of the model can't follow 2 Mbit/s */
+    serial2.Restart (startBaud);
+    serial2.RxBuffer_set (rxBuf, sizeof (rxBuf));
+    host_usartSink_set (USART2, line_sink, NULL);
+    host_usartSource_set (USART2, line_source, NULL);
+
+    /* ticks stay on this thread */
+    sigemptyset (&alarm);
+    sigaddset (&alarm, SIGALRM);
+    pthread_sigmask (SIG_BLOCK, &alarm, NULL);
+    pthread_create (&peer, NULL, peer_run, NULL);
+    pthread_sigmask (SIG_UNBLOCK, &alarm, NULL);
+
+    check (baud_negotiate (&serial2, startBaud, 1000, &baud) == Baud_ns::successful, "target negotiate");
+    pthread_join (peer, NULL);
+    check (peerStatus == Baud_ns::successful, "host negotiate");
+    printf ("target %u, host %u\n", (unsigned) baud, (unsigned) peerResult);
+    check ((baud == 2000000) && (peerResult == 2000000), "both at 2000000");
+    check (USART2->BRR.value == usart2_hz / 2000000, "USART2 at 2000000");
+
+    printf ("%s, %u failure(s), %lu ms simulated\n", (failures == 0) ? "PASS" : "FAIL", failures,
+            (unsigned long) (host_ns_get () / 1000000));
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief ring_put
+ * @return bool : false if full.
+ */
+static bool ring_put (ring_s *ring_p, uint8_t data){
+    uint16_t next = (ring_p->head + 1) % ring_size;
+
+    if (next == ring_p->tail)
+        return false;
+    ring_p->buf[ring_p->head] = data;
+    __sync_synchronize ();
+    ring_p->head = next;
+
+    return true;
+}
+
+/**
+ * @brief ring_get
+ * @return bool : false if empty.
+ */
+static bool ring_get (ring_s *ring_p, uint8_t *data_p){
+    if (ring_p->tail == ring_p->head)
+        return false;
+    __sync_synchronize ();
+    *data_p = ring_p->buf[ring_p->tail];
+    __sync_synchronize ();
+    ring_p->tail = (ring_p->tail + 1) % ring_size;
+
+    return true;
+}
+
+/**
+ * @brief line_isSynced, rate of USART2 (BRR) and rate of the host side differ by 2 % at most.
+ * @return bool
+ */
+static bool line_isSynced (void){
+    uint32_t baud;
+    uint32_t peer = peerBaud;
+
+    if (USART2->BRR.value == 0)
+        return false;
+    baud = usart2_hz / USART2->BRR.value;
+
+    return ((baud > peer) ? baud - peer : peer - baud) * 50 <= peer;
+}
+
+/**
+ * @brief line_sink, frames sent by USART2 (ISR context).
+ * @return None
+ */
+static void line_sink (void *ctx, uint16_t data){
+    (void) ctx;
+
+    if (line_isSynced ())
+        ring_put (&toPeer, (uint8_t) data);
+}
+
+/**
+ * @brief line_source, frames sent by the host side to USART2 (ISR context).
+ * @return bool : false if there is no frame, or it's lost.
+ */
+static bool line_source (void *ctx, uint16_t *data_p){
+    uint8_t data;
+    (void) ctx;
+
+    if (!ring_get (&fromPeer, &data))
+        return false;
+    *data_p = data;
+
+    return line_isSynced ();
+}
+
+/**
+ * @brief peer_send, Baud_ns::io_s::send_p of the host side.
+ * @return None
+ */
+static void peer_send (void *ctx, const uint8_t *buf, uint16_t len){
+    (void) ctx;
+
+    while (len > 0){
+        if (ring_put (&fromPeer, *buf)){
+            buf++;
+            len--;
+        }
+        else
+            usleep (20);
+    }
+}
+
+/**
+ * @brief peer_get, Baud_ns::io_s::get_p of the host side, timeout in simulated time.
+ * @return int16_t : byte, -1 on timeout.
+ */
+static int16_t peer_get (void *ctx, uint32_t timeout_ms){
+    uint64_t end_ns = host_ns_get () + (uint64_t) timeout_ms * 1000000;
+    uint8_t data;
+    (void) ctx;
+
+    while (!ring_get (&toPeer, &data)){
+        if (host_ns_get () > end_ns)
+            return -1;
+        usleep (20);
+    }
+
+    return data;
+}
+
+/**
+ * @brief peer_baudSet, Baud_ns::io_s::baudSet_p of the host side, pending bytes are sent first.
+ * @return None
+ */
+static void peer_baudSet (void *ctx, uint32_t baud){
+    (void) ctx;
+
+    while (fromPeer.tail != fromPeer.head)
+        usleep (20);
+    peerBaud = baud;
+}
+
+/**
+ * @brief peer_run, host side of host/mb1_baud.cpp (thread).
+ * @return void * : NULL.
+ */
+static void * peer_run (void *arg){
+    Baud_ns::io_s io = {NULL, peer_send, peer_get, peer_baudSet};
+    BaudLink link (&io, cobs_crcWord_sw);
+    (void) arg;
+
+    peerStatus = link.host_negotiate (peerRates, sizeof (peerRates) / sizeof (peerRates[0]), startBaud, &peerResult);
+
+    return NULL;
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file mb1_bench.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux variant of bench_run (MB1_Bench.h) on the USART model of MBoard-1 (MB1_Host.h) :
+ * USART2 with TX wired to RX, result lines ("bench,...") are taken from the TX line and written to
+ * stdout. Cycles are simulated : paths which wait for the line (out_ring, out_dma, rx_*, get_poll)
+ * measure the model of the USART, CPU-only paths (fmt_*, out_ring_call) read close to 0.
+ * Checks of the run :
+ * - every result line is complete : 8 fields, bytes_per_sec matches size and cycles_avg (a byte cut
+ *   by a baud rate change is lost on the line), rx_dma and get_poll are measured.
+ * - stdout is not retargeted and keeps its buffering after the run.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -I. -Ihost host/mb1_bench.cpp host/MB1_Host.cpp \
+ *          MB1_Bench.cpp MB1_Serial_t.cpp MB1_SPI.cpp MB1_DMA.cpp MB1_Format.cpp -o mb1_bench
+ */
+
+/* Includes */
+#include "MB1_Bench.h"
+#include "MB1_Host.h"
+#include "stdio.h"
+#include "string.h"
+
+const uint16_t line_max = 128;
+const uint8_t fields = 8;                    // "bench" and 7 columns
+
+/**< line being received from the TX line (ISR context) */
+static char line [line_max];
+static uint16_t lineLen = 0;
+static volatile uint16_t lines = 0;
+static volatile uint16_t badLines = 0;
+static volatile uint16_t rxDmaLines = 0;
+static volatile uint16_t getPollLines = 0;
+static uint8_t failures = 0;
+
+/* Private functions */
+static void bench_sink (void *ctx, uint16_t data);
+static bool bench_line_isValid (void);
+static void check (bool isOk, const char *name);
+static int bench_main (void);
+
+int main (void){
+    return host_run (bench_main, 60000);
+}
+
+/**
+ * @brief bench_main, bench_run on USART2 (test context of host_run).
+ * @return int : 0 if all checks pass.
+ */
+static int bench_main (void){
+    static serial_t serial2 (2);
+
+    host_usartLoopback_set (USART2, true);
+    host_usartSink_set (USART2, bench_sink, NULL);
+
+    serial2.Restart (115200);
+    USART_stdBuffering (USART_stdStream_stdout, serial_ns::stdBuf_full);
+
+    check (bench_run (&serial2, 115200, true) == Bench_ns::successful, "bench_run");
+    serial2.Flush ();
+    while (USART_GetFlagStatus (USART2, USART_FLAG_TC) == RESET);
+
+    printf ("%u result lines\n", lines);
+    check ((lines > 1) && (badLines == 0), "lines are complete");
+    check (rxDmaLines == Bench_ns::numOfBaudRates * Bench_ns::numOfSizes, "rx_dma measured");
+    check (getPollLines == Bench_ns::numOfBaudRates * Bench_ns::numOfSizes, "get_poll measured");
+    check (USART_stdTarget_get (USART_stdStream_stdout) == NULL, "stdout retarget restored");
+    check (USART_stdBuffering_get (USART_stdStream_stdout) == serial_ns::stdBuf_full, "stdout buffering restored");
+
+    printf ("%s, %u failure(s), %lu ms simulated\n", (failures == 0) ? "PASS" : "FAIL", failures,
+            (unsigned long) (host_ns_get () / 1000000));
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief bench_sink, frames of the TX line, lines starting with "bench," go to stdout (ISR context).
+ * @return None
+ */
+static void bench_sink (void *ctx, uint16_t data){
+    (void) ctx;
+
+    if ((char) data != '\n'){
+        if (lineLen < line_max - 1)
+            line[lineLen++] = (char) data;
+        return;
+    }
+
+    if ((lineLen > 6) && (memcmp (line, "bench,", 6) == 0) && (memcmp (line + 6, "path,", 5) != 0)){
+        if (!bench_line_isValid ())
+            badLines++;
+        if ((lineLen > 13) && (memcmp (line + 6, "rx_dma,", 7) == 0))
+            rxDmaLines++;
+        if ((lineLen > 15) && (memcmp (line + 6, "get_poll,", 9) == 0))
+            getPollLines++;
+        lines++;
+
+        line[lineLen++] = '\n';
+        write (STDOUT_FILENO, line, lineLen);        // async-signal-safe
+    }
+    lineLen = 0;
+}
+
+/**
+ * @brief bench_line_isValid, a result line has 8 fields and bytes_per_sec = size * SystemCoreClock / cycles_avg.
+ * @return bool
+ */
+static bool bench_line_isValid (void){
+    uint32_t values [fields];
+    uint16_t count;
+    uint8_t field = 0;
+
+    values[0] = 0;
+    for (count = 0; count < lineLen; count++){
+        if (line[count] == ','){
+            if (++field >= fields)
+                return false;
+            values[field] = 0;
+        }
+        else if ((field >= 2) && (line[count] >= '0') && (line[count] <= '9'))
+            values[field] = values[field] * 10 + (line[count] - '0');
+        else if (field >= 2)
+            return false;
+    }
+    if (field != fields - 1)
+        return false;
+
+    /* fields : bench, path, baud, size, iterations, cycles_avg, cycles_max, bytes_per_sec */
+    return values[7] == ((values[5] == 0) ? 0 : (uint32_t) ((uint64_t) values[3] * SystemCoreClock / values[5]));
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file mb1_cachecheck.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux check of MB1_Cache over MB1_AT25, against MB1_AT25Model on the host model of
+ * MBoard-1 (MB1_Host.h), with a reference image of the flash area :
+ * - counters of known sequences : misses and hits, read-ahead of sequential reads (readAheadHits),
+ *   bypass of long reads.
+ * - random reads, writes (only clearing bits, or any data : sector rewrites), flush and sync against
+ *   the reference image, reads match it, flash matches it after flush and sync, hits + misses count
+ *   every page of reads and writes.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -I. -Ihost host/mb1_cachecheck.cpp host/MB1_Host.cpp \
+ *          MB1_Cache.cpp MB1_AT25.cpp MB1_AT25Model.cpp MB1_SPI.cpp MB1_DMA.cpp -o mb1_cachecheck
+ */
+
+/* Includes */
+#include "MB1_Cache.h"
+#include "MB1_AT25Model.h"
+#include "MB1_Host.h"
+#include "stdio.h"
+
+/**< flash of 1MB on SPI1, SS line 0 on PA4 : decode value 0 */
+static uint8_t flashMem [0x100000];
+static AT25Model flashModel (flashMem, sizeof (flashMem));
+static SPI spi1 (1);
+static AT25 flash (&spi1, SPI_ns::at25Flash_1);
+
+const uint8_t check_numOfLines = 8;
+const uint32_t check_area = 0x8000;                 // 8 sectors, 128 pages
+const uint16_t check_numOfOps = 600;
+const uint16_t check_len_max = 0x800;
+
+static Cache_ns::line_s lines [check_numOfLines];
+static uint8_t sectorBuf [Cache_ns::sector_size];
+static BlockCache cache (&flash, lines, check_numOfLines, sectorBuf);
+
+static uint8_t ref [check_area];                    // what the flash area holds for users of the cache
+static uint8_t buf [check_len_max];
+static uint32_t seed = 1;
+static uint8_t failures = 0;
+
+/* Private functions */
+static void flash_cs_set (void *ctx, bool isLow);
+static uint8_t flash_transfer (void *ctx, uint8_t mosi);
+static void flash_tick_us (void *ctx, uint32_t us);
+static uint32_t check_rand (uint32_t range);
+static uint32_t check_pages (uint32_t addr, uint32_t len);
+static void check_seqRead (uint32_t firstPage, uint32_t numOfPages, Cache_ns::stats_t *stats_p);
+static void check (bool isOk, const char *name);
+static int check_run (void);
+
+static const Host_ns::spiDevice_s flashDevice = {flash_cs_set, flash_transfer, flash_tick_us, NULL, &flashModel};
+
+int main (void){
+    return host_run (check_run, 60000);
+}
+
+/**
+ * @brief check_run, checks of BlockCache (test context of host_run).
+ * @return int : 0 if all checks pass.
+ */
+static int check_run (void){
+    SPI_ns::SPI_params_t params;
+    SPI_ns::SM_GPIOParams_s ssLine;
+    Cache_ns::stats_t stats;
+    uint32_t count, index, addr, len, op, chunks, writeChunks, bypasses, flushes, syncs;
+    bool isReadOk = true;
+    bool isFlushOk = true;
+    bool isSyncOk = true;
+
+    /**< SPI1 master, 18 MHz, mode 0, one SS line */
+    params.baudRatePrescaler = SPI_BaudRatePrescaler_4;
+    params.CPHA = SPI_CPHA_1Edge;
+    params.CPOL = SPI_CPOL_Low;
+    params.crcPoly = 7;
+    params.dataSize = SPI_DataSize_8b;
+    params.direction = SPI_Direction_2Lines_FullDuplex;
+    params.firstBit = SPI_FirstBit_MSB;
+    params.mode = SPI_Mode_Master;
+    params.nss = SPI_NSS_Soft;
+
+    ssLine.GPIO_port = GPIOA;
+    ssLine.GPIO_pin = GPIO_Pin_4;
+    ssLine.GPIO_clk = RCC_APB2Periph_GPIOA;
+    ssLine.ssLine = 0;
+
+    host_spiSSLine_set (SPI1, 0, GPIOA, GPIO_Pin_4);
+    host_spiDevice_set (SPI1, 0, &flashDevice);
+
+    spi1.init (&params);
+    spi1.SM_numOfSSLines_set (1);
+    spi1.SM_GPIO_set (&ssLine);
+    spi1.SM_deviceToDecoder_set (SPI_ns::allFree, 1);
+    spi1.SM_deviceToDecoder_set (SPI_ns::at25Flash_1, 0);
+
+    host_miscTIM_set (at25_miscTIMISR, 1);
+
+    check (flash.begin () == AT25_ns::successful, "begin");
+
+    for (count = 0; count < check_area; count++)
+        ref[count] = (uint8_t) check_rand (0x100);
+    memcpy (flashMem, ref, check_area);
+
+    /**< same page twice, no read-ahead : 1 miss, 1 hit */
+    cache.stats_reset ();
+    cache.read (0x1010, buf, 0x20);
+    cache.read (0x1080, buf, 0x20);
+    cache.stats_get (&stats);
+    check ((stats.readMisses == 1) && (stats.readHits == 1) && (stats.flashReads == 1), "hit after miss");
+
+    /**< 11 sequential pages, no read-ahead : all miss */
+    cache.sync ();
+    cache.readAhead_set (0);
+    check_seqRead (20, 11, &stats);
+    check ((stats.readMisses == 11) && (stats.readHits == 0) && (stats.readAheads == 0) &&
+           (stats.readAheadHits == 0), "sequential, no read-ahead");
+
+    /**< same pages, read-ahead of 2 : first 2 pages miss, next ones are read ahead */
+    cache.sync ();
+    cache.readAhead_set (2);
+    check_seqRead (20, 11, &stats);
+    printf ("read-ahead : %lu misses, %lu hits, %lu pages ahead, %lu used\n", (unsigned long) stats.readMisses,
+            (unsigned long) stats.readHits, (unsigned long) stats.readAheads, (unsigned long) stats.readAheadHits);
+    check ((stats.readMisses == 2) && (stats.readHits == 9) && (stats.readAheadHits == 9), "sequential, read-ahead 2");
+    check (stats.readAheads == 11, "pages read ahead");
+    check (memcmp (buf, &ref[30 * Cache_ns::line_size], Cache_ns::line_size) == 0, "read-ahead data");
+
+    /**< long read : one command, newer data of a dirty line over it */
+    cache.sync ();
+    cache.stats_reset ();
+    memset (&ref[0x2100], 0x00, 0x10);
+    cache.write (0x2100, &ref[0x2100], 0x10);
+    cache.read (0x2000, buf, 0x400);
+    cache.stats_get (&stats);
+    check ((stats.bypassReads == 1) && (stats.readMisses == 0) && (stats.readHits == 0) &&
+           (memcmp (buf, &ref[0x2000], 0x400) == 0), "long read bypass");
+
+    /**< random reads, writes, flush and sync against ref */
+    cache.sync ();
+    cache.readAhead_set (2);
+    cache.stats_reset ();
+    flashModel.stats_reset ();
+    chunks = 0;
+    writeChunks = 0;
+    bypasses = 0;
+    flushes = 0;
+    syncs = 0;
+    for (count = 0; count < check_numOfOps; count++){
+        op = check_rand (16);
+
+        if (op < 6){
+            /* short read */
+            len = 1 + check_rand (2 * Cache_ns::line_size - 1);
+            addr = check_rand (check_area - len);
+            isReadOk &= (cache.read (addr, buf, len) == Cache_ns::successful) && (memcmp (buf, &ref[addr], len) == 0);
+            chunks += check_pages (addr, len);
+        }
+        else if (op < 7){
+            /* long read */
+            len = 2 * Cache_ns::line_size + check_rand (check_len_max - 2 * Cache_ns::line_size);
+            addr = check_rand (check_area - len);
+            isReadOk &= (cache.read (addr, buf, len) == Cache_ns::successful) && (memcmp (buf, &ref[addr], len) == 0);
+            bypasses++;
+        }
+        else if (op < 9){
+            /* sequential pages */
+            addr = check_rand (check_area / Cache_ns::line_size - 8) * Cache_ns::line_size + check_rand (16);
+            for (len = 4 + check_rand (5); len > 0; len--, addr += Cache_ns::line_size){
+                isReadOk &= (cache.read (addr, buf, Cache_ns::line_size) == Cache_ns::successful) &&
+                            (memcmp (buf, &ref[addr], Cache_ns::line_size) == 0);
+                chunks += check_pages (addr, Cache_ns::line_size);
+            }
+        }
+        else if (op < 14){
+            /* write, mostly clearing bits (page program), else any data (sector rewrite) */
+            len = 1 + check_rand (300);
+            addr = check_rand (check_area - len);
+            for (index = 0; index < len; index++)
+                buf[index] = (check_rand (8) == 0) ? (uint8_t) check_rand (0x100) :
+                             ref[addr + index] & (uint8_t) check_rand (0x100);
+            memcpy (&ref[addr], buf, len);
+            isReadOk &= (cache.write (addr, buf, len) == Cache_ns::successful);
+            writeChunks += check_pages (addr, len);
+        }
+        else if (op < 15){
+            isFlushOk &= (cache.flush () == Cache_ns::successful) && (memcmp (flashMem, ref, check_area) == 0);
+            flushes++;
+        }
+        else {
+            isSyncOk &= (cache.sync () == Cache_ns::successful) && (memcmp (flashMem, ref, check_area) == 0);
+            syncs++;
+        }
+    }
+    isSyncOk &= (cache.sync () == Cache_ns::successful) && (memcmp (flashMem, ref, check_area) == 0);
+
+    cache.stats_get (&stats);
+    printf ("random : %lu read hits, %lu read misses, %lu write hits, %lu write misses, %lu ahead, %lu used\n",
+            (unsigned long) stats.readHits, (unsigned long) stats.readMisses, (unsigned long) stats.writeHits,
+            (unsigned long) stats.writeMisses, (unsigned long) stats.readAheads, (unsigned long) stats.readAheadHits);
+    printf ("random : %lu flushes, %lu syncs, %lu write-backs, %lu sector rewrites\n", (unsigned long) flushes,
+            (unsigned long) syncs, (unsigned long) stats.writeBacks, (unsigned long) stats.sectorRewrites);
+    check (isReadOk, "random reads and writes");
+    check (isFlushOk, "flash after flush");
+    check (isSyncOk, "flash after sync");
+    check ((stats.readHits + stats.readMisses == chunks) && (stats.writeHits + stats.writeMisses == writeChunks),
+           "hits and misses count pages");
+    check ((stats.readHits > 0) && (stats.readMisses > 0) && (stats.writeHits > 0) && (stats.writeMisses > 0),
+           "hits and misses");
+    check ((stats.readAheadHits > 0) && (stats.readAheadHits <= stats.readAheads), "read-ahead hits");
+    check (stats.bypassReads == bypasses, "bypass reads");
+    check (stats.sectorRewrites > 0, "sector rewrites");
+
+    printf ("%s, %u failure(s), %lu ms simulated\n", (failures == 0) ? "PASS" : "FAIL", failures,
+            (unsigned long) (host_ns_get () / 1000000));
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief check_rand, pseudo-random number (fixed seed, runs are the same).
+ * @return uint32_t : 0 to range - 1.
+ */
+static uint32_t check_rand (uint32_t range){
+    seed = seed * 1103515245 + 12345;
+
+    return (seed >> 8) % range;
+}
+
+/**
+ * @brief check_pages, pages (cache lines) touched by a range.
+ * @return uint32_t
+ */
+static uint32_t check_pages (uint32_t addr, uint32_t len){
+    return (addr + len - 1) / Cache_ns::line_size - addr / Cache_ns::line_size + 1;
+}
+
+/**
+ * @brief check_seqRead, read pages one by one, stats of these reads (read-ahead has ended).
+ * @return None
+ */
+static void check_seqRead (uint32_t firstPage, uint32_t numOfPages, Cache_ns::stats_t *stats_p){
+    uint32_t page;
+
+    cache.stats_reset ();
+    for (page = firstPage; page < firstPage + numOfPages; page++)
+        cache.read (page * Cache_ns::line_size, buf, Cache_ns::line_size);
+    cache.sync ();
+    cache.stats_get (stats_p);
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
+
+/**< AT25Model on the SPI model */
+static void flash_cs_set (void *ctx, bool isLow){
+    ((AT25Model *) ctx)->cs_set (isLow);
+}
+
+static uint8_t flash_transfer (void *ctx, uint8_t mosi){
+    return ((AT25Model *) ctx)->transfer (mosi);
+}
+
+static void flash_tick_us (void *ctx, uint32_t us){
+    ((AT25Model *) ctx)->tick_us (us);
+}
@@ -0,0 +1,312 @@
+/**
+ * @file mb1_cc2530check.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux check of MB1_CC2530 over SPI, DMA and EXTI on MISO, against MB1_CC2530Model
+ * on the host model of MBoard-1 (MB1_Host.h) :
+ * - frames sent while the radio wakes up go in one window (one DMA transfer).
+ * - frames from the radio are polled until it has nothing left, rx_p answers with frame_send.
+ * - EXTI9_5_IRQHandler of the check calls CC2530_EXTI_dispatch, another line of this IRQ is left
+ *   to the handler.
+ * - idle poll and ready timeout keep their time in ms when miscTIM_period is not 1 ms.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -std=gnu++98 -fpermissive -no-pie -I. -Ihost host/mb1_cc2530check.cpp host/MB1_Host.cpp \
+ *          MB1_CC2530.cpp MB1_CC2530Model.cpp MB1_SPI.cpp MB1_DMA.cpp -o mb1_cc2530check
+ */
+
+/* Includes */
+#include "MB1_CC2530.h"
+#include "MB1_CC2530Model.h"
+#include "MB1_Host.h"
+#include "stdio.h"
+
+/**< radio on SPI1, SS line 0 on PA4 : decode value 0 selects it */
+static CC2530Model radioModel (200);
+static SPI spi1 (1);
+static CC2530 radio (&spi1, SPI_ns::cc2530_1);
+
+const uint8_t check_frames = 5;
+const uint8_t check_rxFrames = 3;
+const uint8_t check_echo = 0x40;        // cmd0 of the answer to a received frame
+const uint32_t check_otherLine = 0x0100;    // EXTI8, another device on EXTI9_5_IRQn
+
+static CC2530Model_ns::frame_s rxFrames [check_rxFrames];
+static volatile uint8_t rxCount = 0;
+static volatile uint8_t otherLineCount = 0;
+static uint8_t failures = 0;
+
+/* Private functions */
+static void radio_cs_set (void *ctx, bool isLow);
+static uint8_t radio_transfer (void *ctx, uint8_t mosi);
+static void radio_tick_us (void *ctx, uint32_t us);
+static bool radio_so_get (void *ctx);
+static void silent_cs_set (void *ctx, bool isLow);
+static uint8_t silent_transfer (void *ctx, uint8_t mosi);
+static void check_rx (void *arg, uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len);
+static void check_frame_fill (CC2530Model_ns::frame_s *frame_p, uint8_t index);
+static bool check_frame_isSame (const CC2530Model_ns::frame_s *a_p, const CC2530Model_ns::frame_s *b_p);
+static void check_idleWait (void);
+static void check (bool isOk, const char *name);
+static int check_run (void);
+
+extern "C" {
+void EXTI9_5_IRQHandler (void);
+}
+
+static const Host_ns::spiDevice_s radioDevice = {radio_cs_set, radio_transfer, radio_tick_us, radio_so_get,
+                                                 &radioModel};
+static const Host_ns::spiDevice_s silentDevice = {silent_cs_set, silent_transfer, NULL, NULL, NULL};
+
+int main (void){
+    return host_run (check_run, 10000);
+}
+
+/**
+ * @brief check_run, checks of CC2530 (test context of host_run).
+ * @return int : 0 if all checks pass.
+ */
+static int check_run (void){
+    SPI_ns::SPI_params_t params;
+    SPI_ns::SM_GPIOParams_s ssLine;
+    CC2530_ns::stats_t stats;
+    CC2530Model_ns::stats_t modelStats;
+    CC2530Model_ns::frame_s frame, expected;
+    uint8_t count, popped;
+    bool isOk;
+
+    /**< SPI1 master, 4.5 MHz, mode 0, one SS line */
+    params.baudRatePrescaler = SPI_BaudRatePrescaler_16;
+    params.CPHA = SPI_CPHA_1Edge;
+    params.CPOL = SPI_CPOL_Low;
+    params.crcPoly = 7;
+    params.dataSize = SPI_DataSize_8b;
+    params.direction = SPI_Direction_2Lines_FullDuplex;
+    params.firstBit = SPI_FirstBit_MSB;
+    params.mode = SPI_Mode_Master;
+    params.nss = SPI_NSS_Soft;
+
+    ssLine.GPIO_port = GPIOA;
+    ssLine.GPIO_pin = GPIO_Pin_4;
+    ssLine.GPIO_clk = RCC_APB2Periph_GPIOA;
+    ssLine.ssLine = 0;
+
+    host_spiSSLine_set (SPI1, 0, GPIOA, GPIO_Pin_4);
+    host_spiDevice_set (SPI1, 0, &radioDevice);
+
+    spi1.init (&params);
+    spi1.SM_numOfSSLines_set (1);
+    spi1.SM_GPIO_set (&ssLine);
+    spi1.SM_deviceToDecoder_set (SPI_ns::allFree, 1);
+    spi1.SM_deviceToDecoder_set (SPI_ns::cc2530_1, 0);
+
+    host_miscTIM_set (cc2530_miscTIMISR, 1);
+
+    check (radio.begin (check_rx, NULL) == CC2530_ns::successful, "begin");
+
+    /**< batch : frames queued while the radio wakes up go in one window */
+    check_idleWait ();
+    __disable_irq();
+    radioModel.stats_reset ();
+    radio.stats_reset ();
+    isOk = true;
+    for (count = 0; count < check_frames; count++){
+        check_frame_fill (&frame, count);
+        isOk &= (radio.frame_send (frame.cmd0, frame.cmd1, frame.data, frame.len) == CC2530_ns::successful);
+    }
+    __enable_irq();
+    check (isOk, "batch frame_send");
+    check_idleWait ();
+
+    __disable_irq();
+    radioModel.stats_get (&modelStats);
+    isOk = true;
+    for (count = 0; count < check_frames; count++){
+        check_frame_fill (&expected, count);
+        isOk &= radioModel.tx_pop (&frame) && check_frame_isSame (&frame, &expected);
+    }
+    isOk &= !radioModel.tx_pop (&frame);
+    __enable_irq();
+    radio.stats_get (&stats);
+    check (isOk, "batch frames at the radio");
+    check ((modelStats.maxFramesPerWindow == check_frames) && (stats.framesPerWindow_max == check_frames),
+           "batch in one window");
+
+    /**< rx : polls until the radio has nothing left, each frame is answered by rx_p */
+    __disable_irq();
+    for (count = 0; count < check_rxFrames; count++){
+        check_frame_fill (&frame, check_frames + count);
+        radioModel.rx_push (frame.cmd0, frame.cmd1, frame.data, frame.len);
+    }
+    __enable_irq();
+    radio.rx_check ();
+    while (rxCount < check_rxFrames);
+    delay_ms (2);
+    check_idleWait ();
+
+    isOk = true;
+    for (count = 0; count < check_rxFrames; count++){
+        check_frame_fill (&expected, check_frames + count);
+        isOk &= check_frame_isSame (&rxFrames[count], &expected);
+    }
+    check (isOk, "rx frames");
+
+    __disable_irq();
+    popped = 0;
+    isOk = true;
+    while (radioModel.tx_pop (&frame)){
+        check_frame_fill (&expected, check_frames + popped);
+        expected.cmd0 |= check_echo;
+        isOk &= (popped < check_rxFrames) && check_frame_isSame (&frame, &expected);
+        popped++;
+    }
+    isOk &= (popped == check_rxFrames) && (radioModel.rx_pending () == 0);
+    radioModel.stats_get (&modelStats);
+    __enable_irq();
+    radio.stats_get (&stats);
+    check (isOk, "rx round trip");
+    check ((stats.framesSent == check_frames + check_rxFrames) && (stats.framesReceived == check_rxFrames),
+           "driver frame counts");
+    check ((modelStats.errors == 0) && (modelStats.notReady == 0), "no partial or early bytes");
+    check ((stats.readyTimeouts == 0) && (stats.rxDropped == 0), "no timeout or drop");
+
+    /**< edge of another device on EXTI9_5 : the driver leaves it to the handler */
+    check_idleWait ();
+    __disable_irq();
+    EXTI->IMR |= check_otherLine;
+    EXTI->PR.value |= check_otherLine;
+    __enable_irq();
+    delay_ms (1);
+    check ((otherLineCount == 1) && ((EXTI->PR & check_otherLine) == 0), "other EXTI9_5 line");
+    EXTI->IMR &= ~check_otherLine;
+
+    /**< misc timer of 5 ms : idle poll every idlePoll_ms */
+    host_miscTIM_set (cc2530_miscTIMISR, 5);
+    check_idleWait ();
+    radio.stats_reset ();
+    delay_ms (500);
+    radio.stats_get (&stats);
+    printf ("idle windows in 500 ms : %lu\n", (unsigned long) stats.windows);
+    check ((stats.windows + 1 >= 500 / CC2530_ns::idlePoll_ms) && (stats.windows <= 500 / CC2530_ns::idlePoll_ms + 1),
+           "idle poll period");
+
+    /**< radio doesn't answer : a window times out after readyTimeout_ms, then opens again */
+    check_idleWait ();
+    __disable_irq();
+    host_spiDevice_set (SPI1, 0, &silentDevice);
+    radio.stats_reset ();
+    __enable_irq();
+    delay_ms (300);
+    radio.stats_get (&stats);
+    printf ("ready timeouts in 300 ms : %lu\n", (unsigned long) stats.readyTimeouts);
+    check ((stats.readyTimeouts >= 300 / (CC2530_ns::readyTimeout_ms + 5)) &&
+           (stats.readyTimeouts <= 300 / CC2530_ns::readyTimeout_ms + 1), "ready timeout");
+
+    printf ("%s, %u failure(s), %lu ms simulated\n", (failures == 0) ? "PASS" : "FAIL", failures,
+            (unsigned long) (host_ns_get () / 1000000));
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief EXTI9_5_IRQHandler, MISO of SPI1 (PA6) for the CC2530s, check_otherLine for another device.
+ * @return None
+ */
+void EXTI9_5_IRQHandler (void){
+    CC2530_EXTI_dispatch ();
+
+    if ((EXTI->PR & check_otherLine) != 0){
+        EXTI->PR = check_otherLine;
+        otherLineCount++;
+    }
+}
+
+/**
+ * @brief check_rx, rx_p of the radio, keeps the frame and answers it (DMA ISR context).
+ * @return None
+ */
+static void check_rx (void *arg, uint8_t cmd0, uint8_t cmd1, const uint8_t *data, uint8_t len){
+    (void) arg;
+
+    if (rxCount < check_rxFrames){
+        rxFrames[rxCount].len = len;
+        rxFrames[rxCount].cmd0 = cmd0;
+        rxFrames[rxCount].cmd1 = cmd1;
+        memcpy (rxFrames[rxCount].data, data, len);
+        rxCount++;
+    }
+
+    radio.frame_send (cmd0 | check_echo, cmd1, data, len);
+}
+
+/**
+ * @brief check_frame_fill, frame of an index : len, commands and data differ.
+ * @return None
+ */
+static void check_frame_fill (CC2530Model_ns::frame_s *frame_p, uint8_t index){
+    uint8_t count;
+
+    frame_p->len = (uint8_t) (1 + (index * 13) % CC2530_ns::dataLen_max);
+    frame_p->cmd0 = (uint8_t) (0x21 + index);
+    frame_p->cmd1 = (uint8_t) (0x80 | index);
+    for (count = 0; count < frame_p->len; count++)
+        frame_p->data[count] = (uint8_t) (index * 31 + count);
+}
+
+/**
+ * @brief check_frame_isSame
+ * @return bool
+ */
+static bool check_frame_isSame (const CC2530Model_ns::frame_s *a_p, const CC2530Model_ns::frame_s *b_p){
+    return (a_p->len == b_p->len) && (a_p->cmd0 == b_p->cmd0) && (a_p->cmd1 == b_p->cmd1) &&
+           (memcmp (a_p->data, b_p->data, a_p->len) == 0);
+}
+
+/**
+ * @brief check_idleWait, wait until no window is open.
+ * @return None
+ */
+static void check_idleWait (void){
+    while (!radio.isIdle ());
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
+
+/**< radio device on the model of SPI1 */
+static void radio_cs_set (void *ctx, bool isLow){
+    ((CC2530Model *) ctx)->cs_set (isLow);
+}
+
+static uint8_t radio_transfer (void *ctx, uint8_t mosi){
+    return ((CC2530Model *) ctx)->transfer (mosi);
+}
+
+static void radio_tick_us (void *ctx, uint32_t us){
+    ((CC2530Model *) ctx)->tick_us (us);
+}
+
+static bool radio_so_get (void *ctx){
+    return ((CC2530Model *) ctx)->so_get ();
+}
+
+/**< radio which never wakes up : SO stays high */
+static void silent_cs_set (void *ctx, bool isLow){
+    (void) ctx;
+    (void) isLow;
+}
+
+static uint8_t silent_transfer (void *ctx, uint8_t mosi){
+    (void) ctx;
+    (void) mosi;
+
+    return 0xFF;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file mb1_kvbench.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux tool, kv_bench (MB1_KvBench.h) : key-value store against read-modify-erase-write
+ * on the AT25 model, time is simulated by the bench. Result lines ("kvbench,...") go to stdout.
+ * Checks of the run :
+ * - a header line and one result line per store and value size, each of 10 fields.
+ * - the key-value store programs fewer bytes and erases less than rmw for each value size.
+ * Exit code is 0 if all checks pass.
+ * Build (from the root of the libs) :
+ *      g++ -Wall -Wextra -I. host/mb1_kvbench.cpp MB1_KvBench.cpp MB1_Kv.cpp MB1_AT25Model.cpp \
+ *          MB1_Cobs.cpp MB1_Format.cpp -o mb1_kvbench
+ */
+
+/* Includes */
+#include "MB1_KvBench.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+const uint8_t fields = 10;                  // "kvbench" and 9 columns
+
+typedef struct {
+    uint16_t lines;
+    uint16_t badLines;
+    uint32_t writeAmp_x100 [2][KvBench_ns::numOfSizes];     // kv, rmw
+    uint32_t erases [2][KvBench_ns::numOfSizes];
+} kvbench_run_s;
+
+static uint8_t failures = 0;
+
+/* Private functions */
+static void kvbench_line (void *ctx, const char *line);
+static bool kvbench_line_parse (kvbench_run_s *run_p, const char *line);
+static void check (bool isOk, const char *name);
+
+int main (void){
+    kvbench_run_s run;
+    bool isLess = true;
+    uint8_t count;
+
+    memset (&run, 0, sizeof (run));
+    kv_bench (kvbench_line, &run);
+
+    for (count = 0; count < KvBench_ns::numOfSizes; count++){
+        isLess &= (run.writeAmp_x100[0][count] < run.writeAmp_x100[1][count]) &&
+                  (run.erases[0][count] < run.erases[1][count]);
+    }
+
+    check ((run.lines == 1 + 2 * KvBench_ns::numOfSizes) && (run.badLines == 0), "lines are complete");
+    check (isLess, "kv below rmw");
+
+    printf ("%s, %u failure(s)\n", (failures == 0) ? "PASS" : "FAIL", failures);
+
+    return (failures == 0) ? 0 : 1;
+}
+
+/**
+ * @brief kvbench_line, KvBench_ns::line_t, prints a line and keeps its results.
+ * @param void *ctx : kvbench_run_s.
+ * @return None
+ */
+static void kvbench_line (void *ctx, const char *line){
+    kvbench_run_s *run_p = (kvbench_run_s *) ctx;
+
+    printf ("%s\n", line);
+
+    if (!kvbench_line_parse (run_p, line))
+        run_p->badLines++;
+    run_p->lines++;
+}
+
+/**
+ * @brief kvbench_line_parse, fields of a line : kvbench, store, value_size, updates, lat_avg_us,
+ * lat_max_us, write_amp, erases, erase_min, erase_max.
+ * @return bool : false if the line is broken.
+ */
+static bool kvbench_line_parse (kvbench_run_s *run_p, const char *line){
+    char copy [KvBench_ns::line_size];
+    char *field_p [fields];
+    char *next_p;
+    uint8_t count = 0;
+    uint8_t store, size;
+
+    if (strlen (line) >= sizeof (copy))
+        return false;
+    strcpy (copy, line);
+
+    next_p = copy;
+    while ((next_p != NULL) && (count < fields)){
+        field_p[count++] = next_p;
+        next_p = strchr (next_p, ',');
+        if (next_p != NULL)
+            *next_p++ = 0;
+    }
+    if ((count != fields) || (next_p != NULL) || (strcmp (field_p[0], "kvbench") != 0))
+        return false;
+
+    if (strcmp (field_p[1], "store") == 0)
+        return run_p->lines == 0;
+
+    if (strcmp (field_p[1], "kv") == 0)
+        store = 0;
+    else if (strcmp (field_p[1], "rmw") == 0)
+        store = 1;
+    else
+        return false;
+
+    for (size = 0; size < KvBench_ns::numOfSizes; size++){
+        if (strtoul (field_p[2], NULL, 10) == KvBench_ns::sizes[size])
+            break;
+    }
+    if ((size == KvBench_ns::numOfSizes) || (strtoul (field_p[3], NULL, 10) != KvBench_ns::updates))
+        return false;
+
+    run_p->writeAmp_x100[store][size] = (uint32_t) (strtod (field_p[6], NULL) * 100 + 0.5);
+    run_p->erases[store][size] = strtoul (field_p[7], NULL, 10);
+
+    return true;
+}
+
+/**
+ * @brief check, print the result of a check.
+ * @return None
+ */
+static void check (bool isOk, const char *name){
+    printf ("%-28s %s\n", name, isOk ? "ok" : "FAIL");
+    if (!isOk)
+        failures++;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file mb1_logdecode.cpp
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Linux tool, decodes a capture of MB1_LOG records to text (see MB1_LogDecode.h).
+ * Usage :
+ *      mb1_logdecode firmware.elf [capture.bin]        capture from stdin if not given
+ *      stty -F /dev/ttyUSB0 115200 raw; mb1_logdecode firmware.elf < /dev/ttyUSB0
+ * The first file is the firmware ELF, or a raw dump of section mb1_log_fmt :
+ *      arm-none-eabi-objcopy -O binary -j mb1_log_fmt --set-section-flags mb1_log_fmt=alloc,load \
+ *          firmware.elf log_fmt.bin
+ * Build (from the root of the libs) :
+ *      g++ -I. host/mb1_logdecode.cpp MB1_LogDecode.cpp MB1_Log.cpp MB1_Cobs.cpp MB1_Format.cpp -o mb1_logdecode
+ */
+
+/* Includes */
+#include "MB1_LogDecode.h"
+#include "stdio.h"
+#include "stdlib.h"
+
+/* Private functions */
+static uint8_t *logdecode_file_read (const char *path, uint32_t *len_p);
+static void logdecode_line (void *ctx, const char *line);
+
+int main (int argc, char *argv[]){
+    LogDecoder decoder (logdecode_line, stdout);
+    uint8_t *fmtFile;
+    uint32_t fmtLen, offset, size;
+    uint8_t buf [256];
+    size_t got;
+    FILE *capture = stdin;
+
+    if ((argc < 2) || (argc > 3)){
+        fprintf (stderr, "usage : %s firmware.elf|log_fmt.bin [capture.bin]\n", argv[0]);
+        return 2;
+    }
+
+    fmtFile = logdecode_file_read (argv[1], &fmtLen);
+    if (fmtFile == NULL){
+        fprintf (stderr, "%s : can't read\n", argv[1]);
+        return 1;
+    }
+
+    /* ELF file, or raw dump of the section */
+    if (logDec_elfSection_find (fmtFile, fmtLen, LogDec_ns::sectionName, &offset, &size) != LogDec_ns::successful){
+        offset = 0;
+        size = fmtLen;
+    }
+    if (decoder.fmt_set ((const char *) &fmtFile[offset], size) != LogDec_ns::successful){
+        fprintf (stderr, "%s : no %s section (tag %s)\n", argv[1], LogDec_ns::sectionName, Log_ns::sectionTag);
+        return 1;
+    }
+
+    if (argc == 3){
+        capture = fopen (argv[2], "rb");
+        if (capture == NULL){
+            fprintf (stderr, "%s : can't open\n", argv[2]);
+            return 1;
+        }
+    }
+
+    while ((got = fread (buf, 1, sizeof (buf), capture)) > 0){
+        decoder.data_put (buf, got);
+        fflush (stdout);
+    }
+
+    fprintf (stderr, "records : %u, errors : %u\n", (unsigned) decoder.records_get (), (unsigned) decoder.errors_get ());
+    free (fmtFile);
+
+    return (decoder.errors_get () == 0) ? 0 : 1;
+}
+
+/**
+ * @brief logdecode_file_read, whole file to a new buffer.
+ * @return uint8_t *, NULL if failed.
+ */
+static uint8_t *logdecode_file_read (const char *path, uint32_t *len_p){
+    FILE *file = fopen (path, "rb");
+    uint8_t *buf;
+    long len;
+
+    if (file == NULL)
+        return NULL;
+
+    fseek (file, 0, SEEK_END);
+    len = ftell (file);
+    fseek (file, 0, SEEK_SET);
+
+    buf = (uint8_t *) malloc ((len > 0) ? len : 1);
+    if ((buf != NULL) && (fread (buf, 1, len, file) != (size_t) len)){
+        free (buf);
+        buf = NULL;
+    }
+    fclose (file);
+
+    *len_p = (uint32_t) len;
+    return buf;
+}
+
+/**
+ * @brief logdecode_line
+ * @param void *ctx : FILE *.
+ */
+static void logdecode_line (void *ctx, const char *line){
+    fprintf ((FILE *) ctx, "%s\n", line);
+}
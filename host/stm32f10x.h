@@ -0,0 +1,524 @@
+/**
+ * @file stm32f10x.h
+ * @author  Pham Huu Dang Nhat  <phamhuudangnhat@gmail.com>, HLib MBoard team.
+ * @version 1.0
+ * @date 18-10-2026
+ * @brief Host stand-in of the StdPeriph entry-point, for host checks of the drivers on Linux.
+ * Only the part of StdPeriph used by MB1 libs is here, with the same names and values.
+ * - Registers are HostReg : plain memory, or a read/write hook set by MB1_Host.cpp for registers
+ *   with side effects (BSRR/BRR drive pins, PR and IFCR are write-1-to-clear ...).
+ * - Peripherals are objects of MB1_Host.cpp, functions of StdPeriph are implemented there too.
+ * - PRIMASK is a flag, interrupts are the ticks of MB1_Host (SIGALRM), they wait while it's set.
+ * Put host/ in the include path (-Ihost) instead of StdPeriph, see MB1_Host.h.
+ */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+/* Includes */
+#include "stdint.h"
+#include "stddef.h"
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+/**< register, reads and writes go through hooks if they are set */
+template <typename T>
+class HostReg {
+public:
+    volatile T value;
+    T (* read_p) (HostReg<T> *reg_p);                   // NULL : value is read
+    void (* write_p) (HostReg<T> *reg_p, T newValue);   // NULL : value is written
+
+    operator T (void){
+        return (read_p != NULL) ? read_p (this) : value;
+    }
+    HostReg<T> & operator= (T newValue){
+        if (write_p != NULL)
+            write_p (this, newValue);
+        else
+            value = newValue;
+        return *this;
+    }
+    HostReg<T> & operator|= (T bits){
+        return operator= ((T) (operator T () | bits));
+    }
+    HostReg<T> & operator&= (T bits){
+        return operator= ((T) (operator T () & bits));
+    }
+};
+
+/**< peripherals */
+typedef struct {
+    HostReg<uint32_t> CRL, CRH, IDR, ODR, BSRR, BRR, LCKR;
+} GPIO_TypeDef;
+
+typedef struct {
+    HostReg<uint16_t> SR, DR, BRR, CR1, CR2, CR3, GTPR;
+} USART_TypeDef;
+
+typedef struct {
+    HostReg<uint16_t> CR1, CR2, SR, DR, CRCPR, RXCRCR, TXCRCR, I2SCFGR, I2SPR;
+} SPI_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR;
+} TIM_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> DR;
+    HostReg<uint8_t> IDR;
+    HostReg<uint32_t> CR;
+} CRC_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> CR, CFGR, CIR, APB2RSTR, APB1RSTR, AHBENR, APB2ENR, APB1ENR, BDCR, CSR;
+} RCC_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> CCR, CNDTR, CPAR, CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> ISR, IFCR;
+} DMA_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> IMR, EMR, RTSR, FTSR, SWIER, PR;
+} EXTI_TypeDef;
+
+typedef struct {
+    HostReg<uint32_t> DHCSR, DCRSR, DCRDR, DEMCR;
+} CoreDebug_Type;
+
+extern GPIO_TypeDef host_GPIOA, host_GPIOB, host_GPIOC, host_GPIOD;
+extern USART_TypeDef host_USART1, host_USART2, host_USART3, host_UART4, host_UART5;
+extern SPI_TypeDef host_SPI1, host_SPI2;
+extern TIM_TypeDef host_TIM6, host_TIM7;
+extern CRC_TypeDef host_CRC;
+extern RCC_TypeDef host_RCC;
+extern DMA_TypeDef host_DMA1, host_DMA2;
+extern DMA_Channel_TypeDef host_DMA1_Channels [7], host_DMA2_Channels [5];
+extern EXTI_TypeDef host_EXTI;
+extern CoreDebug_Type host_CoreDebug;
+
+#define GPIOA               (&host_GPIOA)
+#define GPIOB               (&host_GPIOB)
+#define GPIOC               (&host_GPIOC)
+#define GPIOD               (&host_GPIOD)
+#define USART1              (&host_USART1)
+#define USART2              (&host_USART2)
+#define USART3              (&host_USART3)
+#define UART4               (&host_UART4)
+#define UART5               (&host_UART5)
+#define SPI1                (&host_SPI1)
+#define SPI2                (&host_SPI2)
+#define TIM6                (&host_TIM6)
+#define TIM7                (&host_TIM7)
+#define CRC                 (&host_CRC)
+#define RCC                 (&host_RCC)
+#define DMA1                (&host_DMA1)
+#define DMA2                (&host_DMA2)
+#define DMA1_Channel1       (&host_DMA1_Channels[0])
+#define DMA1_Channel2       (&host_DMA1_Channels[1])
+#define DMA1_Channel3       (&host_DMA1_Channels[2])
+#define DMA1_Channel4       (&host_DMA1_Channels[3])
+#define DMA1_Channel5       (&host_DMA1_Channels[4])
+#define DMA1_Channel6       (&host_DMA1_Channels[5])
+#define DMA1_Channel7       (&host_DMA1_Channels[6])
+#define DMA2_Channel1       (&host_DMA2_Channels[0])
+#define DMA2_Channel2       (&host_DMA2_Channels[1])
+#define DMA2_Channel3       (&host_DMA2_Channels[2])
+#define DMA2_Channel4       (&host_DMA2_Channels[3])
+#define DMA2_Channel5       (&host_DMA2_Channels[4])
+#define EXTI                (&host_EXTI)
+#define CoreDebug           (&host_CoreDebug)
+
+#define CoreDebug_DEMCR_TRCENA_Msk      ((uint32_t) 0x01000000)
+
+typedef enum {
+    EXTI0_IRQn = 6, EXTI1_IRQn, EXTI2_IRQn, EXTI3_IRQn, EXTI4_IRQn,
+    DMA1_Channel1_IRQn = 11, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+    DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+    EXTI9_5_IRQn = 23,
+    SPI1_IRQn = 35, SPI2_IRQn,
+    USART1_IRQn = 37, USART2_IRQn, USART3_IRQn,
+    EXTI15_10_IRQn = 40,
+    UART4_IRQn = 52, UART5_IRQn,
+    TIM6_IRQn = 54, TIM7_IRQn,
+    DMA2_Channel1_IRQn = 56, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_5_IRQn,
+    host_numOfIRQns
+} IRQn_Type;
+
+/**< Cortex-M3 core */
+extern volatile uint32_t host_primask;
+extern volatile uint32_t host_irqPending;
+extern uint32_t SystemCoreClock;
+
+void host_irq_run (void);
+void host_wfi (void);
+
+static inline uint32_t __get_PRIMASK (void){
+    return host_primask;
+}
+
+static inline void __set_PRIMASK (uint32_t priMask){
+    __asm__ __volatile__ ("" ::: "memory");
+    host_primask = priMask;
+    if ((priMask == 0) && (host_irqPending != 0))
+        host_irq_run ();
+}
+
+static inline void __disable_irq (void){
+    host_primask = 1;
+    __asm__ __volatile__ ("" ::: "memory");
+}
+
+static inline void __enable_irq (void){
+    __set_PRIMASK (0);
+}
+
+static inline void __DSB (void){
+    __asm__ __volatile__ ("" ::: "memory");
+}
+
+static inline void __NOP (void){
+}
+
+static inline void __WFI (void){
+    host_wfi ();
+}
+
+/**< GPIO */
+#define GPIO_Pin_0                  ((uint16_t) 0x0001)
+#define GPIO_Pin_1                  ((uint16_t) 0x0002)
+#define GPIO_Pin_2                  ((uint16_t) 0x0004)
+#define GPIO_Pin_3                  ((uint16_t) 0x0008)
+#define GPIO_Pin_4                  ((uint16_t) 0x0010)
+#define GPIO_Pin_5                  ((uint16_t) 0x0020)
+#define GPIO_Pin_6                  ((uint16_t) 0x0040)
+#define GPIO_Pin_7                  ((uint16_t) 0x0080)
+#define GPIO_Pin_8                  ((uint16_t) 0x0100)
+#define GPIO_Pin_9                  ((uint16_t) 0x0200)
+#define GPIO_Pin_10                 ((uint16_t) 0x0400)
+#define GPIO_Pin_11                 ((uint16_t) 0x0800)
+#define GPIO_Pin_12                 ((uint16_t) 0x1000)
+#define GPIO_Pin_13                 ((uint16_t) 0x2000)
+#define GPIO_Pin_14                 ((uint16_t) 0x4000)
+#define GPIO_Pin_15                 ((uint16_t) 0x8000)
+
+typedef enum {GPIO_Speed_10MHz = 1, GPIO_Speed_2MHz, GPIO_Speed_50MHz} GPIOSpeed_TypeDef;
+typedef enum {
+    GPIO_Mode_AIN = 0x00, GPIO_Mode_IN_FLOATING = 0x04, GPIO_Mode_IPD = 0x28, GPIO_Mode_IPU = 0x48,
+    GPIO_Mode_Out_OD = 0x14, GPIO_Mode_Out_PP = 0x10, GPIO_Mode_AF_OD = 0x1C, GPIO_Mode_AF_PP = 0x18
+} GPIOMode_TypeDef;
+
+typedef struct {
+    uint16_t GPIO_Pin;
+    GPIOSpeed_TypeDef GPIO_Speed;
+    GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+#define GPIO_PortSourceGPIOA        ((uint8_t) 0x00)
+#define GPIO_PortSourceGPIOB        ((uint8_t) 0x01)
+#define GPIO_PortSourceGPIOC        ((uint8_t) 0x02)
+#define GPIO_PortSourceGPIOD        ((uint8_t) 0x03)
+#define GPIO_PinSource0             ((uint8_t) 0x00)
+#define GPIO_Remap_SWJ_NoJTRST      ((uint32_t) 0x00300100)
+
+void GPIO_Init (GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+void GPIO_SetBits (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void GPIO_ResetBits (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+uint8_t GPIO_ReadInputDataBit (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+uint8_t GPIO_ReadOutputDataBit (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void GPIO_PinRemapConfig (uint32_t GPIO_Remap, FunctionalState NewState);
+void GPIO_EXTILineConfig (uint8_t GPIO_PortSource, uint8_t GPIO_PinSource);
+
+/**< RCC */
+#define RCC_APB2Periph_AFIO         ((uint32_t) 0x00000001)
+#define RCC_APB2Periph_GPIOA        ((uint32_t) 0x00000004)
+#define RCC_APB2Periph_GPIOB        ((uint32_t) 0x00000008)
+#define RCC_APB2Periph_GPIOC        ((uint32_t) 0x00000010)
+#define RCC_APB2Periph_GPIOD        ((uint32_t) 0x00000020)
+#define RCC_APB2Periph_SPI1         ((uint32_t) 0x00001000)
+#define RCC_APB2Periph_USART1       ((uint32_t) 0x00004000)
+#define RCC_APB1Periph_TIM6         ((uint32_t) 0x00000010)
+#define RCC_APB1Periph_TIM7         ((uint32_t) 0x00000020)
+#define RCC_APB1Periph_SPI2         ((uint32_t) 0x00004000)
+#define RCC_APB1Periph_USART2       ((uint32_t) 0x00020000)
+#define RCC_APB1Periph_USART3       ((uint32_t) 0x00040000)
+#define RCC_APB1Periph_UART4        ((uint32_t) 0x00080000)
+#define RCC_APB1Periph_UART5        ((uint32_t) 0x00100000)
+#define RCC_AHBPeriph_DMA1          ((uint32_t) 0x00000001)
+#define RCC_AHBPeriph_DMA2          ((uint32_t) 0x00000002)
+#define RCC_AHBPeriph_CRC           ((uint32_t) 0x00000040)
+
+/**< CRC */
+#define CRC_CR_RESET                ((uint32_t) 0x00000001)
+
+typedef struct {
+    uint32_t SYSCLK_Frequency;
+    uint32_t HCLK_Frequency;
+    uint32_t PCLK1_Frequency;
+    uint32_t PCLK2_Frequency;
+    uint32_t ADCCLK_Frequency;
+} RCC_ClocksTypeDef;
+
+void RCC_APB2PeriphClockCmd (uint32_t RCC_APB2Periph, FunctionalState NewState);
+void RCC_APB1PeriphClockCmd (uint32_t RCC_APB1Periph, FunctionalState NewState);
+void RCC_AHBPeriphClockCmd (uint32_t RCC_AHBPeriph, FunctionalState NewState);
+void RCC_GetClocksFreq (RCC_ClocksTypeDef *RCC_Clocks);
+
+/**< USART */
+typedef struct {
+    uint32_t USART_BaudRate;
+    uint16_t USART_WordLength;
+    uint16_t USART_StopBits;
+    uint16_t USART_Parity;
+    uint16_t USART_Mode;
+    uint16_t USART_HardwareFlowControl;
+} USART_InitTypeDef;
+
+#define USART_WordLength_8b                 ((uint16_t) 0x0000)
+#define USART_WordLength_9b                 ((uint16_t) 0x1000)
+#define USART_StopBits_1                    ((uint16_t) 0x0000)
+#define USART_StopBits_0_5                  ((uint16_t) 0x1000)
+#define USART_StopBits_2                    ((uint16_t) 0x2000)
+#define USART_StopBits_1_5                  ((uint16_t) 0x3000)
+#define USART_Parity_No                     ((uint16_t) 0x0000)
+#define USART_Parity_Even                   ((uint16_t) 0x0400)
+#define USART_Parity_Odd                    ((uint16_t) 0x0600)
+#define USART_Mode_Rx                       ((uint16_t) 0x0004)
+#define USART_Mode_Tx                       ((uint16_t) 0x0008)
+#define USART_HardwareFlowControl_None      ((uint16_t) 0x0000)
+#define USART_HardwareFlowControl_RTS       ((uint16_t) 0x0100)
+#define USART_HardwareFlowControl_CTS       ((uint16_t) 0x0200)
+#define USART_HardwareFlowControl_RTS_CTS   ((uint16_t) 0x0300)
+
+#define USART_FLAG_CTS                      ((uint16_t) 0x0200)
+#define USART_FLAG_LBD                      ((uint16_t) 0x0100)
+#define USART_FLAG_TXE                      ((uint16_t) 0x0080)
+#define USART_FLAG_TC                       ((uint16_t) 0x0040)
+#define USART_FLAG_RXNE                     ((uint16_t) 0x0020)
+#define USART_FLAG_IDLE                     ((uint16_t) 0x0010)
+#define USART_FLAG_ORE                      ((uint16_t) 0x0008)
+#define USART_FLAG_NE                       ((uint16_t) 0x0004)
+#define USART_FLAG_FE                       ((uint16_t) 0x0002)
+#define USART_FLAG_PE                       ((uint16_t) 0x0001)
+
+#define USART_IT_PE                         ((uint16_t) 0x0028)
+#define USART_IT_TXE                        ((uint16_t) 0x0727)
+#define USART_IT_TC                         ((uint16_t) 0x0626)
+#define USART_IT_RXNE                       ((uint16_t) 0x0525)
+#define USART_IT_IDLE                       ((uint16_t) 0x0424)
+#define USART_IT_LBD                        ((uint16_t) 0x0846)
+#define USART_IT_CTS                        ((uint16_t) 0x096A)
+#define USART_IT_ERR                        ((uint16_t) 0x0060)
+#define USART_IT_ORE                        ((uint16_t) 0x0360)
+
+#define USART_DMAReq_Tx                     ((uint16_t) 0x0080)
+#define USART_DMAReq_Rx                     ((uint16_t) 0x0040)
+#define USART_WakeUp_IdleLine               ((uint16_t) 0x0000)
+#define USART_WakeUp_AddressMark            ((uint16_t) 0x0800)
+
+#define USART_SR_PE                         ((uint16_t) 0x0001)
+#define USART_SR_FE                         ((uint16_t) 0x0002)
+#define USART_SR_NE                         ((uint16_t) 0x0004)
+#define USART_SR_ORE                        ((uint16_t) 0x0008)
+#define USART_SR_IDLE                       ((uint16_t) 0x0010)
+#define USART_SR_RXNE                       ((uint16_t) 0x0020)
+#define USART_SR_TC                         ((uint16_t) 0x0040)
+#define USART_SR_TXE                        ((uint16_t) 0x0080)
+#define USART_CR1_RWU                       ((uint16_t) 0x0002)
+#define USART_CR1_RE                        ((uint16_t) 0x0004)
+#define USART_CR1_TE                        ((uint16_t) 0x0008)
+#define USART_CR1_IDLEIE                    ((uint16_t) 0x0010)
+#define USART_CR1_RXNEIE                    ((uint16_t) 0x0020)
+#define USART_CR1_TCIE                      ((uint16_t) 0x0040)
+#define USART_CR1_TXEIE                     ((uint16_t) 0x0080)
+#define USART_CR1_PEIE                      ((uint16_t) 0x0100)
+#define USART_CR1_WAKE                      ((uint16_t) 0x0800)
+#define USART_CR1_M                         ((uint16_t) 0x1000)
+#define USART_CR1_UE                        ((uint16_t) 0x2000)
+#define USART_CR3_EIE                       ((uint16_t) 0x0001)
+#define USART_CR3_DMAR                      ((uint16_t) 0x0040)
+#define USART_CR3_DMAT                      ((uint16_t) 0x0080)
+#define USART_CR3_RTSE                      ((uint16_t) 0x0100)
+#define USART_CR3_CTSE                      ((uint16_t) 0x0200)
+
+void USART_Init (USART_TypeDef *USARTx, USART_InitTypeDef *USART_InitStruct);
+void USART_Cmd (USART_TypeDef *USARTx, FunctionalState NewState);
+FlagStatus USART_GetFlagStatus (USART_TypeDef *USARTx, uint16_t USART_FLAG);
+void USART_ClearFlag (USART_TypeDef *USARTx, uint16_t USART_FLAG);
+ITStatus USART_GetITStatus (USART_TypeDef *USARTx, uint16_t USART_IT);
+void USART_ClearITPendingBit (USART_TypeDef *USARTx, uint16_t USART_IT);
+void USART_SendData (USART_TypeDef *USARTx, uint16_t Data);
+uint16_t USART_ReceiveData (USART_TypeDef *USARTx);
+void USART_ITConfig (USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState);
+void USART_DMACmd (USART_TypeDef *USARTx, uint16_t USART_DMAReq, FunctionalState NewState);
+void USART_SetAddress (USART_TypeDef *USARTx, uint8_t USART_Address);
+void USART_WakeUpConfig (USART_TypeDef *USARTx, uint16_t USART_WakeUp);
+void USART_ReceiverWakeUpCmd (USART_TypeDef *USARTx, FunctionalState NewState);
+
+/**< SPI */
+typedef struct {
+    uint16_t SPI_Direction;
+    uint16_t SPI_Mode;
+    uint16_t SPI_DataSize;
+    uint16_t SPI_CPOL;
+    uint16_t SPI_CPHA;
+    uint16_t SPI_NSS;
+    uint16_t SPI_BaudRatePrescaler;
+    uint16_t SPI_FirstBit;
+    uint16_t SPI_CRCPolynomial;
+} SPI_InitTypeDef;
+
+#define SPI_Direction_2Lines_FullDuplex     ((uint16_t) 0x0000)
+#define SPI_Direction_2Lines_RxOnly         ((uint16_t) 0x0400)
+#define SPI_Direction_1Line_Rx              ((uint16_t) 0x8000)
+#define SPI_Direction_1Line_Tx              ((uint16_t) 0xC000)
+#define SPI_Mode_Master                     ((uint16_t) 0x0104)
+#define SPI_Mode_Slave                      ((uint16_t) 0x0000)
+#define SPI_DataSize_16b                    ((uint16_t) 0x0800)
+#define SPI_DataSize_8b                     ((uint16_t) 0x0000)
+#define SPI_CPOL_Low                        ((uint16_t) 0x0000)
+#define SPI_CPOL_High                       ((uint16_t) 0x0002)
+#define SPI_CPHA_1Edge                      ((uint16_t) 0x0000)
+#define SPI_CPHA_2Edge                      ((uint16_t) 0x0001)
+#define SPI_NSS_Soft                        ((uint16_t) 0x0200)
+#define SPI_NSS_Hard                        ((uint16_t) 0x0000)
+#define SPI_BaudRatePrescaler_2             ((uint16_t) 0x0000)
+#define SPI_BaudRatePrescaler_4             ((uint16_t) 0x0008)
+#define SPI_BaudRatePrescaler_8             ((uint16_t) 0x0010)
+#define SPI_BaudRatePrescaler_16            ((uint16_t) 0x0018)
+#define SPI_BaudRatePrescaler_32            ((uint16_t) 0x0020)
+#define SPI_BaudRatePrescaler_64            ((uint16_t) 0x0028)
+#define SPI_BaudRatePrescaler_128           ((uint16_t) 0x0030)
+#define SPI_BaudRatePrescaler_256           ((uint16_t) 0x0038)
+#define SPI_FirstBit_MSB                    ((uint16_t) 0x0000)
+#define SPI_FirstBit_LSB                    ((uint16_t) 0x0080)
+
+#define SPI_I2S_FLAG_RXNE                   ((uint16_t) 0x0001)
+#define SPI_I2S_FLAG_TXE                    ((uint16_t) 0x0002)
+#define SPI_I2S_FLAG_OVR                    ((uint16_t) 0x0040)
+#define SPI_I2S_FLAG_BSY                    ((uint16_t) 0x0080)
+#define SPI_FLAG_CRCERR                     ((uint16_t) 0x0010)
+#define SPI_I2S_DMAReq_Tx                   ((uint16_t) 0x0002)
+#define SPI_I2S_DMAReq_Rx                   ((uint16_t) 0x0001)
+
+#define SPI_CR1_MSTR                        ((uint16_t) 0x0004)
+#define SPI_CR1_BR                          ((uint16_t) 0x0038)
+#define SPI_CR1_SPE                         ((uint16_t) 0x0040)
+#define SPI_CR1_DFF                         ((uint16_t) 0x0800)
+#define SPI_CR1_CRCNEXT                     ((uint16_t) 0x1000)
+#define SPI_CR1_CRCEN                       ((uint16_t) 0x2000)
+#define SPI_CR2_RXDMAEN                     ((uint16_t) 0x0001)
+#define SPI_CR2_TXDMAEN                     ((uint16_t) 0x0002)
+#define SPI_CR2_SSOE                        ((uint16_t) 0x0004)
+#define SPI_SR_RXNE                         ((uint16_t) 0x0001)
+#define SPI_SR_TXE                          ((uint16_t) 0x0002)
+#define SPI_SR_CRCERR                       ((uint16_t) 0x0010)
+#define SPI_SR_BSY                          ((uint16_t) 0x0080)
+
+void SPI_Init (SPI_TypeDef *SPIx, SPI_InitTypeDef *SPI_InitStruct);
+void SPI_Cmd (SPI_TypeDef *SPIx, FunctionalState NewState);
+FlagStatus SPI_I2S_GetFlagStatus (SPI_TypeDef *SPIx, uint16_t SPI_I2S_FLAG);
+void SPI_I2S_SendData (SPI_TypeDef *SPIx, uint16_t Data);
+uint16_t SPI_I2S_ReceiveData (SPI_TypeDef *SPIx);
+void SPI_I2S_DMACmd (SPI_TypeDef *SPIx, uint16_t SPI_I2S_DMAReq, FunctionalState NewState);
+
+/**< DMA */
+typedef struct {
+    uint32_t DMA_PeripheralBaseAddr;
+    uint32_t DMA_MemoryBaseAddr;
+    uint32_t DMA_DIR;
+    uint32_t DMA_BufferSize;
+    uint32_t DMA_PeripheralInc;
+    uint32_t DMA_MemoryInc;
+    uint32_t DMA_PeripheralDataSize;
+    uint32_t DMA_MemoryDataSize;
+    uint32_t DMA_Mode;
+    uint32_t DMA_Priority;
+    uint32_t DMA_M2M;
+} DMA_InitTypeDef;
+
+#define DMA_DIR_PeripheralDST               ((uint32_t) 0x00000010)
+#define DMA_DIR_PeripheralSRC               ((uint32_t) 0x00000000)
+#define DMA_PeripheralInc_Enable            ((uint32_t) 0x00000040)
+#define DMA_PeripheralInc_Disable           ((uint32_t) 0x00000000)
+#define DMA_MemoryInc_Enable                ((uint32_t) 0x00000080)
+#define DMA_MemoryInc_Disable               ((uint32_t) 0x00000000)
+#define DMA_PeripheralDataSize_Byte         ((uint32_t) 0x00000000)
+#define DMA_PeripheralDataSize_HalfWord     ((uint32_t) 0x00000100)
+#define DMA_MemoryDataSize_Byte             ((uint32_t) 0x00000000)
+#define DMA_MemoryDataSize_HalfWord         ((uint32_t) 0x00000400)
+#define DMA_Mode_Circular                   ((uint32_t) 0x00000020)
+#define DMA_Mode_Normal                     ((uint32_t) 0x00000000)
+#define DMA_Priority_VeryHigh               ((uint32_t) 0x00003000)
+#define DMA_Priority_High                   ((uint32_t) 0x00002000)
+#define DMA_Priority_Medium                 ((uint32_t) 0x00001000)
+#define DMA_Priority_Low                    ((uint32_t) 0x00000000)
+#define DMA_M2M_Enable                      ((uint32_t) 0x00004000)
+#define DMA_M2M_Disable                     ((uint32_t) 0x00000000)
+#define DMA_IT_TC                           ((uint32_t) 0x00000002)
+#define DMA_IT_HT                           ((uint32_t) 0x00000004)
+#define DMA_IT_TE                           ((uint32_t) 0x00000008)
+
+#define DMA_CCR1_EN                         ((uint32_t) 0x00000001)
+#define DMA_CCR1_TCIE                       ((uint32_t) 0x00000002)
+#define DMA_CCR1_HTIE                       ((uint32_t) 0x00000004)
+#define DMA_CCR1_TEIE                       ((uint32_t) 0x00000008)
+#define DMA_CCR1_DIR                        ((uint32_t) 0x00000010)
+#define DMA_CCR1_CIRC                       ((uint32_t) 0x00000020)
+#define DMA_CCR1_PINC                       ((uint32_t) 0x00000040)
+#define DMA_CCR1_MINC                       ((uint32_t) 0x00000080)
+#define DMA_CCR1_PSIZE_0                    ((uint32_t) 0x00000100)
+#define DMA_CCR1_MSIZE_0                    ((uint32_t) 0x00000400)
+
+void DMA_DeInit (DMA_Channel_TypeDef *DMAy_Channelx);
+void DMA_Init (DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct);
+void DMA_Cmd (DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState);
+void DMA_ITConfig (DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState);
+uint16_t DMA_GetCurrDataCounter (DMA_Channel_TypeDef *DMAy_Channelx);
+void DMA_SetCurrDataCounter (DMA_Channel_TypeDef *DMAy_Channelx, uint16_t DataNumber);
+
+/**< NVIC */
+typedef struct {
+    uint8_t NVIC_IRQChannel;
+    uint8_t NVIC_IRQChannelPreemptionPriority;
+    uint8_t NVIC_IRQChannelSubPriority;
+    FunctionalState NVIC_IRQChannelCmd;
+} NVIC_InitTypeDef;
+
+#define NVIC_PriorityGroup_2                ((uint32_t) 0x500)
+#define NVIC_VectTab_FLASH                  ((uint32_t) 0x08000000)
+
+void NVIC_Init (NVIC_InitTypeDef *NVIC_InitStruct);
+void NVIC_PriorityGroupConfig (uint32_t NVIC_PriorityGroup);
+
+/**< EXTI */
+typedef enum {EXTI_Mode_Interrupt = 0x00, EXTI_Mode_Event = 0x04} EXTIMode_TypeDef;
+typedef enum {EXTI_Trigger_Rising = 0x08, EXTI_Trigger_Falling = 0x0C, EXTI_Trigger_Rising_Falling = 0x10} EXTITrigger_TypeDef;
+
+typedef struct {
+    uint32_t EXTI_Line;
+    EXTIMode_TypeDef EXTI_Mode;
+    EXTITrigger_TypeDef EXTI_Trigger;
+    FunctionalState EXTI_LineCmd;
+} EXTI_InitTypeDef;
+
+void EXTI_Init (EXTI_InitTypeDef *EXTI_InitStruct);
+ITStatus EXTI_GetITStatus (uint32_t EXTI_Line);
+void EXTI_ClearITPendingBit (uint32_t EXTI_Line);
+
+/**< TIM (basic timers) */
+#define TIM_IT_Update                       ((uint16_t) 0x0001)
+#define TIM_FLAG_Update                     ((uint16_t) 0x0001)
+#define TIM_PSCReloadMode_Update            ((uint16_t) 0x0000)
+#define TIM_UpdateSource_Global             ((uint16_t) 0x0000)
+#define TIM_OPMode_Repetitive               ((uint16_t) 0x0000)
+
+ITStatus TIM_GetITStatus (TIM_TypeDef *TIMx, uint16_t TIM_IT);
+void TIM_ClearITPendingBit (TIM_TypeDef *TIMx, uint16_t TIM_IT);
+
+#endif // __STM32F10x_H